@@ -0,0 +1,62 @@
+#[[
+    NobleAssetBaker
+
+    Headless offline tool baking models and textures into binary caches (resources/cache/)
+    Shares the engine resource loaders, no window, no Vulkan, no shaders
+]]
+
+function (setup_asset_baker)
+
+    # Engine sources required by the resource loaders
+    file(GLOB_RECURSE ASSET_BAKER_SOURCES CONFIGURE_DEPENDS
+        "${CMAKE_SOURCE_DIR}/src/common/*.cpp"
+        "${CMAKE_SOURCE_DIR}/src/core/debug/*.cpp"
+        "${CMAKE_SOURCE_DIR}/src/core/multithreading/*.cpp"
+        "${CMAKE_SOURCE_DIR}/src/core/resources/*.cpp"
+        "${CMAKE_SOURCE_DIR}/src/libraries/*.cpp"
+        "${CMAKE_SOURCE_DIR}/tools/NobleAssetBaker/*.cpp"
+    )
+
+    add_executable(NobleAssetBaker
+        ${ASSET_BAKER_SOURCES}
+        ${CMAKE_SOURCE_DIR}/src/core/platform/MappedFile.cpp
+        ${CMAKE_SOURCE_DIR}/external/mikktspace/mikktspace.c
+    )
+
+    target_compile_features(NobleAssetBaker PRIVATE cxx_std_20)
+
+    target_include_directories(NobleAssetBaker PRIVATE ${CMAKE_SOURCE_DIR}/src)
+
+    target_include_directories(
+        NobleAssetBaker
+        SYSTEM
+        PRIVATE
+        ${CMAKE_SOURCE_DIR}/external
+        ${CMAKE_SOURCE_DIR}/external/json
+        ${CMAKE_SOURCE_DIR}/external/stb
+    )
+
+    target_compile_definitions(NobleAssetBaker PRIVATE
+        RESOURCES_DIR="${CMAKE_SOURCE_DIR}/resources/"
+        SHADERS_SPV_DIR=""
+        NOMINMAX
+        TINYGLTF_NO_EXTERNAL_IMAGE
+        TINYGLTF_NO_STB_IMAGE
+        TINYGLTF_NO_STB_IMAGE_WRITE
+    )
+
+    target_link_libraries(NobleAssetBaker PRIVATE glm)
+
+    if (MSVC)
+        target_compile_options(NobleAssetBaker PRIVATE /W4 /permissive- /wd4100)
+    else()
+        target_compile_options(NobleAssetBaker PRIVATE
+            -Wall
+            -Wextra
+            -Wpedantic
+            -Wno-missing-field-initializers
+            -Wno-unused-parameter
+        )
+    endif()
+
+endfunction()
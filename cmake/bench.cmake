@@ -0,0 +1,71 @@
+#[[
+    NobleBench
+
+    Headless micro benchmarks timing engine subsystems against the code paths they replaced
+    Shares the engine CPU sources, no window, no Vulkan, no shaders
+]]
+
+function (setup_bench)
+
+    # Engine sources required by the benchmarks
+    file(GLOB_RECURSE BENCH_SOURCES CONFIGURE_DEPENDS
+        "${CMAKE_SOURCE_DIR}/src/common/*.cpp"
+        "${CMAKE_SOURCE_DIR}/src/core/debug/*.cpp"
+        "${CMAKE_SOURCE_DIR}/src/core/multithreading/*.cpp"
+        "${CMAKE_SOURCE_DIR}/src/core/render/*.cpp"
+        "${CMAKE_SOURCE_DIR}/src/core/resources/*.cpp"
+        "${CMAKE_SOURCE_DIR}/src/libraries/*.cpp"
+        "${CMAKE_SOURCE_DIR}/tools/NobleBench/*.cpp"
+    )
+
+    add_executable(NobleBench
+        ${BENCH_SOURCES}
+        ${CMAKE_SOURCE_DIR}/src/core/platform/MappedFile.cpp
+        ${CMAKE_SOURCE_DIR}/external/mikktspace/mikktspace.c
+    )
+
+    target_compile_features(NobleBench PRIVATE cxx_std_20)
+
+    target_include_directories(NobleBench PRIVATE ${CMAKE_SOURCE_DIR}/src)
+
+    target_include_directories(
+        NobleBench
+        SYSTEM
+        PRIVATE
+        ${CMAKE_SOURCE_DIR}/external
+        ${CMAKE_SOURCE_DIR}/external/json
+        ${CMAKE_SOURCE_DIR}/external/stb
+    )
+
+    target_compile_definitions(NobleBench PRIVATE
+        RESOURCES_DIR="${CMAKE_SOURCE_DIR}/resources/"
+        SHADERS_SPV_DIR=""
+        NOMINMAX
+        TINYGLTF_NO_EXTERNAL_IMAGE
+        TINYGLTF_NO_STB_IMAGE
+        TINYGLTF_NO_STB_IMAGE_WRITE
+    )
+
+    target_link_libraries(NobleBench PRIVATE glm)
+
+    if (MSVC)
+        target_compile_options(NobleBench PRIVATE /W4 /permissive- /wd4100)
+    else()
+        target_compile_options(NobleBench PRIVATE
+            -Wall
+            -Wextra
+            -Wpedantic
+            -Wno-missing-field-initializers
+            -Wno-unused-parameter
+        )
+    endif()
+
+    if (NOBLE_ENABLE_AVX2)
+        if (MSVC)
+            target_compile_options(NobleBench PRIVATE /arch:AVX2)
+        else()
+            target_compile_options(NobleBench PRIVATE -mavx2)
+        endif()
+    endif()
+
+endfunction()
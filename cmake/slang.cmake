@@ -97,6 +97,16 @@ function (compile_slang TARGET)
 
     target_compile_definitions(${TARGET} PRIVATE SHADERS_SPV_DIR="${SHADERS_OUTPUT_DIR}/")
 
+    # Shared includes, every shader is rebuilt when one of them changes
+    file(GLOB_RECURSE SHADERS_INCLUDES CONFIGURE_DEPENDS ${SHADERS_SOURCE_DIR}/include/*.slang)
+
+    # Validate the generated SPIR-V when the Vulkan SDK validator is available
+    find_program(SPIRV_VAL_EXECUTABLE spirv-val HINTS "$ENV{VULKAN_SDK}/bin")
+
+    if (SPIRV_VAL_EXECUTABLE)
+        message(STATUS "Validating SPIR-V with ${SPIRV_VAL_EXECUTABLE}")
+    endif()
+
     function (add_slang_shader_target SHADER_TARGET)
 
         cmake_parse_arguments(SHADERS "" "" "SOURCES;ENTRIES" ${ARGN})
@@ -120,6 +130,12 @@ function (compile_slang TARGET)
                 set(SPV_FILE ${SHADERS_OUTPUT_DIR}/${SPV_FILE_NAME})
                 list(APPEND SPV_OUTPUTS ${SPV_FILE})
 
+                set(SPV_VALIDATE_COMMAND "")
+
+                if (SPIRV_VAL_EXECUTABLE)
+                    set(SPV_VALIDATE_COMMAND COMMAND "${SPIRV_VAL_EXECUTABLE}" --target-env vulkan1.3 ${SPV_FILE})
+                endif()
+
                 # Run Slangc command to compile shaders to SPIR-V
                 add_custom_command(
                     OUTPUT ${SPV_FILE}
@@ -131,7 +147,8 @@ function (compile_slang TARGET)
                     -emit-spirv-directly
                     -fvk-use-entrypoint-name
                     -o ${SPV_FILE}
-                    DEPENDS ${SOURCE}
+                    ${SPV_VALIDATE_COMMAND}
+                    DEPENDS ${SOURCE} ${SHADERS_INCLUDES}
                     COMMENT "Building SPIR-V object ${SHADERS_OUTPUT_DIR}/${SPV_FILE_NAME}"
                     VERBATIM
                 )
@@ -148,6 +165,11 @@ function (compile_slang TARGET)
     # Filter out Slang files inside the include folder
     list(FILTER SHADERS_SOURCES EXCLUDE REGEX "${SHADERS_SOURCE_DIR}/include/.*")
 
+    # Compute shaders have their own folder and entrypoint
+    set(COMPUTE_SHADERS_SOURCES ${SHADERS_SOURCES})
+    list(FILTER COMPUTE_SHADERS_SOURCES INCLUDE REGEX "${SHADERS_SOURCE_DIR}/compute/.*")
+    list(FILTER SHADERS_SOURCES EXCLUDE REGEX "${SHADERS_SOURCE_DIR}/compute/.*")
+
     # Compile shaders
     add_slang_shader_target(
         SlangShaders
@@ -157,4 +179,15 @@ function (compile_slang TARGET)
 
     add_dependencies(${TARGET} SlangShaders)
 
+    # Compute shaders are only used by GPU culling, the default build neither compiles nor ships them
+    if (NOBLE_ENABLE_GPU_CULLING)
+        add_slang_shader_target(
+            SlangComputeShaders
+            SOURCES ${COMPUTE_SHADERS_SOURCES}
+            ENTRIES "compMain=compute"
+        )
+
+        add_dependencies(${TARGET} SlangComputeShaders)
+    endif()
+
 endfunction()
@@ -1,5 +1,6 @@
 #include "core/Runtime.h"
 #include "core/debug/Logger.h"
+#include "core/debug/Profiler.h"
 #include "core/engine/Engine.h"
 #include "core/multithreading/ThreadRegistry.h"
 
@@ -49,6 +50,18 @@ int main() {
         );
     }
 
+    // Spinning objects, exercises the dynamic object path
+    Scene sceneTeapots;
+
+    for (std::int32_t x = -4; x <= 4; x++) {
+        for (std::int32_t y = -4; y <= 4; y++) {
+            const glm::vec3 position{static_cast<float>(x) * 2.0f, static_cast<float>(y) * 2.0f, 0.0f};
+            const glm::vec3 angularVelocity{0.0f, 15.0f * static_cast<float>(x + 5), 0.0f};
+
+            sceneTeapots.addObject("teapot.obj", position, {90.0f, 0.0f, 0.0f}, glm::vec3{0.015f}, angularVelocity);
+        }
+    }
+
     Runtime runtime(sceneSponza, Engine::running);
 
     Engine::fatalOnFail(runtime.init());
@@ -57,6 +70,12 @@ int main() {
 
     runtime.shutdown();
 
+#ifdef NOBLE_PROFILER
+    if (auto traceExport = Profiler::exportTrace("traces/trace.json"); traceExport.failed()) {
+        Logger::error(traceExport.failure());
+    }
+#endif
+
     Platform::shutdown();
 
     return Engine::exitCode;
@@ -3,15 +3,26 @@
 #include <array>
 
 Math::AABB Math::AABB::transform(const glm::mat4& m) const {
-    AABB newAABB{};
-    for (const auto& corner : getCorners()) {
-        glm::vec4 transformedCorner = m * glm::vec4(corner, 1.0f);
+    const auto [center, extent] = transformBounds(m);
 
-        newAABB.minBound = glm::min(newAABB.minBound, glm::vec3(transformedCorner));
-        newAABB.maxBound = glm::max(newAABB.maxBound, glm::vec3(transformedCorner));
+    return {center - extent, center + extent};
+}
+
+Math::Bounds Math::AABB::transformBounds(const glm::mat4& m) const {
+    const glm::vec3 localCenter = (minBound + maxBound) * 0.5f;
+    const glm::vec3 localExtent = (maxBound - minBound) * 0.5f;
+
+    // Transformed center plus extent projected through the absolute rotation/scale part
+    Bounds bounds{glm::vec3(m[3]), glm::vec3(0.0f)};
+
+    for (int column = 0; column < 3; column++) {
+        const glm::vec3 axis = glm::vec3(m[column]);
+
+        bounds.center += axis * localCenter[column];
+        bounds.extent += glm::abs(axis) * localExtent[column];
     }
 
-    return newAABB;
+    return bounds;
 }
 
 std::array<glm::vec3, 8> Math::AABB::getCorners() const {
@@ -6,12 +6,22 @@ class Math {
 public:
     static constexpr float EPSILON = 1e-5f;
 
+    // Box in center/half-extent form
+    struct Bounds {
+        glm::vec3 center{0.0f};
+        glm::vec3 extent{0.0f};
+    };
+
     struct AABB {
         glm::vec3 minBound = { FLT_MAX,  FLT_MAX,  FLT_MAX};
         glm::vec3 maxBound = {-FLT_MAX, -FLT_MAX, -FLT_MAX};
 
+        // Bounds of the transformed box (Arvo), exact for affine matrices
         [[nodiscard]] AABB transform(const glm::mat4& m) const;
 
+        // Center/half-extent of the transformed box (Arvo), avoids transforming the 8 corners
+        [[nodiscard]] Bounds transformBounds(const glm::mat4& m) const;
+
         [[nodiscard]] std::array<glm::vec3, 8> getCorners() const;
 
         static std::array<std::uint32_t, 24> getLineIndices(std::uint32_t startIndex = 0);
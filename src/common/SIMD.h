@@ -0,0 +1,15 @@
+#pragma once
+
+// Compile-time SIMD capabilities, kernels provide a scalar fallback when none is available
+
+#if defined(__AVX2__)
+    #define NOBLE_SIMD_AVX2 1
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define NOBLE_SIMD_SSE 1
+#endif
+
+#if defined(NOBLE_SIMD_AVX2) || defined(NOBLE_SIMD_SSE)
+    #include <immintrin.h>
+#endif
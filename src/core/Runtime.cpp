@@ -2,13 +2,26 @@
 
 #include "entities/camera/CameraFreeFly.h"
 
+#include "debug/Profiler.h"
 #include "multithreading/ThreadRegistry.h"
 
 #include "graphics/vulkan/VulkanRenderer.h"
 
 #include <chrono>
+#include <iomanip>
+#include <sstream>
 #include <thread>
 
+namespace {
+    constexpr auto GPU_CAPTURE_PATH = "traces/gpu_timings.csv";
+
+    std::string formatMilliseconds(const double milliseconds) {
+        std::ostringstream stream;
+        stream << std::fixed << std::setprecision(2) << milliseconds << " ms";
+        return stream.str();
+    }
+}
+
 Runtime::Runtime(const Scene& scene, std::atomic<bool>& runningFlag)
     : _running(runningFlag),
       _window(1280, 720, "Noble Engine"),
@@ -32,6 +45,7 @@ Expected<void> Runtime::init() {
     keyMap.bind(GLFW_KEY_LEFT_CONTROL, InputAction::MoveDown);
     keyMap.bind(GLFW_KEY_LEFT_SHIFT, InputAction::IncreaseSpeed);
     keyMap.bind(GLFW_KEY_TAB, InputAction::ToggleDebugView);
+    keyMap.bind(GLFW_KEY_F3, InputAction::ToggleGpuCapture);
 
     _inputManager.setKeyMap(keyMap);
 
@@ -62,11 +76,20 @@ void Runtime::run() {
 
     std::uint32_t frameIndex = 0;
 
+    // Double precision, animated angles stay exact over long sessions
+    double sceneTime = 0.0;
+
     while (_running && !_window.shouldClose()) {
+        PROFILE_ZONE("MainLoop");
+
         _window.pollEvents();
 
-        while (_producedFrame - _consumedFrame.load(std::memory_order_acquire) >= Engine::MAX_FRAMES_IN_FLIGHT) {
-            std::this_thread::yield();
+        {
+            PROFILE_ZONE("WaitForRenderThread");
+
+            while (_producedFrame - _consumedFrame.load(std::memory_order_acquire) >= Engine::MAX_FRAMES_IN_FLIGHT) {
+                std::this_thread::yield();
+            }
         }
 
         auto currentTime = highResolutionClock::now();
@@ -75,20 +98,29 @@ void Runtime::run() {
 
         previousTime = currentTime;
 
+        sceneTime += deltaTime;
+
         if (_inputManager.isPressed(InputAction::ToggleDebugView)) {
             _debugState.incrementMode();
 
             Logger::debug("Set debug mode to " + std::to_string(_debugState.debugMode));
         }
 
+        const bool gpuCaptureToggled = _inputManager.isPressed(InputAction::ToggleGpuCapture);
+
         _inputManager.update();
 
         int windowWidth, windowHeight;
         _window.getFramebufferSize(windowWidth, windowHeight);
 
+        const VulkanRenderer::FrameStats frameStats = _renderer.getFrameStats();
+
         _window.setTitle(
             "Noble Engine | " + std::to_string(_framerate.load(std::memory_order_relaxed)) + " FPS | " +
-            std::to_string(_renderer.primitiveCount) + " Triangles"
+            std::to_string(frameStats.primitiveCount) + " Triangles | " +
+            std::to_string(frameStats.cullStats.getCulledCount()) + " Culled draws | " +
+            std::to_string(frameStats.recordingStats.getElidedCount()) + " Elided calls | " +
+            formatMilliseconds(frameStats.gpuTimeMs) + " GPU"
         );
 
         _cameraBehavior->update(deltaTime);
@@ -104,6 +136,10 @@ void Runtime::run() {
             _debugState
         );
 
+        _objectManager.getAnimatedTransforms(sceneTime, framePacket.objectTransforms);
+
+        framePacket.toggleGpuCapture = gpuCaptureToggled;
+
         _producedFrame.fetch_add(1, std::memory_order_release);
 
         ++frameIndex;
@@ -128,15 +164,34 @@ void Runtime::renderLoop() {
 
     while (_running) {
         // Wait for engine to produce a frame
-        while (_consumedFrame >= _producedFrame.load(std::memory_order_acquire)) {
-            if (!_running) return;
-            std::this_thread::yield();
+        {
+            PROFILE_ZONE("WaitForMainThread");
+
+            while (_consumedFrame >= _producedFrame.load(std::memory_order_acquire)) {
+                if (!_running) return;
+                std::this_thread::yield();
+            }
         }
 
         const auto& framePacket = _framePackets[frameIndex % Engine::MAX_FRAMES_IN_FLIGHT];
 
-        auto frameDraw = _renderer.drawFrame(framePacket.uniforms);
-        if (frameDraw.failed()) Logger::error(frameDraw.failure());
+        for (const auto& [objectIndex, position, rotation, scale] : framePacket.objectTransforms) {
+            _objectManager.setObjectTransform(objectIndex, position, rotation, scale);
+        }
+
+        if (framePacket.toggleGpuCapture) toggleGpuCapture();
+
+        {
+            PROFILE_ZONE("DrawFrame");
+
+            auto frameDraw = _renderer.drawFrame(framePacket.uniforms);
+            if (frameDraw.failed()) Logger::error(frameDraw.failure());
+        }
+
+        PROFILE_FRAME("Frame");
+        PROFILE_COUNTER("Triangles", _renderer.getFrameStats().primitiveCount);
+        PROFILE_COUNTER("Culled draws", _renderer.getFrameStats().cullStats.getCulledCount());
+        PROFILE_COUNTER("Elided calls", _renderer.getFrameStats().recordingStats.getElidedCount());
 
         _consumedFrame.fetch_add(1, std::memory_order_release);
 
@@ -154,3 +209,40 @@ void Runtime::renderLoop() {
         }
     }
 }
+
+void Runtime::toggleGpuCapture() {
+    VulkanGpuProfiler& profiler = _renderer.getGpuProfiler();
+
+    if (!profiler.isSupported()) {
+        Logger::warning("GPU timestamps are unsupported by the graphics queue, no pass timings to capture");
+        return;
+    }
+
+    if (!_gpuCapturing) {
+        if (auto dump = profiler.startDump(GPU_CAPTURE_PATH, VulkanGpuProfiler::DumpFormat::Csv); dump.failed()) {
+            Logger::error(dump.failure());
+            return;
+        }
+
+        _gpuCapturing = true;
+
+        Logger::info(std::string("Capturing GPU pass timings to ") + GPU_CAPTURE_PATH);
+        return;
+    }
+
+    profiler.stopDump();
+
+    _gpuCapturing = false;
+
+    Logger::info(
+        std::string("Stopped capturing GPU pass timings, last ") + std::to_string(VulkanGpuProfiler::HISTORY_SIZE)
+        + " frames:"
+    );
+
+    for (const auto& [name, lastMs, minMs, avgMs, maxMs] : profiler.getTimings()) {
+        Logger::info(
+            "  " + name + ": min " + formatMilliseconds(minMs) + " | avg " + formatMilliseconds(avgMs)
+            + " | max " + formatMilliseconds(maxMs)
+        );
+    }
+}
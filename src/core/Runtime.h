@@ -32,6 +32,9 @@ public:
 private:
     void renderLoop();
 
+    // Starts or stops dumping the GPU pass timings, the rolling timings are logged when stopping
+    void toggleGpuCapture();
+
     std::atomic<bool>& _running;
 
     DebugState _debugState{};
@@ -45,6 +48,11 @@ private:
 
     struct FramePacket {
         FrameUniforms uniforms;
+
+        // Applied by the render thread before drawing, it owns the object spatial index and the GPU profiler
+        std::vector<ObjectTransform> objectTransforms;
+
+        bool toggleGpuCapture = false;
     };
 
     std::array<FramePacket, Engine::MAX_FRAMES_IN_FLIGHT> _framePackets{};
@@ -54,6 +62,8 @@ private:
 
     std::atomic<std::uint32_t> _framerate;
 
+    bool _gpuCapturing = false;
+
     VulkanRenderer _renderer{};
 
     AssetManager  _assetManager{};
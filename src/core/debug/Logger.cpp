@@ -2,6 +2,7 @@
 
 #include "common/Utility.h"
 
+#include "core/debug/Profiler.h"
 #include "core/multithreading/ThreadRegistry.h"
 
 #include <array>
@@ -112,6 +113,8 @@ void logWorker() {
             logQueue.pop();
         }
 
+        PROFILE_ZONE("WriteLog");
+
 #ifdef LOG_FILE_WRITE
         if (logFile.is_open()) {
             writeLog(logFile, entry);
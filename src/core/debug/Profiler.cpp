@@ -0,0 +1,226 @@
+#include "Profiler.h"
+
+#include "core/multithreading/ThreadRegistry.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace {
+
+// Events per block, a full block links a new one so published events are never moved or overwritten
+constexpr std::uint32_t BLOCK_SIZE = 4096;
+
+// Upper bound of a thread buffer, later events are dropped
+constexpr std::uint32_t MAX_BLOCKS_PER_THREAD = 1024;
+
+struct Block {
+    std::array<Profiler::Event, BLOCK_SIZE> events;
+
+    // Published with release, the exporter only reads events below it
+    std::atomic<std::uint32_t> count{0};
+    std::atomic<Block*>        next{nullptr};
+};
+
+// Written by its thread only, read by the exporter through the atomics
+struct ThreadBuffer {
+    std::string name{};
+
+    // Owned blocks, only the linked ones are visible to the exporter
+    std::vector<std::unique_ptr<Block>> blocks{};
+
+    Block* head = nullptr;
+    Block* tail = nullptr;
+
+    std::atomic<std::uint64_t> dropped{0};
+};
+
+std::atomic enabled{true};
+
+// Tick and steady_clock origins of the trace, the ratio between both clocks is measured on export
+std::int64_t steadyNanoseconds() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()
+    ).count();
+}
+
+const std::int64_t epochTicks       = Profiler::now();
+const std::int64_t epochNanoseconds = steadyNanoseconds();
+
+// Guards the buffer list only, taken once per thread and on export
+std::mutex                                 buffersMutex{};
+std::vector<std::unique_ptr<ThreadBuffer>> buffers{};
+
+ThreadBuffer& createThreadBuffer() {
+    auto buffer = std::make_unique<ThreadBuffer>();
+    buffer->name = ThreadRegistry::currentName();
+    buffer->blocks.emplace_back(new Block);
+    buffer->head = buffer->blocks.back().get();
+    buffer->tail = buffer->head;
+
+    std::lock_guard lock(buffersMutex);
+    buffers.push_back(std::move(buffer));
+
+    return *buffers.back();
+}
+
+ThreadBuffer& getThreadBuffer() {
+    thread_local ThreadBuffer& buffer = createThreadBuffer();
+    return buffer;
+}
+
+// Only the writing thread links blocks, so a relaxed load of its own tail count is enough
+Block* reserveBlock(ThreadBuffer& buffer) {
+    if (buffer.tail->count.load(std::memory_order_relaxed) < BLOCK_SIZE) return buffer.tail;
+
+    if (buffer.blocks.size() == MAX_BLOCKS_PER_THREAD) return nullptr;
+
+    buffer.blocks.emplace_back(new Block);
+
+    Block* block = buffer.blocks.back().get();
+    buffer.tail->next.store(block, std::memory_order_release);
+    buffer.tail = block;
+
+    return block;
+}
+
+void writeString(std::ofstream& file, const char* string) {
+    file << '"';
+
+    for (const char* c = string; *c; c++) {
+        if (*c == '"' || *c == '\\') file << '\\';
+        file << *c;
+    }
+
+    file << '"';
+}
+
+}
+
+namespace Profiler {
+    void setEnabled(const bool isEnabled) noexcept {
+        enabled.store(isEnabled, std::memory_order_relaxed);
+    }
+
+    bool isEnabled() noexcept {
+        return enabled.load(std::memory_order_relaxed);
+    }
+
+    void record(const Event& event) noexcept {
+        ThreadBuffer& buffer = getThreadBuffer();
+
+        Block* block = reserveBlock(buffer);
+
+        if (!block) {
+            buffer.dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        const std::uint32_t index = block->count.load(std::memory_order_relaxed);
+
+        block->events[index] = event;
+        block->count.store(index + 1, std::memory_order_release);
+    }
+
+    void counter(const char* name, const double value) noexcept {
+        if (!isEnabled()) return;
+        record(Event{name, now(), std::bit_cast<std::int64_t>(value), EventType::Counter});
+    }
+
+    void frameMark(const char* name) noexcept {
+        if (!isEnabled()) return;
+        record(Event{name, now(), 0, EventType::FrameMark});
+    }
+
+    Expected<void> exportTrace(const std::string& path) {
+        std::error_code error;
+        std::filesystem::create_directories(std::filesystem::path(path).parent_path(), error);
+
+        std::ofstream file(path, std::ios::trunc);
+
+        if (!file.is_open()) {
+            return FAIL("Failed to open \"" + path + "\" for writing", "Profiler");
+        }
+
+        // Chrome expects microseconds
+        const std::int64_t elapsedTicks       = std::max<std::int64_t>(Profiler::now() - epochTicks, 1);
+        const std::int64_t elapsedNanoseconds = steadyNanoseconds() - epochNanoseconds;
+
+        const double microsecondsPerTick = static_cast<double>(elapsedNanoseconds) / elapsedTicks / 1000.0;
+
+        const auto toMicroseconds = [&](const std::int64_t ticks) {
+            return static_cast<double>(ticks) * microsecondsPerTick;
+        };
+
+        std::lock_guard lock(buffersMutex);
+
+        file << std::fixed << std::setprecision(3);
+
+        file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+        bool first = true;
+
+        const auto separate = [&] {
+            file << (first ? "\n" : ",\n");
+            first = false;
+        };
+
+        for (std::size_t tid = 0; tid < buffers.size(); tid++) {
+            const ThreadBuffer& buffer = *buffers[tid];
+
+            separate();
+            file << R"({"name":"thread_name","ph":"M","pid":1,"tid":)" << tid << R"(,"args":{"name":)";
+            writeString(file, buffer.name.c_str());
+            file << "}}";
+
+            for (const Block* block = buffer.head; block;
+                 block = block->next.load(std::memory_order_acquire)) {
+                const std::uint32_t count = block->count.load(std::memory_order_acquire);
+
+                for (std::uint32_t i = 0; i < count; i++) {
+                    const auto& [name, timestamp, payload, type] = block->events[i];
+
+                    separate();
+                    file << "{\"name\":";
+                    writeString(file, name);
+                    file << ",\"pid\":1,\"tid\":" << tid << ",\"ts\":" << toMicroseconds(timestamp - epochTicks);
+
+                    switch (type) {
+                        case EventType::Zone:
+                            file << R"(,"ph":"X","dur":)" << toMicroseconds(payload) << '}';
+                            break;
+
+                        case EventType::Counter:
+                            file << R"(,"ph":"C","args":{"value":)" << std::bit_cast<double>(payload) << "}}";
+                            break;
+
+                        case EventType::FrameMark:
+                            file << R"(,"ph":"i","s":"g"})";
+                            break;
+                    }
+                }
+            }
+
+            if (const std::uint64_t dropped = buffer.dropped.load(std::memory_order_relaxed)) {
+                separate();
+                file << R"({"name":"Dropped events","ph":"C","pid":1,"tid":)" << tid
+                     << R"(,"ts":0,"args":{"value":)" << dropped << "}}";
+            }
+        }
+
+        file << "\n]}\n";
+
+        if (!file) {
+            return FAIL("Failed to write trace \"" + path + "\"", "Profiler");
+        }
+
+        return {};
+    }
+}
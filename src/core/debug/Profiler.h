@@ -0,0 +1,105 @@
+#pragma once
+
+#include "ErrorHandling.h"
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#if defined(__x86_64__) || defined(_M_X64)
+    #define NOBLE_PROFILER_TSC 1
+
+    #ifdef _MSC_VER
+        #include <intrin.h>
+    #else
+        #include <x86intrin.h>
+    #endif
+#endif
+
+// CPU instrumentation exported as Chrome trace_event JSON (chrome://tracing, Perfetto)
+// Zones, counters and frame markers are appended to per-thread event buffers without locking, threads are named after
+// their ThreadRegistry name. Everything compiles out unless NOBLE_PROFILER is defined, names must be string literals
+namespace Profiler {
+    enum class EventType : std::uint8_t { Zone, Counter, FrameMark };
+
+    // Left uninitialized by default, event blocks are written once and never cleared
+    struct Event {
+        const char*  name;
+        std::int64_t timestamp; // ticks
+        std::int64_t payload;   // zone ticks, or counter value bits
+        EventType    type;
+    };
+
+    // The time stamp counter where available, steady_clock reads cost most of a zone budget on their own
+    // Ticks are converted to time on export, against steady_clock over the whole recording
+    [[nodiscard]] inline std::int64_t now() noexcept {
+#ifdef NOBLE_PROFILER_TSC
+        return static_cast<std::int64_t>(__rdtsc());
+#else
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()
+        ).count();
+#endif
+    }
+
+    // Recording can be paused at runtime, paused zones only cost an atomic load
+    void setEnabled(bool enabled) noexcept;
+
+    [[nodiscard]] bool isEnabled() noexcept;
+
+    // Appends to the buffer of the calling thread, created on its first event
+    void record(const Event& event) noexcept;
+
+    void counter(const char* name, double value) noexcept;
+
+    void frameMark(const char* name) noexcept;
+
+    // Events recorded so far by every thread, including threads that already exited
+    [[nodiscard]] Expected<void> exportTrace(const std::string& path);
+
+    class Zone {
+    public:
+        explicit Zone(const char* name) noexcept : _name(name), _start(isEnabled() ? now() : -1) {}
+
+        ~Zone() {
+            if (_start < 0) return;
+            record(Event{_name, _start, now() - _start, EventType::Zone});
+        }
+
+        Zone(const Zone&)            = delete;
+        Zone& operator=(const Zone&) = delete;
+
+        Zone(Zone&&)            = delete;
+        Zone& operator=(Zone&&) = delete;
+
+    private:
+        const char*  _name;
+        std::int64_t _start;
+    };
+}
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+#ifdef NOBLE_PROFILER
+
+#define PROFILE_ZONE(name) \
+    const Profiler::Zone PROFILE_CONCAT(profileZone_, __LINE__){name}
+
+#define PROFILE_FUNCTION() \
+    PROFILE_ZONE(__func__)
+
+#define PROFILE_COUNTER(name, value) \
+    Profiler::counter(name, static_cast<double>(value))
+
+#define PROFILE_FRAME(name) \
+    Profiler::frameMark(name)
+
+#else
+
+#define PROFILE_ZONE(name)           static_cast<void>(0)
+#define PROFILE_FUNCTION()           static_cast<void>(0)
+#define PROFILE_COUNTER(name, value) static_cast<void>(0)
+#define PROFILE_FRAME(name)          static_cast<void>(0)
+
+#endif
@@ -14,6 +14,16 @@ void Object::create(
     _rotation = rotation;
     _scale    = scale;
 
+    _meshWorldBounds.resize(_model->meshes.size());
+
+    updateMatrices();
+}
+
+void Object::setTransform(const glm::vec3 position, const glm::vec3 rotation, const glm::vec3 scale) {
+    _position = position;
+    _rotation = rotation;
+    _scale    = scale;
+
     updateMatrices();
 }
 
@@ -40,4 +50,27 @@ void Object::updateMatrices() {
 
     _modelMatrix  = translation * rotation * scaling;
     _normalMatrix = glm::mat4(glm::transpose(glm::inverse(glm::mat3(_modelMatrix))));
+
+    updateWorldBounds();
+
+    _transformGeneration.fetch_add(1, std::memory_order_release);
+}
+
+void Object::updateWorldBounds() {
+    if (_meshWorldBounds.empty()) {
+        _worldBounds = {};
+        return;
+    }
+
+    Math::AABB worldAABB{};
+
+    for (std::size_t i = 0; i < _meshWorldBounds.size(); i++) {
+        const Math::Bounds& bounds = _meshWorldBounds[i] = _model->meshes[i].getAABB().transformBounds(_modelMatrix);
+
+        worldAABB.minBound = glm::min(worldAABB.minBound, bounds.center - bounds.extent);
+        worldAABB.maxBound = glm::max(worldAABB.maxBound, bounds.center + bounds.extent);
+    }
+
+    _worldBounds.center = (worldAABB.minBound + worldAABB.maxBound) * 0.5f;
+    _worldBounds.extent = (worldAABB.maxBound - worldAABB.minBound) * 0.5f;
 }
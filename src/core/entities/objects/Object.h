@@ -4,11 +4,14 @@
 
 #include <glm/glm.hpp>
 
+#include <atomic>
+
 struct ObjectDescriptor {
     std::string modelPath;
     glm::vec3   position;
     glm::vec3   rotation;
     glm::vec3   scale;
+    glm::vec3   angularVelocity{0.0f}; // Degrees per second added to the rotation, moving objects are dynamic
 };
 
 struct alignas(16) ObjectDataGPU {
@@ -37,12 +40,28 @@ public:
 
     void updateMatrices();
 
+    // Use ObjectManager::setObjectTransform to keep the object spatial index in sync
+    void setTransform(glm::vec3 position, glm::vec3 rotation, glm::vec3 scale);
+
     [[nodiscard]] const Model& getModel() const noexcept { return *_model; }
 
     [[nodiscard]] const glm::mat4& getModelMatrix() const noexcept { return _modelMatrix; }
     [[nodiscard]] const glm::mat4& getNormalMatrix() const noexcept { return _normalMatrix; }
 
+    // Incremented whenever any object transform changes, lets spatial structures skip refits on static frames
+    [[nodiscard]] static std::uint64_t getTransformGeneration() noexcept {
+        return _transformGeneration.load(std::memory_order_acquire);
+    }
+
+    // World-space bounds, refreshed by updateMatrices only when the transform changes
+    [[nodiscard]] const Math::Bounds&              getWorldBounds()     const noexcept { return _worldBounds; }
+    [[nodiscard]] const std::vector<Math::Bounds>& getMeshWorldBounds() const noexcept { return _meshWorldBounds; }
+
 private:
+    void updateWorldBounds();
+
+    static inline std::atomic<std::uint64_t> _transformGeneration{0};
+
     const Model* _model =  nullptr;
 
     glm::vec3 _position = {0.0f, 0.0f, 0.0f};
@@ -55,4 +74,8 @@ private:
 
     glm::mat4 _modelMatrix{};
     glm::mat4 _normalMatrix{};
+
+    // Draw calls reference these, sized once in create() so the addresses stay stable
+    Math::Bounds              _worldBounds{};
+    std::vector<Math::Bounds> _meshWorldBounds{};
 };
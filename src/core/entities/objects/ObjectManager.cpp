@@ -1,7 +1,9 @@
 #include "ObjectManager.h"
 
 #include "core/debug/Logger.h"
+#include "core/debug/Profiler.h"
 
+#include <cmath>
 #include <memory>
 #include <ranges>
 
@@ -15,8 +17,8 @@ void ObjectManager::addObject(
 }
 
 void ObjectManager::addScene(const Scene& scene) {
-    for (const auto& [modelPath, position, rotation, scale] : scene.getObjects()) {
-        _objectDescriptors.emplace_back(modelPath, position, rotation, scale);
+    for (const ObjectDescriptor& objectDescriptor : scene.getObjects()) {
+        _objectDescriptors.push_back(objectDescriptor);
     }
 }
 
@@ -39,7 +41,10 @@ void ObjectManager::createObjects() {
 
     auto startTime = std::chrono::high_resolution_clock::now();
 
-    _assetManager.loadModelsAsync(threadPool, _modelPaths);
+    {
+        PROFILE_ZONE("LoadModels");
+        _assetManager.loadModelsAsync(threadPool, _modelPaths);
+    }
 
     auto loadDuration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - startTime).count();
 
@@ -60,7 +65,10 @@ void ObjectManager::createObjects() {
 
     startTime = std::chrono::high_resolution_clock::now();
 
-    _assetManager.loadTexturesAsync(threadPool, _texturePaths);
+    {
+        PROFILE_ZONE("LoadTextures");
+        _assetManager.loadTexturesAsync(threadPool, _texturePaths);
+    }
 
     loadDuration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - startTime).count();
 
@@ -69,7 +77,7 @@ void ObjectManager::createObjects() {
     // Create objects
     std::vector<std::future<std::unique_ptr<Object>>> objectFutures;
 
-    for (const auto& [modelPath, position, rotation, scale] : _objectDescriptors) {
+    for (const auto& [modelPath, position, rotation, scale, angularVelocity] : _objectDescriptors) {
         const Model* model = _assetManager.getModelManager().get(modelPath);
 
         if (!model) {
@@ -77,6 +85,8 @@ void ObjectManager::createObjects() {
             continue;
         }
 
+        addAnimatedObject(position, rotation, scale, angularVelocity);
+
         auto object = std::make_unique<Object>();
         object->create(model, position, rotation, scale);
         _objects.push_back(std::move(object));
@@ -91,7 +101,7 @@ void ObjectManager::createObjects() {
 
 #else
 
-    for (const auto& [modelPath, position, rotation, scale] : _objectDescriptors) {
+    for (const auto& [modelPath, position, rotation, scale, angularVelocity] : _objectDescriptors) {
         // Load model
         Expected<const Model*> model = _assetManager.getModelManager().loadBlocking(modelPath);
 
@@ -119,6 +129,8 @@ void ObjectManager::createObjects() {
                 _assetManager.getTextures().emplace(texturePath, std::move(handle));
         }
 
+        addAnimatedObject(position, rotation, scale, angularVelocity);
+
         // Create the object and push its pointer to the vector
         _objects.push_back(std::make_unique<Object>());
 
@@ -127,4 +139,95 @@ void ObjectManager::createObjects() {
 
 #endif
 
+    buildSpatialIndex();
+}
+
+void ObjectManager::setObjectTransform(
+    const std::uint32_t objectIndex,
+    const glm::vec3     position,
+    const glm::vec3     rotation,
+    const glm::vec3     scale
+) {
+    Object& object = *_objects[objectIndex];
+
+    object.setTransform(position, rotation, scale);
+
+    if (!_dynamicObjects[objectIndex]) {
+        _staticObjectGrid.remove(objectIndex);
+        _dynamicObjectGrid.insert(objectIndex, object.getWorldBounds());
+
+        _dynamicObjects[objectIndex] = true;
+        _dynamicGeneration++;
+        return;
+    }
+
+    _dynamicObjectGrid.update(objectIndex, object.getWorldBounds());
+}
+
+void ObjectManager::getAnimatedTransforms(const double time, std::vector<ObjectTransform>& transforms) const {
+    transforms.clear();
+
+    // Angles are computed in double and wrapped before narrowing, Object compares them with an absolute epsilon
+    const auto wrap = [time](const float angle, const float velocity) {
+        return static_cast<float>(std::fmod(static_cast<double>(angle) + static_cast<double>(velocity) * time, 360.0));
+    };
+
+    for (const auto& [objectIndex, position, rotation, scale, angularVelocity] : _animatedObjects) {
+        const glm::vec3 wrappedAngle{
+            wrap(rotation.x, angularVelocity.x),
+            wrap(rotation.y, angularVelocity.y),
+            wrap(rotation.z, angularVelocity.z)
+        };
+
+        transforms.push_back({objectIndex, position, wrappedAngle, scale});
+    }
+}
+
+void ObjectManager::addAnimatedObject(
+    const glm::vec3 position,
+    const glm::vec3 rotation,
+    const glm::vec3 scale,
+    const glm::vec3 angularVelocity
+) {
+    if (angularVelocity == glm::vec3(0.0f)) return;
+
+    // Called right before the object is pushed, its index is the current object count
+    _animatedObjects.push_back({
+        static_cast<std::uint32_t>(_objects.size()), position, rotation, scale, angularVelocity
+    });
+}
+
+void ObjectManager::queryFrustum(
+    const std::array<Math::Plane, 6>& frustumPlanes,
+    std::vector<std::uint32_t>&       objectIndices
+) const {
+    _staticObjectGrid.queryFrustum(frustumPlanes, objectIndices);
+    _dynamicObjectGrid.queryFrustum(frustumPlanes, objectIndices);
+}
+
+void ObjectManager::querySphere(
+    const glm::vec3&            center,
+    const float                 radius,
+    std::vector<std::uint32_t>& objectIndices
+) const {
+    _staticObjectGrid.querySphere(center, radius, objectIndices);
+    _dynamicObjectGrid.querySphere(center, radius, objectIndices);
+}
+
+void ObjectManager::queryAABB(const Math::AABB& aabb, std::vector<std::uint32_t>& objectIndices) const {
+    _staticObjectGrid.queryAABB(aabb, objectIndices);
+    _dynamicObjectGrid.queryAABB(aabb, objectIndices);
+}
+
+void ObjectManager::buildSpatialIndex() {
+    _staticObjectGrid.clear();
+    _dynamicObjectGrid.clear();
+
+    _dynamicObjects.assign(_objects.size(), false);
+
+    for (std::uint32_t i = 0; i < _objects.size(); i++) {
+        _staticObjectGrid.insert(i, _objects[i]->getWorldBounds());
+    }
+
+    _dynamicGeneration++;
 }
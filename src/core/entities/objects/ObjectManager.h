@@ -4,12 +4,21 @@
 
 #include "core/entities/scenes/Scene.h"
 
+#include "core/render/SpatialHashGrid.h"
+
 #include "core/resources/AssetManager.h"
 
 #include "core/multithreading/ThreadPool.h"
 
 #define MULTITHREADED_OBJECTS_LOAD 1
 
+struct ObjectTransform {
+    std::uint32_t objectIndex;
+    glm::vec3     position;
+    glm::vec3     rotation;
+    glm::vec3     scale;
+};
+
 class ObjectManager {
 public:
     using ObjectsVector = std::vector<std::unique_ptr<Object>>;
@@ -35,8 +44,30 @@ public:
 
     void createObjects();
 
+    // Objects moved at least once are dynamic, they leave the static grid for the dynamic one
+    // Render thread only: the grids, dynamic flags and object matrices are read while culling and uploading the frame
+    void setObjectTransform(std::uint32_t objectIndex, glm::vec3 position, glm::vec3 rotation, glm::vec3 scale);
+
+    // Transforms of the objects with an angular velocity at the given scene time, safe from any thread once created
+    void getAnimatedTransforms(double time, std::vector<ObjectTransform>& transforms) const;
+
+    // Object indices of the objects inside or intersecting the volume, in no particular order
+    void queryFrustum(const std::array<Math::Plane, 6>& frustumPlanes, std::vector<std::uint32_t>& objectIndices) const;
+    void querySphere(const glm::vec3& center, float radius, std::vector<std::uint32_t>& objectIndices) const;
+    void queryAABB(const Math::AABB& aabb, std::vector<std::uint32_t>& objectIndices) const;
+
     [[nodiscard]] const ObjectsVector& getObjects() const noexcept { return _objects; }
 
+    [[nodiscard]] bool isDynamic(const std::uint32_t objectIndex) const noexcept {
+        return objectIndex < _dynamicObjects.size() && _dynamicObjects[objectIndex];
+    }
+
+    // Incremented whenever an object becomes dynamic, static objects never move
+    [[nodiscard]] std::uint64_t getDynamicGeneration() const noexcept { return _dynamicGeneration; }
+
+    [[nodiscard]] const SpatialHashGrid& getStaticObjectGrid() const noexcept { return _staticObjectGrid; }
+    [[nodiscard]] const SpatialHashGrid& getDynamicObjectGrid() const noexcept { return _dynamicObjectGrid; }
+
     [[nodiscard]] const std::vector<std::string>& getTexturePaths() const noexcept { return _texturePaths; }
 
 private:
@@ -46,6 +77,27 @@ private:
 
     ObjectsVector _objects{};
 
+    // Object spatial index, keyed by object index
+    SpatialHashGrid   _staticObjectGrid{};
+    SpatialHashGrid   _dynamicObjectGrid{};
+    std::vector<bool> _dynamicObjects{};
+    std::uint64_t     _dynamicGeneration = 0;
+
+    // Written by createObjects only
+    struct AnimatedObject {
+        std::uint32_t objectIndex;
+        glm::vec3     position;
+        glm::vec3     rotation;
+        glm::vec3     scale;
+        glm::vec3     angularVelocity;
+    };
+
+    std::vector<AnimatedObject> _animatedObjects{};
+
     std::vector<std::string> _modelPaths{};
     std::vector<std::string> _texturePaths{};
+
+    void addAnimatedObject(glm::vec3 position, glm::vec3 rotation, glm::vec3 scale, glm::vec3 angularVelocity);
+
+    void buildSpatialIndex();
 };
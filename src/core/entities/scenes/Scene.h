@@ -11,9 +11,10 @@ public:
         const std::string& modelPath,
         const glm::vec3    position,
         const glm::vec3    rotation,
-        const glm::vec3    scale
+        const glm::vec3    scale,
+        const glm::vec3    angularVelocity = glm::vec3{0.0f}
     ) {
-        _objects.emplace_back(modelPath, position, rotation, scale);
+        _objects.emplace_back(modelPath, position, rotation, scale, angularVelocity);
     }
 
     [[nodiscard]] const std::vector<ObjectDescriptor>& getObjects() const noexcept { return _objects; }
@@ -13,7 +13,8 @@ enum class InputAction : std::uint8_t {
     MoveUp,
     MoveDown,
     IncreaseSpeed,
-    ToggleDebugView
+    ToggleDebugView,
+    ToggleGpuCapture
 };
 
 class KeyMap {
@@ -0,0 +1,26 @@
+#include "ParallelFor.h"
+
+#include <thread>
+
+namespace {
+    thread_local bool isParallelWorker = false;
+}
+
+namespace ParallelFor {
+    ThreadPool& getThreadPool() {
+        static ThreadPool threadPool(getThreadCount());
+        return threadPool;
+    }
+
+    std::size_t getThreadCount() noexcept {
+        return std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    bool isWorkerThread() noexcept {
+        return isParallelWorker;
+    }
+
+    void setWorkerThread(const bool isWorker) noexcept {
+        isParallelWorker = isWorker;
+    }
+}
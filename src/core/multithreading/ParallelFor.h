@@ -0,0 +1,55 @@
+#pragma once
+
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <future>
+#include <vector>
+
+// Data-parallel loops over index ranges, backed by a dedicated pool
+// The pool is separate from task pools so callers running on a worker thread can safely block on their ranges
+namespace ParallelFor {
+    [[nodiscard]] ThreadPool& getThreadPool();
+
+    [[nodiscard]] std::size_t getThreadCount() noexcept;
+
+    // True on a ParallelFor worker, nested loops then run inline instead of waiting on their own pool
+    [[nodiscard]] bool isWorkerThread() noexcept;
+
+    void setWorkerThread(bool isWorker) noexcept;
+
+    // Calls function(begin, end) over [0, count) in ranges of `grain` elements, the calling thread takes the first range
+    template<typename Function>
+    void forEachRange(const std::size_t count, const std::size_t grain, const Function& function) {
+        if (count == 0) return;
+
+        const std::size_t rangeSize  = std::max<std::size_t>(grain, 1);
+        const std::size_t rangeCount = (count + rangeSize - 1) / rangeSize;
+
+        // Fast path: single range or nested call
+        if (rangeCount == 1 || isWorkerThread()) {
+            function(std::size_t{0}, count);
+            return;
+        }
+
+        std::vector<std::future<void>> futures;
+        futures.reserve(rangeCount - 1);
+
+        for (std::size_t range = 1; range < rangeCount; range++) {
+            const std::size_t begin = range * rangeSize;
+            const std::size_t end   = std::min(begin + rangeSize, count);
+
+            futures.push_back(getThreadPool().enqueue([&function, begin, end] {
+                setWorkerThread(true);
+                function(begin, end);
+                setWorkerThread(false);
+            }));
+        }
+
+        function(std::size_t{0}, std::min(rangeSize, count));
+
+        for (auto& future : futures) {
+            future.get();
+        }
+    }
+}
@@ -2,6 +2,8 @@
 
 #include "ThreadRegistry.h"
 
+#include "core/debug/Profiler.h"
+
 #include <atomic>
 #include <condition_variable>
 #include <deque>
@@ -111,6 +113,7 @@ private:
 
             // Execute the task or wait
             if (task) {
+                PROFILE_ZONE("Task");
                 task();
             } else {
                 std::unique_lock lock(waitMutex);
@@ -0,0 +1,111 @@
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+Expected<void> MappedFile::open(const std::string& path) noexcept {
+    close();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(
+        path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr
+    );
+
+    if (file == INVALID_HANDLE_VALUE) {
+        return FAIL("Failed to open file \"" + path + "\"", "MappedFile");
+    }
+
+    _fileHandle = file;
+
+    LARGE_INTEGER fileSize{};
+    if (!GetFileSizeEx(file, &fileSize)) {
+        close();
+        return FAIL("Failed to query size of file \"" + path + "\"", "MappedFile");
+    }
+
+    _size = static_cast<std::size_t>(fileSize.QuadPart);
+
+    // Empty files cannot be mapped
+    if (_size == 0) return {};
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) {
+        close();
+        return FAIL("Failed to map file \"" + path + "\"", "MappedFile");
+    }
+
+    _mappingHandle = mapping;
+
+    _data = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    if (!_data) {
+        close();
+        return FAIL("Failed to map view of file \"" + path + "\"", "MappedFile");
+    }
+#else
+    _fileDescriptor = ::open(path.c_str(), O_RDONLY);
+
+    if (_fileDescriptor < 0) {
+        return FAIL("Failed to open file \"" + path + "\"", "MappedFile");
+    }
+
+    struct stat fileStat{};
+    if (fstat(_fileDescriptor, &fileStat) != 0) {
+        close();
+        return FAIL("Failed to query size of file \"" + path + "\"", "MappedFile");
+    }
+
+    _size = static_cast<std::size_t>(fileStat.st_size);
+
+    // Empty files cannot be mapped
+    if (_size == 0) return {};
+
+    void* mapping = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, _fileDescriptor, 0);
+    if (mapping == MAP_FAILED) {
+        close();
+        return FAIL("Failed to map file \"" + path + "\"", "MappedFile");
+    }
+
+    // The whole file is scanned front to back
+    madvise(mapping, _size, MADV_SEQUENTIAL);
+
+    _data = static_cast<const char*>(mapping);
+#endif
+
+    return {};
+}
+
+void MappedFile::close() noexcept {
+#ifdef _WIN32
+    if (_data) {
+        UnmapViewOfFile(_data);
+    }
+
+    if (_mappingHandle) {
+        CloseHandle(_mappingHandle);
+        _mappingHandle = nullptr;
+    }
+
+    if (_fileHandle) {
+        CloseHandle(_fileHandle);
+        _fileHandle = nullptr;
+    }
+#else
+    if (_data) {
+        munmap(const_cast<char*>(_data), _size);
+    }
+
+    if (_fileDescriptor >= 0) {
+        ::close(_fileDescriptor);
+        _fileDescriptor = -1;
+    }
+#endif
+
+    _data = nullptr;
+    _size = 0;
+}
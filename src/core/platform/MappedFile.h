@@ -0,0 +1,40 @@
+#pragma once
+
+#include "core/debug/ErrorHandling.h"
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+// Read-only memory mapping of a whole file, unmapped on destruction
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile() { close(); }
+
+    MappedFile(const MappedFile&)            = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&&)            = delete;
+    MappedFile& operator=(MappedFile&&) = delete;
+
+    [[nodiscard]] Expected<void> open(const std::string& path) noexcept;
+
+    void close() noexcept;
+
+    [[nodiscard]] const char* data() const noexcept { return _data; }
+    [[nodiscard]] std::size_t size() const noexcept { return _size; }
+
+    [[nodiscard]] std::string_view view() const noexcept { return {_data, _size}; }
+
+private:
+    const char* _data = nullptr;
+    std::size_t _size = 0;
+
+#ifdef _WIN32
+    void* _fileHandle    = nullptr;
+    void* _mappingHandle = nullptr;
+#else
+    int _fileDescriptor = -1;
+#endif
+};
@@ -0,0 +1,286 @@
+#include "BoundingVolumeHierarchy.h"
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <numeric>
+
+namespace {
+    // Same threshold as FrustumCuller
+    constexpr float VISIBILITY_THRESHOLD = 0.001f;
+
+    constexpr std::uint8_t ALL_PLANES = 0b111111;
+
+    float surfaceArea(const Math::AABB& aabb) {
+        const glm::vec3 size = aabb.maxBound - aabb.minBound;
+        return size.x * size.y + size.y * size.z + size.z * size.x;
+    }
+
+    void grow(Math::AABB& aabb, const Math::AABB& other) {
+        aabb.minBound = glm::min(aabb.minBound, other.minBound);
+        aabb.maxBound = glm::max(aabb.maxBound, other.maxBound);
+    }
+
+    void grow(Math::AABB& aabb, const Math::Bounds& bounds) {
+        aabb.minBound = glm::min(aabb.minBound, bounds.center - bounds.extent);
+        aabb.maxBound = glm::max(aabb.maxBound, bounds.center + bounds.extent);
+    }
+
+    enum class Containment : std::uint8_t { Outside, Intersecting, Inside };
+
+    // Clears the bits of planes the box is fully inside of, so children skip them
+    Containment classify(const Math::AABB& aabb, const std::array<Math::Plane, 6>& planes, std::uint8_t& planeMask) {
+        const glm::vec3 center = (aabb.minBound + aabb.maxBound) * 0.5f;
+        const glm::vec3 extent = (aabb.maxBound - aabb.minBound) * 0.5f;
+
+        for (std::uint32_t p = 0; p < 6; p++) {
+            if (!(planeMask & (1u << p))) continue;
+
+            const auto& [normal, d] = planes[p];
+
+            const float distance = glm::dot(normal, center) + d;
+            const float radius   = glm::dot(glm::abs(normal), extent);
+
+            if (distance + radius < VISIBILITY_THRESHOLD) return Containment::Outside;
+
+            if (distance - radius >= VISIBILITY_THRESHOLD) {
+                planeMask &= static_cast<std::uint8_t>(~(1u << p));
+            }
+        }
+
+        return planeMask == 0 ? Containment::Inside : Containment::Intersecting;
+    }
+}
+
+void BoundingVolumeHierarchy::build(const std::span<const Math::Bounds> bounds) {
+    clear();
+
+    if (bounds.empty()) return;
+
+    _bounds.assign(bounds.begin(), bounds.end());
+
+    _primitiveIndices.resize(bounds.size());
+    std::iota(_primitiveIndices.begin(), _primitiveIndices.end(), 0u);
+
+    _nodes.reserve(bounds.size() * 2);
+
+    Node& root = _nodes.emplace_back();
+    root.count = static_cast<std::uint32_t>(bounds.size());
+    updateNodeBounds(root);
+
+    // Iterative to keep degenerate inputs from overflowing the call stack
+    std::vector<std::uint32_t> pending{0};
+
+    while (!pending.empty()) {
+        const std::uint32_t nodeIndex = pending.back();
+        pending.pop_back();
+
+        splitNode(nodeIndex);
+
+        if (!_nodes[nodeIndex].isLeaf()) {
+            pending.push_back(_nodes[nodeIndex].leftChild);
+            pending.push_back(_nodes[nodeIndex].leftChild + 1);
+        }
+    }
+}
+
+void BoundingVolumeHierarchy::refit(const std::span<const Math::Bounds> bounds) {
+    assert(bounds.size() == _bounds.size());
+
+    _bounds.assign(bounds.begin(), bounds.end());
+
+    // Children are always stored after their parent
+    for (std::size_t i = _nodes.size(); i-- > 0;) {
+        Node& node = _nodes[i];
+
+        if (node.isLeaf()) {
+            updateNodeBounds(node);
+            continue;
+        }
+
+        node.aabb = _nodes[node.leftChild].aabb;
+        grow(node.aabb, _nodes[node.leftChild + 1].aabb);
+    }
+}
+
+void BoundingVolumeHierarchy::clear() noexcept {
+    _nodes.clear();
+    _bounds.clear();
+    _primitiveIndices.clear();
+}
+
+void BoundingVolumeHierarchy::cull(
+    const std::array<Math::Plane, 6>& frustumPlanes,
+    std::vector<std::uint32_t>&       visibleIndices
+) {
+    if (_nodes.empty()) return;
+
+    _candidates.clear();
+    _candidateIndices.clear();
+    _visibleCandidates.clear();
+
+    _stack.clear();
+    _stack.emplace_back(0, ALL_PLANES);
+
+    while (!_stack.empty()) {
+        auto [nodeIndex, planeMask] = _stack.back();
+        _stack.pop_back();
+
+        const Node& node = _nodes[nodeIndex];
+
+        switch (classify(node.aabb, frustumPlanes, planeMask)) {
+            case Containment::Outside:
+                break;
+
+            case Containment::Inside:
+                visibleIndices.insert(
+                    visibleIndices.end(),
+                    _primitiveIndices.begin() + node.first,
+                    _primitiveIndices.begin() + node.first + node.count
+                );
+                break;
+
+            case Containment::Intersecting:
+                if (!node.isLeaf()) {
+                    _stack.emplace_back(node.leftChild, planeMask);
+                    _stack.emplace_back(node.leftChild + 1, planeMask);
+                    break;
+                }
+
+                // Batch straddling primitives for the SIMD kernel
+                for (std::uint32_t i = node.first; i < node.first + node.count; i++) {
+                    _candidates.add(_bounds[_primitiveIndices[i]]);
+                    _candidateIndices.push_back(_primitiveIndices[i]);
+                }
+                break;
+        }
+    }
+
+    FrustumCuller::cull(_candidates, frustumPlanes, _visibleCandidates);
+
+    for (const std::uint32_t candidate : _visibleCandidates) {
+        visibleIndices.push_back(_candidateIndices[candidate]);
+    }
+}
+
+void BoundingVolumeHierarchy::updateNodeBounds(Node& node) const {
+    node.aabb = {};
+
+    for (std::uint32_t i = node.first; i < node.first + node.count; i++) {
+        grow(node.aabb, _bounds[_primitiveIndices[i]]);
+    }
+}
+
+void BoundingVolumeHierarchy::splitNode(const std::uint32_t nodeIndex) {
+    const Node node = _nodes[nodeIndex];
+
+    if (node.count <= 2) return;
+
+    const auto primitivesBegin = _primitiveIndices.begin() + node.first;
+    const auto primitivesEnd   = primitivesBegin + node.count;
+
+    // Bin along the axis with the largest centroid spread
+    Math::AABB centroidBounds{};
+
+    for (auto it = primitivesBegin; it != primitivesEnd; ++it) {
+        centroidBounds.minBound = glm::min(centroidBounds.minBound, _bounds[*it].center);
+        centroidBounds.maxBound = glm::max(centroidBounds.maxBound, _bounds[*it].center);
+    }
+
+    const glm::vec3 spread = centroidBounds.maxBound - centroidBounds.minBound;
+
+    int axis = 0;
+    if (spread.y > spread[axis]) axis = 1;
+    if (spread.z > spread[axis]) axis = 2;
+
+    // All centroids coincide, nothing to split on
+    if (spread[axis] <= 0.0f) return;
+
+    const float axisMin = centroidBounds.minBound[axis];
+    const float scale   = static_cast<float>(BIN_COUNT) / spread[axis];
+
+    const auto binOf = [&](const std::uint32_t primitive) {
+        const auto bin = static_cast<std::uint32_t>((_bounds[primitive].center[axis] - axisMin) * scale);
+        return std::min(bin, BIN_COUNT - 1);
+    };
+
+    std::array<Math::AABB, BIN_COUNT>    binBounds{};
+    std::array<std::uint32_t, BIN_COUNT> binCounts{};
+
+    for (auto it = primitivesBegin; it != primitivesEnd; ++it) {
+        const std::uint32_t bin = binOf(*it);
+
+        binCounts[bin]++;
+        grow(binBounds[bin], _bounds[*it]);
+    }
+
+    // Sweep from both sides to evaluate the SAH cost of every bin boundary
+    std::array<float, BIN_COUNT - 1>         leftAreas{};
+    std::array<std::uint32_t, BIN_COUNT - 1> leftCounts{};
+
+    Math::AABB    sweepBounds{};
+    std::uint32_t sweepCount = 0;
+
+    for (std::uint32_t i = 0; i < BIN_COUNT - 1; i++) {
+        sweepCount += binCounts[i];
+        if (binCounts[i]) grow(sweepBounds, binBounds[i]);
+
+        leftCounts[i] = sweepCount;
+        leftAreas[i]  = sweepCount ? surfaceArea(sweepBounds) : 0.0f;
+    }
+
+    float         bestCost  = std::numeric_limits<float>::max();
+    std::uint32_t bestSplit = 0;
+
+    sweepBounds = {};
+    sweepCount  = 0;
+
+    for (std::uint32_t i = BIN_COUNT - 1; i > 0; i--) {
+        sweepCount += binCounts[i];
+        if (binCounts[i]) grow(sweepBounds, binBounds[i]);
+
+        const std::uint32_t leftCount = leftCounts[i - 1];
+        if (leftCount == 0 || sweepCount == 0) continue;
+
+        const float cost = static_cast<float>(leftCount) * leftAreas[i - 1]
+                         + static_cast<float>(sweepCount) * surfaceArea(sweepBounds);
+
+        if (cost < bestCost) {
+            bestCost  = cost;
+            bestSplit = i;
+        }
+    }
+
+    // Keep small nodes as leaves when splitting is not cheaper
+    const float leafCost = static_cast<float>(node.count) * surfaceArea(node.aabb);
+
+    if (node.count <= MAX_LEAF_SIZE && bestCost >= leafCost) return;
+
+    auto middle = std::partition(primitivesBegin, primitivesEnd, [&](const std::uint32_t primitive) {
+        return binOf(primitive) < bestSplit;
+    });
+
+    // Degenerate binning, fall back to a median split
+    if (middle == primitivesBegin || middle == primitivesEnd) {
+        middle = primitivesBegin + node.count / 2;
+
+        std::nth_element(primitivesBegin, middle, primitivesEnd, [&](const std::uint32_t a, const std::uint32_t b) {
+            return _bounds[a].center[axis] < _bounds[b].center[axis];
+        });
+    }
+
+    const auto leftCount  = static_cast<std::uint32_t>(middle - primitivesBegin);
+    const auto leftChild  = static_cast<std::uint32_t>(_nodes.size());
+
+    Node& left = _nodes.emplace_back();
+    left.first = node.first;
+    left.count = leftCount;
+    updateNodeBounds(left);
+
+    Node& right = _nodes.emplace_back();
+    right.first = node.first + leftCount;
+    right.count = node.count - leftCount;
+    updateNodeBounds(right);
+
+    _nodes[nodeIndex].leftChild = leftChild;
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "core/render/FrustumCuller.h"
+
+#include <array>
+#include <span>
+#include <vector>
+
+// Binned SAH bounding volume hierarchy over world-space boxes, CPU only
+// Frustum queries accept fully inside subtrees and reject outside subtrees without per-box tests,
+// boxes of leaves straddling a plane are batched through the SIMD kernel of FrustumCuller
+class BoundingVolumeHierarchy {
+public:
+    static constexpr std::uint32_t BIN_COUNT     = 16;
+    static constexpr std::uint32_t MAX_LEAF_SIZE = 8;
+
+    struct Node {
+        Math::AABB aabb{};
+
+        // Range in the primitive index array covered by the subtree
+        std::uint32_t first = 0;
+        std::uint32_t count = 0;
+
+        // Right child is always leftChild + 1, 0 for leaves (the root is never a child)
+        std::uint32_t leftChild = 0;
+
+        [[nodiscard]] bool isLeaf() const noexcept { return leftChild == 0; }
+    };
+
+    BoundingVolumeHierarchy()  = default;
+    ~BoundingVolumeHierarchy() = default;
+
+    BoundingVolumeHierarchy(const BoundingVolumeHierarchy&)            = delete;
+    BoundingVolumeHierarchy& operator=(const BoundingVolumeHierarchy&) = delete;
+
+    BoundingVolumeHierarchy(BoundingVolumeHierarchy&&)            noexcept = default;
+    BoundingVolumeHierarchy& operator=(BoundingVolumeHierarchy&&) noexcept = default;
+
+    // Primitive IDs are the indices in the bounds span
+    void build(std::span<const Math::Bounds> bounds);
+
+    // Updates the node bounds after primitives moved, the topology is kept (same primitive count as build)
+    void refit(std::span<const Math::Bounds> bounds);
+
+    void clear() noexcept;
+
+    // Appends the IDs of the primitives inside or intersecting the frustum, in no particular order
+    void cull(const std::array<Math::Plane, 6>& frustumPlanes, std::vector<std::uint32_t>& visibleIndices);
+
+    [[nodiscard]] std::size_t getPrimitiveCount() const noexcept { return _bounds.size(); }
+
+    [[nodiscard]] const std::vector<Node>& getNodes() const noexcept { return _nodes; }
+
+private:
+    void updateNodeBounds(Node& node) const;
+
+    void splitNode(std::uint32_t nodeIndex);
+
+    std::vector<Node>          _nodes{};
+    std::vector<Math::Bounds>  _bounds{};
+    std::vector<std::uint32_t> _primitiveIndices{};
+
+    // Traversal scratch, kept across queries to avoid reallocations
+    std::vector<std::pair<std::uint32_t, std::uint8_t>> _stack{};
+
+    FrustumCuller::Boxes       _candidates{};
+    std::vector<std::uint32_t> _candidateIndices{};
+    std::vector<std::uint32_t> _visibleCandidates{};
+};
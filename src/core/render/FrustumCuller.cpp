@@ -1,5 +1,90 @@
 #include "FrustumCuller.h"
 
+#include "common/SIMD.h"
+
+#include <bit>
+
+namespace {
+    // Same threshold as testVisibility
+    constexpr float VISIBILITY_THRESHOLD = 0.001f;
+
+    struct PlaneSoA {
+        std::array<float, 6> normalX;
+        std::array<float, 6> normalY;
+        std::array<float, 6> normalZ;
+
+        std::array<float, 6> absNormalX;
+        std::array<float, 6> absNormalY;
+        std::array<float, 6> absNormalZ;
+
+        std::array<float, 6> d;
+    };
+
+    // Box is outside a plane when its center distance plus the projected extent is below the threshold
+    bool testBox(const FrustumCuller::Boxes& boxes, const PlaneSoA& planes, const std::size_t i) {
+        for (std::size_t p = 0; p < 6; p++) {
+            const float distance = planes.normalX[p] * boxes.centerX[i]
+                                 + planes.normalY[p] * boxes.centerY[i]
+                                 + planes.normalZ[p] * boxes.centerZ[i]
+                                 + planes.absNormalX[p] * boxes.extentX[i]
+                                 + planes.absNormalY[p] * boxes.extentY[i]
+                                 + planes.absNormalZ[p] * boxes.extentZ[i]
+                                 + planes.d[p];
+
+            if (distance < VISIBILITY_THRESHOLD) return false;
+        }
+
+        return true;
+    }
+
+    std::uint32_t* writeMask(std::uint32_t* output, unsigned int mask, const std::uint32_t base) {
+        while (mask) {
+            *output++ = base + static_cast<std::uint32_t>(std::countr_zero(mask));
+            mask &= mask - 1;
+        }
+
+        return output;
+    }
+}
+
+/*---------------------------------------*/
+/*                 Boxes                 */
+/*---------------------------------------*/
+
+void FrustumCuller::Boxes::clear() noexcept {
+    centerX.clear();
+    centerY.clear();
+    centerZ.clear();
+
+    extentX.clear();
+    extentY.clear();
+    extentZ.clear();
+}
+
+void FrustumCuller::Boxes::reserve(const std::size_t count) {
+    centerX.reserve(count);
+    centerY.reserve(count);
+    centerZ.reserve(count);
+
+    extentX.reserve(count);
+    extentY.reserve(count);
+    extentZ.reserve(count);
+}
+
+void FrustumCuller::Boxes::add(const Math::Bounds& bounds) {
+    centerX.push_back(bounds.center.x);
+    centerY.push_back(bounds.center.y);
+    centerZ.push_back(bounds.center.z);
+
+    extentX.push_back(bounds.extent.x);
+    extentY.push_back(bounds.extent.y);
+    extentZ.push_back(bounds.extent.z);
+}
+
+/*---------------------------------------*/
+/*                Culling                */
+/*---------------------------------------*/
+
 std::array<Math::Plane, 6> FrustumCuller::getFrustumPlanes(const glm::mat4& viewProjectionMatrix) {
     std::array<Math::Plane, 6> planes{};
     auto& m = viewProjectionMatrix;
@@ -54,3 +139,104 @@ bool FrustumCuller::testVisibility(const Math::AABB& aabb, const std::array<Math
 
     return true;
 }
+
+void FrustumCuller::cull(
+    const Boxes&                      boxes,
+    const std::array<Math::Plane, 6>& frustumPlanes,
+    std::vector<std::uint32_t>&       visibleIndices
+) {
+    PlaneSoA planes{};
+
+    for (std::size_t p = 0; p < 6; p++) {
+        const auto& [normal, d] = frustumPlanes[p];
+
+        planes.normalX[p] = normal.x;
+        planes.normalY[p] = normal.y;
+        planes.normalZ[p] = normal.z;
+
+        planes.absNormalX[p] = std::abs(normal.x);
+        planes.absNormalY[p] = std::abs(normal.y);
+        planes.absNormalZ[p] = std::abs(normal.z);
+
+        planes.d[p] = d;
+    }
+
+    const std::size_t count = boxes.size();
+
+    // Write directly into the output, trimmed to the visible count at the end
+    const std::size_t offset = visibleIndices.size();
+    visibleIndices.resize(offset + count);
+
+    std::uint32_t* output = visibleIndices.data() + offset;
+    std::size_t    i      = 0;
+
+#if defined(NOBLE_SIMD_AVX2)
+    for (; i + 8 <= count; i += 8) {
+        const __m256 cx = _mm256_loadu_ps(&boxes.centerX[i]);
+        const __m256 cy = _mm256_loadu_ps(&boxes.centerY[i]);
+        const __m256 cz = _mm256_loadu_ps(&boxes.centerZ[i]);
+        const __m256 ex = _mm256_loadu_ps(&boxes.extentX[i]);
+        const __m256 ey = _mm256_loadu_ps(&boxes.extentY[i]);
+        const __m256 ez = _mm256_loadu_ps(&boxes.extentZ[i]);
+
+        __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+
+        for (std::size_t p = 0; p < 6; p++) {
+            __m256 distance = _mm256_add_ps(
+                _mm256_mul_ps(_mm256_set1_ps(planes.normalX[p]), cx),
+                _mm256_mul_ps(_mm256_set1_ps(planes.normalY[p]), cy)
+            );
+            distance = _mm256_add_ps(distance, _mm256_mul_ps(_mm256_set1_ps(planes.normalZ[p]), cz));
+            distance = _mm256_add_ps(distance, _mm256_mul_ps(_mm256_set1_ps(planes.absNormalX[p]), ex));
+            distance = _mm256_add_ps(distance, _mm256_mul_ps(_mm256_set1_ps(planes.absNormalY[p]), ey));
+            distance = _mm256_add_ps(distance, _mm256_mul_ps(_mm256_set1_ps(planes.absNormalZ[p]), ez));
+            distance = _mm256_add_ps(distance, _mm256_set1_ps(planes.d[p]));
+
+            inside = _mm256_and_ps(
+                inside, _mm256_cmp_ps(distance, _mm256_set1_ps(VISIBILITY_THRESHOLD), _CMP_GE_OQ)
+            );
+        }
+
+        output = writeMask(
+            output, static_cast<unsigned int>(_mm256_movemask_ps(inside)), static_cast<std::uint32_t>(i)
+        );
+    }
+#endif
+
+#if defined(NOBLE_SIMD_SSE)
+    for (; i + 4 <= count; i += 4) {
+        const __m128 cx = _mm_loadu_ps(&boxes.centerX[i]);
+        const __m128 cy = _mm_loadu_ps(&boxes.centerY[i]);
+        const __m128 cz = _mm_loadu_ps(&boxes.centerZ[i]);
+        const __m128 ex = _mm_loadu_ps(&boxes.extentX[i]);
+        const __m128 ey = _mm_loadu_ps(&boxes.extentY[i]);
+        const __m128 ez = _mm_loadu_ps(&boxes.extentZ[i]);
+
+        __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+
+        for (std::size_t p = 0; p < 6; p++) {
+            __m128 distance = _mm_add_ps(
+                _mm_mul_ps(_mm_set1_ps(planes.normalX[p]), cx),
+                _mm_mul_ps(_mm_set1_ps(planes.normalY[p]), cy)
+            );
+            distance = _mm_add_ps(distance, _mm_mul_ps(_mm_set1_ps(planes.normalZ[p]), cz));
+            distance = _mm_add_ps(distance, _mm_mul_ps(_mm_set1_ps(planes.absNormalX[p]), ex));
+            distance = _mm_add_ps(distance, _mm_mul_ps(_mm_set1_ps(planes.absNormalY[p]), ey));
+            distance = _mm_add_ps(distance, _mm_mul_ps(_mm_set1_ps(planes.absNormalZ[p]), ez));
+            distance = _mm_add_ps(distance, _mm_set1_ps(planes.d[p]));
+
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(distance, _mm_set1_ps(VISIBILITY_THRESHOLD)));
+        }
+
+        output = writeMask(output, static_cast<unsigned int>(_mm_movemask_ps(inside)), static_cast<std::uint32_t>(i));
+    }
+#endif
+
+    for (; i < count; i++) {
+        if (testBox(boxes, planes, i)) {
+            *output++ = static_cast<std::uint32_t>(i);
+        }
+    }
+
+    visibleIndices.resize(static_cast<std::size_t>(output - visibleIndices.data()));
+}
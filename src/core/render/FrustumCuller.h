@@ -6,10 +6,35 @@
 
 class FrustumCuller {
 public:
+    // World-space boxes in center/half-extent form, stored as structure of arrays for the SIMD kernel
+    struct Boxes {
+        std::vector<float> centerX;
+        std::vector<float> centerY;
+        std::vector<float> centerZ;
+
+        std::vector<float> extentX;
+        std::vector<float> extentY;
+        std::vector<float> extentZ;
+
+        void clear() noexcept;
+        void reserve(std::size_t count);
+
+        void add(const Math::Bounds& bounds);
+
+        [[nodiscard]] std::size_t size() const noexcept { return centerX.size(); }
+    };
+
     FrustumCuller()  = default;
     ~FrustumCuller() = default;
 
     [[nodiscard]] static std::array<Math::Plane, 6> getFrustumPlanes(const glm::mat4& viewProjectionMatrix);
 
     [[nodiscard]] static bool testVisibility(const Math::AABB& aabb, const std::array<Math::Plane, 6>& frustumPlanes);
+
+    // Appends the indices of the visible boxes in ascending order, AVX2 (8 boxes) / SSE (4 boxes) / scalar
+    static void cull(
+        const Boxes&                      boxes,
+        const std::array<Math::Plane, 6>& frustumPlanes,
+        std::vector<std::uint32_t>&       visibleIndices
+    );
 };
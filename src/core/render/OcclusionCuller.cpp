@@ -0,0 +1,270 @@
+#include "OcclusionCuller.h"
+
+#include "common/SIMD.h"
+
+#include "core/multithreading/ParallelFor.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    // Points closer than this in clip space are treated as crossing the near plane
+    constexpr float MIN_CLIP_W = 1e-4f;
+
+    // Triangles smaller than this (in pixels squared) cannot cover a pixel center reliably
+    constexpr float MIN_TRIANGLE_AREA = 1e-6f;
+
+    glm::vec2 toScreen(const glm::vec4& clip) {
+        return {
+            (clip.x / clip.w * 0.5f + 0.5f) * static_cast<float>(OcclusionCuller::WIDTH),
+            (clip.y / clip.w * 0.5f + 0.5f) * static_cast<float>(OcclusionCuller::HEIGHT)
+        };
+    }
+}
+
+void OcclusionCuller::render(const glm::mat4& viewProjectionMatrix, const std::span<const Occluder> occluders) {
+    _viewProjectionMatrix = viewProjectionMatrix;
+
+    _depth.assign(static_cast<std::size_t>(WIDTH) * HEIGHT, 0.0f);
+    _tileDepth.assign(static_cast<std::size_t>(TILES_X) * TILES_Y, 0.0f);
+
+    _occluderTriangles.resize(occluders.size());
+
+    // Triangle setup per occluder, then each band rasterizes every triangle overlapping its rows
+    ParallelFor::forEachRange(occluders.size(), 1, [&](const std::size_t begin, const std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            setupTriangles(occluders[i], _occluderTriangles[i]);
+        }
+    });
+
+    ParallelFor::forEachRange(TILES_Y, 1, [&](const std::size_t begin, const std::size_t end) {
+        for (std::size_t tileRow = begin; tileRow < end; tileRow++) {
+            rasterizeBand(static_cast<std::uint32_t>(tileRow));
+        }
+    });
+}
+
+bool OcclusionCuller::testVisibility(const Math::Bounds& bounds) const {
+    if (_tileDepth.empty()) return true;
+
+    // Corners as the projected center plus/minus the projected extent axes
+    const glm::vec4 center = _viewProjectionMatrix * glm::vec4(bounds.center, 1.0f);
+    const glm::vec4 axisX  = _viewProjectionMatrix[0] * bounds.extent.x;
+    const glm::vec4 axisY  = _viewProjectionMatrix[1] * bounds.extent.y;
+    const glm::vec4 axisZ  = _viewProjectionMatrix[2] * bounds.extent.z;
+
+    glm::vec2 screenMin{std::numeric_limits<float>::max()};
+    glm::vec2 screenMax{std::numeric_limits<float>::lowest()};
+
+    float nearestDepth = 0.0f;
+
+    for (std::uint32_t corner = 0; corner < 8; corner++) {
+        const glm::vec4 clip = center
+                             + (corner & 1 ? axisX : -axisX)
+                             + (corner & 2 ? axisY : -axisY)
+                             + (corner & 4 ? axisZ : -axisZ);
+
+        if (clip.w <= MIN_CLIP_W) return true;
+
+        const glm::vec2 screen = toScreen(clip);
+
+        screenMin    = glm::min(screenMin, screen);
+        screenMax    = glm::max(screenMax, screen);
+        nearestDepth = std::max(nearestDepth, clip.z / clip.w);
+    }
+
+    if (screenMax.x < 0.0f || screenMax.y < 0.0f || screenMin.x >= WIDTH || screenMin.y >= HEIGHT) return true;
+
+    const auto toTile = [](const float value, const std::uint32_t tileCount) {
+        const auto tile = static_cast<std::int32_t>(std::floor(value / static_cast<float>(TILE_SIZE)));
+        return static_cast<std::uint32_t>(std::clamp(tile, 0, static_cast<std::int32_t>(tileCount) - 1));
+    };
+
+    const std::uint32_t tileMinX = toTile(screenMin.x, TILES_X);
+    const std::uint32_t tileMaxX = toTile(screenMax.x, TILES_X);
+    const std::uint32_t tileMinY = toTile(screenMin.y, TILES_Y);
+    const std::uint32_t tileMaxY = toTile(screenMax.y, TILES_Y);
+
+    // Visible as soon as the box gets in front of the farthest occluder depth of any covered tile
+    for (std::uint32_t tileY = tileMinY; tileY <= tileMaxY; tileY++) {
+        for (std::uint32_t tileX = tileMinX; tileX <= tileMaxX; tileX++) {
+            if (nearestDepth >= _tileDepth[tileY * TILES_X + tileX]) return true;
+        }
+    }
+
+    return false;
+}
+
+void OcclusionCuller::setupTriangles(const Occluder& occluder, std::vector<ScreenTriangle>& triangles) const {
+    triangles.clear();
+
+    const glm::mat4 modelViewProjection = _viewProjectionMatrix * *occluder.modelMatrix;
+
+    const auto& vertices = occluder.mesh->getVertices();
+    const auto& indices  = occluder.mesh->getIndices();
+
+    for (std::size_t i = 0; i + 2 < indices.size(); i += 3) {
+        std::array<glm::vec4, 3> clip{};
+
+        bool crossesNearPlane = false;
+
+        for (std::size_t v = 0; v < 3; v++) {
+            clip[v] = modelViewProjection * glm::vec4(vertices[indices[i + v]].position, 1.0f);
+            crossesNearPlane |= clip[v].w <= MIN_CLIP_W;
+        }
+
+        // Dropping an occluder triangle only makes the result more conservative
+        if (crossesNearPlane) continue;
+
+        std::array<glm::vec2, 3> screen{};
+        std::array<float, 3>     depth{};
+
+        for (std::size_t v = 0; v < 3; v++) {
+            screen[v] = toScreen(clip[v]);
+            depth[v]  = clip[v].z / clip[v].w;
+        }
+
+        float area = (screen[1].x - screen[0].x) * (screen[2].y - screen[0].y)
+                   - (screen[2].x - screen[0].x) * (screen[1].y - screen[0].y);
+
+        if (std::abs(area) < MIN_TRIANGLE_AREA) continue;
+
+        // Rasterize both faces, flip clockwise triangles
+        if (area < 0.0f) {
+            std::swap(screen[1], screen[2]);
+            std::swap(depth[1], depth[2]);
+            area = -area;
+        }
+
+        ScreenTriangle triangle{};
+
+        const float minX = std::min({screen[0].x, screen[1].x, screen[2].x});
+        const float maxX = std::max({screen[0].x, screen[1].x, screen[2].x});
+        const float minY = std::min({screen[0].y, screen[1].y, screen[2].y});
+        const float maxY = std::max({screen[0].y, screen[1].y, screen[2].y});
+
+        // Clamped in float before the conversion, far off-screen vertices would overflow the integer
+        // fmin/fmax also map a NaN coordinate to a bound
+        const auto toPixel = [](const float value, const std::uint32_t size) {
+            return static_cast<std::int32_t>(std::fmin(std::fmax(value, -1.0f), static_cast<float>(size)));
+        };
+
+        triangle.minX = std::max(0, toPixel(std::floor(minX), WIDTH));
+        triangle.minY = std::max(0, toPixel(std::floor(minY), HEIGHT));
+        triangle.maxX = std::min(static_cast<std::int32_t>(WIDTH) - 1, toPixel(std::ceil(maxX), WIDTH));
+        triangle.maxY = std::min(static_cast<std::int32_t>(HEIGHT) - 1, toPixel(std::ceil(maxY), HEIGHT));
+
+        if (triangle.minX > triangle.maxX || triangle.minY > triangle.maxY) continue;
+
+        // Edge from a to b: (b - a) x (p - a)
+        for (std::size_t e = 0; e < 3; e++) {
+            const glm::vec2& a = screen[e];
+            const glm::vec2& b = screen[(e + 1) % 3];
+
+            triangle.edgeA[e] = a.y - b.y;
+            triangle.edgeB[e] = b.x - a.x;
+            triangle.edgeC[e] = (b.y - a.y) * a.x - (b.x - a.x) * a.y;
+        }
+
+        // Screen-space linear depth plane through the 3 vertices
+        triangle.depthDx = ((depth[1] - depth[0]) * (screen[2].y - screen[0].y)
+                          - (depth[2] - depth[0]) * (screen[1].y - screen[0].y)) / area;
+        triangle.depthDy = ((depth[2] - depth[0]) * (screen[1].x - screen[0].x)
+                          - (depth[1] - depth[0]) * (screen[2].x - screen[0].x)) / area;
+
+        triangle.depthOrigin = depth[0] - triangle.depthDx * screen[0].x - triangle.depthDy * screen[0].y;
+
+        triangles.push_back(triangle);
+    }
+}
+
+void OcclusionCuller::rasterizeBand(const std::uint32_t tileRow) {
+    const auto bandMinY = static_cast<std::int32_t>(tileRow * TILE_SIZE);
+    const auto bandMaxY = static_cast<std::int32_t>(bandMinY + TILE_SIZE - 1);
+
+    for (const auto& triangles : _occluderTriangles) {
+        for (const ScreenTriangle& triangle : triangles) {
+            if (triangle.maxY < bandMinY || triangle.minY > bandMaxY) continue;
+
+            const std::int32_t minY = std::max(triangle.minY, bandMinY);
+            const std::int32_t maxY = std::min(triangle.maxY, bandMaxY);
+
+            // Groups of 4 pixels, WIDTH is a multiple of 4 so groups never leave the row
+            const std::int32_t minX = triangle.minX & ~3;
+
+            for (std::int32_t y = minY; y <= maxY; y++) {
+                const float pixelY = static_cast<float>(y) + 0.5f;
+
+                float* row = &_depth[static_cast<std::size_t>(y) * WIDTH];
+
+                std::int32_t x = minX;
+
+#if defined(NOBLE_SIMD_SSE)
+                const __m128 offsets = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+
+                __m128 edgeA[3];
+                __m128 edgeRow[3];
+
+                for (std::size_t e = 0; e < 3; e++) {
+                    edgeA[e]   = _mm_set1_ps(triangle.edgeA[e]);
+                    edgeRow[e] = _mm_set1_ps(triangle.edgeB[e] * pixelY + triangle.edgeC[e]);
+                }
+
+                const __m128 depthDx  = _mm_set1_ps(triangle.depthDx);
+                const __m128 depthRow = _mm_set1_ps(triangle.depthOrigin + triangle.depthDy * pixelY);
+                const __m128 zero     = _mm_setzero_ps();
+
+                for (; x <= triangle.maxX; x += 4) {
+                    const __m128 pixelX = _mm_add_ps(_mm_set1_ps(static_cast<float>(x)), offsets);
+
+                    __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+
+                    for (std::size_t e = 0; e < 3; e++) {
+                        const __m128 edge = _mm_add_ps(_mm_mul_ps(edgeA[e], pixelX), edgeRow[e]);
+                        inside = _mm_and_ps(inside, _mm_cmpge_ps(edge, zero));
+                    }
+
+                    if (_mm_movemask_ps(inside) == 0) continue;
+
+                    const __m128 depth    = _mm_add_ps(_mm_mul_ps(depthDx, pixelX), depthRow);
+                    const __m128 previous = _mm_loadu_ps(row + x);
+                    const __m128 nearest  = _mm_max_ps(previous, depth);
+
+                    _mm_storeu_ps(row + x, _mm_or_ps(_mm_and_ps(inside, nearest), _mm_andnot_ps(inside, previous)));
+                }
+#endif
+
+                for (; x <= triangle.maxX; x++) {
+                    const float pixelX = static_cast<float>(x) + 0.5f;
+
+                    bool inside = true;
+
+                    for (std::size_t e = 0; e < 3; e++) {
+                        inside &= triangle.edgeA[e] * pixelX + triangle.edgeB[e] * pixelY + triangle.edgeC[e] >= 0.0f;
+                    }
+
+                    if (!inside) continue;
+
+                    const float depth = triangle.depthOrigin + triangle.depthDx * pixelX + triangle.depthDy * pixelY;
+
+                    row[x] = std::max(row[x], depth);
+                }
+            }
+        }
+    }
+
+    // Farthest occluder depth of each tile of the band
+    for (std::uint32_t tileX = 0; tileX < TILES_X; tileX++) {
+        float farthest = 1.0f;
+
+        for (std::uint32_t y = 0; y < TILE_SIZE; y++) {
+            const float* row = &_depth[static_cast<std::size_t>(bandMinY + y) * WIDTH + tileX * TILE_SIZE];
+
+            for (std::uint32_t x = 0; x < TILE_SIZE; x++) {
+                farthest = std::min(farthest, row[x]);
+            }
+        }
+
+        _tileDepth[tileRow * TILES_X + tileX] = farthest;
+    }
+}
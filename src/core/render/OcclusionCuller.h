@@ -0,0 +1,78 @@
+#pragma once
+
+#include "core/resources/models/Mesh.h"
+
+#include <array>
+#include <span>
+#include <vector>
+
+// CPU software occlusion culling
+// Occluder triangles are rasterized into a low-resolution depth buffer in parallel horizontal bands,
+// boxes are then tested against a per-tile conservative depth (farthest occluder depth of the tile)
+// Depth is reversed like the camera projection: 1 at the near plane, 0 at infinity
+class OcclusionCuller {
+public:
+    static constexpr std::uint32_t WIDTH     = 320;
+    static constexpr std::uint32_t HEIGHT    = 192;
+    static constexpr std::uint32_t TILE_SIZE = 8;
+
+    static constexpr std::uint32_t TILES_X = WIDTH / TILE_SIZE;
+    static constexpr std::uint32_t TILES_Y = HEIGHT / TILE_SIZE;
+
+    static_assert(WIDTH % TILE_SIZE == 0 && HEIGHT % TILE_SIZE == 0);
+    static_assert(WIDTH % 4 == 0);
+
+    struct Occluder {
+        const Mesh*      mesh        = nullptr;
+        const glm::mat4* modelMatrix = nullptr;
+    };
+
+    OcclusionCuller()  = default;
+    ~OcclusionCuller() = default;
+
+    OcclusionCuller(const OcclusionCuller&)            = delete;
+    OcclusionCuller& operator=(const OcclusionCuller&) = delete;
+
+    OcclusionCuller(OcclusionCuller&&)            noexcept = default;
+    OcclusionCuller& operator=(OcclusionCuller&&) noexcept = default;
+
+    // Clears the depth buffer and rasterizes the occluders, runs on the ParallelFor pool
+    void render(const glm::mat4& viewProjectionMatrix, std::span<const Occluder> occluders);
+
+    // Conservative, boxes crossing the near plane or leaving the screen are visible
+    [[nodiscard]] bool testVisibility(const Math::Bounds& bounds) const;
+
+    [[nodiscard]] const std::vector<float>& getDepthBuffer() const noexcept { return _depth; }
+    [[nodiscard]] const std::vector<float>& getTileDepths() const noexcept { return _tileDepth; }
+
+private:
+    // Screen-space triangle as edge functions (inside when all are >= 0) and a depth plane equation
+    struct ScreenTriangle {
+        std::array<float, 3> edgeA;
+        std::array<float, 3> edgeB;
+        std::array<float, 3> edgeC;
+
+        float depthOrigin;
+        float depthDx;
+        float depthDy;
+
+        std::int32_t minX;
+        std::int32_t maxX;
+        std::int32_t minY;
+        std::int32_t maxY;
+    };
+
+    // Occluder triangles in front of the near plane and overlapping the screen
+    void setupTriangles(const Occluder& occluder, std::vector<ScreenTriangle>& triangles) const;
+
+    // Rasterizes the pixel rows of one tile row, then reduces its tiles
+    void rasterizeBand(std::uint32_t tileRow);
+
+    glm::mat4 _viewProjectionMatrix{};
+
+    // Per occluder, filled in parallel
+    std::vector<std::vector<ScreenTriangle>> _occluderTriangles{};
+
+    std::vector<float> _depth{};
+    std::vector<float> _tileDepth{};
+};
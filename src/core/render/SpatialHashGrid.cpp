@@ -0,0 +1,240 @@
+#include "SpatialHashGrid.h"
+
+#include <algorithm>
+#include <ranges>
+
+namespace {
+    // Same threshold as FrustumCuller
+    constexpr float VISIBILITY_THRESHOLD = 0.001f;
+
+    // 21 bits per signed cell coordinate
+    constexpr std::int32_t MAX_CELL_COORDINATE = (1 << 20) - 1;
+
+    enum class Containment : std::uint8_t { Outside, Intersecting, Inside };
+
+    Containment classify(const glm::vec3& center, const glm::vec3& extent, const std::array<Math::Plane, 6>& planes) {
+        Containment containment = Containment::Inside;
+
+        for (const auto& [normal, d] : planes) {
+            const float distance = glm::dot(normal, center) + d;
+            const float radius   = glm::dot(glm::abs(normal), extent);
+
+            if (distance + radius < VISIBILITY_THRESHOLD) return Containment::Outside;
+            if (distance - radius < VISIBILITY_THRESHOLD) containment = Containment::Intersecting;
+        }
+
+        return containment;
+    }
+
+    bool overlaps(const Math::AABB& a, const Math::AABB& b) {
+        return glm::all(glm::lessThanEqual(a.minBound, b.maxBound))
+            && glm::all(glm::lessThanEqual(b.minBound, a.maxBound));
+    }
+
+    bool overlaps(const Math::Bounds& bounds, const Math::AABB& aabb) {
+        return overlaps(Math::AABB{bounds.center - bounds.extent, bounds.center + bounds.extent}, aabb);
+    }
+
+    bool overlaps(const Math::Bounds& bounds, const glm::vec3& center, const float radius) {
+        const glm::vec3 closest = glm::clamp(center, bounds.center - bounds.extent, bounds.center + bounds.extent);
+        const glm::vec3 offset  = closest - center;
+
+        return glm::dot(offset, offset) <= radius * radius;
+    }
+}
+
+void SpatialHashGrid::insert(const std::uint32_t id, const Math::Bounds& bounds) {
+    if (id >= _items.size()) _items.resize(id + 1);
+
+    Item& item = _items[id];
+
+    if (item.valid) {
+        update(id, bounds);
+        return;
+    }
+
+    item.bounds = bounds;
+    item.valid  = true;
+
+    addToCell(id, item);
+
+    _itemCount++;
+}
+
+void SpatialHashGrid::update(const std::uint32_t id, const Math::Bounds& bounds) {
+    Item& item = _items[id];
+
+    item.bounds = bounds;
+
+    const CellKey cellKey = getCellKey(getCellCoordinates(bounds.center));
+
+    // Same cell, only its loose extent may grow
+    if (cellKey == item.cell) {
+        Cell& cell = _cells.find(cellKey)->second;
+
+        cell.looseExtent = glm::max(cell.looseExtent, bounds.extent);
+        _maxExtent       = glm::max(_maxExtent, bounds.extent);
+        return;
+    }
+
+    removeFromCell(item);
+    addToCell(id, item);
+}
+
+void SpatialHashGrid::remove(const std::uint32_t id) {
+    if (!contains(id)) return;
+
+    Item& item = _items[id];
+
+    removeFromCell(item);
+
+    item.valid = false;
+
+    _itemCount--;
+}
+
+void SpatialHashGrid::clear() noexcept {
+    _cells.clear();
+    _items.clear();
+
+    _itemCount = 0;
+    _maxExtent = glm::vec3(0.0f);
+}
+
+void SpatialHashGrid::queryFrustum(
+    const std::array<Math::Plane, 6>& frustumPlanes,
+    std::vector<std::uint32_t>&       ids
+) const {
+    for (const Cell& cell : _cells | std::views::values) {
+        if (cell.items.empty()) continue;
+
+        const Math::AABB looseBounds = getLooseBounds(cell);
+
+        const Containment containment = classify(
+            (looseBounds.minBound + looseBounds.maxBound) * 0.5f,
+            (looseBounds.maxBound - looseBounds.minBound) * 0.5f,
+            frustumPlanes
+        );
+
+        if (containment == Containment::Outside) continue;
+
+        // Every item of the cell is within its loose bounds
+        if (containment == Containment::Inside) {
+            ids.insert(ids.end(), cell.items.begin(), cell.items.end());
+            continue;
+        }
+
+        for (const std::uint32_t id : cell.items) {
+            const Math::Bounds& bounds = _items[id].bounds;
+
+            if (classify(bounds.center, bounds.extent, frustumPlanes) != Containment::Outside) ids.push_back(id);
+        }
+    }
+}
+
+void SpatialHashGrid::querySphere(
+    const glm::vec3&            center,
+    const float                 radius,
+    std::vector<std::uint32_t>& ids
+) const {
+    const Math::AABB sphereBounds{center - radius, center + radius};
+
+    forEachCell(sphereBounds, [&](const Cell& cell) {
+        for (const std::uint32_t id : cell.items) {
+            if (overlaps(_items[id].bounds, center, radius)) ids.push_back(id);
+        }
+    });
+}
+
+void SpatialHashGrid::queryAABB(const Math::AABB& aabb, std::vector<std::uint32_t>& ids) const {
+    forEachCell(aabb, [&](const Cell& cell) {
+        for (const std::uint32_t id : cell.items) {
+            if (overlaps(_items[id].bounds, aabb)) ids.push_back(id);
+        }
+    });
+}
+
+glm::ivec3 SpatialHashGrid::getCellCoordinates(const glm::vec3& position) const noexcept {
+    const glm::vec3 coordinates = glm::floor(position * _inverseCellSize);
+
+    constexpr auto maxCoordinate = static_cast<float>(MAX_CELL_COORDINATE);
+
+    return glm::ivec3(glm::clamp(coordinates, glm::vec3(-maxCoordinate), glm::vec3(maxCoordinate)));
+}
+
+SpatialHashGrid::CellKey SpatialHashGrid::getCellKey(const glm::ivec3& coordinates) noexcept {
+    constexpr std::uint64_t mask = (std::uint64_t{1} << 21) - 1;
+
+    return (static_cast<std::uint64_t>(coordinates.x) & mask) << 42
+         | (static_cast<std::uint64_t>(coordinates.y) & mask) << 21
+         | (static_cast<std::uint64_t>(coordinates.z) & mask);
+}
+
+Math::AABB SpatialHashGrid::getLooseBounds(const Cell& cell) const noexcept {
+    const glm::vec3 minBound = glm::vec3(cell.coordinates) * _cellSize;
+
+    return {minBound - cell.looseExtent, minBound + _cellSize + cell.looseExtent};
+}
+
+void SpatialHashGrid::addToCell(const std::uint32_t id, Item& item) {
+    const glm::ivec3 coordinates = getCellCoordinates(item.bounds.center);
+
+    item.cell = getCellKey(coordinates);
+
+    // Emptied cells are kept, their storage is reused
+    Cell& cell = _cells[item.cell];
+
+    if (cell.items.empty()) {
+        cell.coordinates = coordinates;
+        cell.looseExtent = glm::vec3(0.0f);
+    }
+
+    item.slot = static_cast<std::uint32_t>(cell.items.size());
+    cell.items.push_back(id);
+
+    cell.looseExtent = glm::max(cell.looseExtent, item.bounds.extent);
+    _maxExtent       = glm::max(_maxExtent, item.bounds.extent);
+}
+
+void SpatialHashGrid::removeFromCell(const Item& item) {
+    Cell& cell = _cells.find(item.cell)->second;
+
+    // Swap-remove, the moved item takes the slot
+    const std::uint32_t lastID = cell.items.back();
+
+    cell.items[item.slot] = lastID;
+    _items[lastID].slot   = item.slot;
+
+    cell.items.pop_back();
+}
+
+template<typename Visitor>
+void SpatialHashGrid::forEachCell(const Math::AABB& aabb, const Visitor& visitor) const {
+    // Items of a cell overlap the box only if their center is within the box grown by the largest extent
+    const glm::ivec3 first = getCellCoordinates(aabb.minBound - _maxExtent);
+    const glm::ivec3 last  = getCellCoordinates(aabb.maxBound + _maxExtent);
+
+    const auto cellCount = static_cast<std::uint64_t>(last.x - first.x + 1)
+                         * static_cast<std::uint64_t>(last.y - first.y + 1)
+                         * static_cast<std::uint64_t>(last.z - first.z + 1);
+
+    // Large regions scan the occupied cells instead of every covered coordinate
+    if (cellCount > _cells.size()) {
+        for (const Cell& cell : _cells | std::views::values) {
+            if (!cell.items.empty() && overlaps(getLooseBounds(cell), aabb)) visitor(cell);
+        }
+        return;
+    }
+
+    for (std::int32_t x = first.x; x <= last.x; x++) {
+        for (std::int32_t y = first.y; y <= last.y; y++) {
+            for (std::int32_t z = first.z; z <= last.z; z++) {
+                const auto cell = _cells.find(getCellKey({x, y, z}));
+
+                if (cell == _cells.end() || cell->second.items.empty()) continue;
+
+                if (overlaps(getLooseBounds(cell->second), aabb)) visitor(cell->second);
+            }
+        }
+    }
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "common/Math.h"
+
+#include <array>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// Loose hashed uniform grid over world-space boxes, CPU only
+// Items live in the cell holding their center, cells track the largest half-extent of their items and queries test
+// these loosened cell bounds, so updates are O(1): moving within a cell only grows its extent, changing cell is a
+// swap-remove from the old cell and a push into the new one
+class SpatialHashGrid {
+public:
+    static constexpr float DEFAULT_CELL_SIZE = 16.0f;
+
+    explicit SpatialHashGrid(const float cellSize = DEFAULT_CELL_SIZE) noexcept
+        : _cellSize(cellSize), _inverseCellSize(1.0f / cellSize) {}
+
+    ~SpatialHashGrid() = default;
+
+    SpatialHashGrid(const SpatialHashGrid&)            = delete;
+    SpatialHashGrid& operator=(const SpatialHashGrid&) = delete;
+
+    SpatialHashGrid(SpatialHashGrid&&)            noexcept = default;
+    SpatialHashGrid& operator=(SpatialHashGrid&&) noexcept = default;
+
+    // Item IDs are caller indices (e.g. object indices), the item table is sized to the largest ID
+    void insert(std::uint32_t id, const Math::Bounds& bounds);
+    void update(std::uint32_t id, const Math::Bounds& bounds);
+    void remove(std::uint32_t id);
+
+    void clear() noexcept;
+
+    [[nodiscard]] bool contains(const std::uint32_t id) const noexcept {
+        return id < _items.size() && _items[id].valid;
+    }
+
+    // Append the IDs of the items inside or intersecting the volume, in no particular order
+    void queryFrustum(const std::array<Math::Plane, 6>& frustumPlanes, std::vector<std::uint32_t>& ids) const;
+    void querySphere(const glm::vec3& center, float radius, std::vector<std::uint32_t>& ids) const;
+    void queryAABB(const Math::AABB& aabb, std::vector<std::uint32_t>& ids) const;
+
+    [[nodiscard]] std::size_t size() const noexcept { return _itemCount; }
+
+    [[nodiscard]] std::size_t getCellCount() const noexcept { return _cells.size(); }
+
+    [[nodiscard]] float getCellSize() const noexcept { return _cellSize; }
+
+private:
+    using CellKey = std::uint64_t;
+
+    struct Cell {
+        std::vector<std::uint32_t> items{};
+
+        glm::ivec3 coordinates{0};
+
+        // Largest item half-extent since the cell was last empty
+        glm::vec3 looseExtent{0.0f};
+    };
+
+    struct Item {
+        Math::Bounds bounds{};
+
+        CellKey       cell = 0;
+        std::uint32_t slot = 0;
+
+        bool valid = false;
+    };
+
+    [[nodiscard]] glm::ivec3 getCellCoordinates(const glm::vec3& position) const noexcept;
+
+    [[nodiscard]] static CellKey getCellKey(const glm::ivec3& coordinates) noexcept;
+
+    [[nodiscard]] Math::AABB getLooseBounds(const Cell& cell) const noexcept;
+
+    void addToCell(std::uint32_t id, Item& item);
+    void removeFromCell(const Item& item);
+
+    // Calls visitor(cell) for the non-empty cells whose items may overlap the box
+    template<typename Visitor>
+    void forEachCell(const Math::AABB& aabb, const Visitor& visitor) const;
+
+    float _cellSize        = DEFAULT_CELL_SIZE;
+    float _inverseCellSize = 1.0f / DEFAULT_CELL_SIZE;
+
+    std::unordered_map<CellKey, Cell> _cells{};
+
+    std::vector<Item> _items{};
+    std::size_t       _itemCount = 0;
+
+    // Largest item half-extent ever inserted, bounds the cells visited by region queries
+    glm::vec3 _maxExtent{0.0f};
+};
@@ -4,5 +4,6 @@ namespace AssetPaths {
     inline constexpr auto ICON      = RESOURCES_DIR "/icon.png";
     inline constexpr auto MODELS    = RESOURCES_DIR "/models/";
     inline constexpr auto TEXTURES  = RESOURCES_DIR "/textures/";
+    inline constexpr auto CACHE     = RESOURCES_DIR "/cache/";
     inline constexpr auto SHADERS   = SHADERS_SPV_DIR;
 }
@@ -0,0 +1,488 @@
+#include "AssetCache.h"
+
+#include "core/debug/Logger.h"
+#include "core/resources/AssetPaths.h"
+
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <unordered_map>
+
+namespace {
+    /*---------------------------------------*/
+    /*             Serialization             */
+    /*---------------------------------------*/
+
+    template<typename T>
+    requires std::is_trivially_copyable_v<T>
+    void write(std::ofstream& file, const T& value) {
+        file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    template<typename T>
+    requires std::is_trivially_copyable_v<T>
+    void writeArray(std::ofstream& file, const std::vector<T>& values) {
+        write(file, static_cast<std::uint64_t>(values.size()));
+        file.write(
+            reinterpret_cast<const char*>(values.data()), static_cast<std::streamsize>(values.size() * sizeof(T))
+        );
+    }
+
+    void writeString(std::ofstream& file, const std::string& value) {
+        write(file, static_cast<std::uint32_t>(value.size()));
+        file.write(value.data(), static_cast<std::streamsize>(value.size()));
+    }
+
+    template<typename T>
+    requires std::is_trivially_copyable_v<T>
+    bool read(std::ifstream& file, T& value) {
+        return static_cast<bool>(file.read(reinterpret_cast<char*>(&value), sizeof(T)));
+    }
+
+    // Sizes read from a cache are checked against the bytes left in the file before allocating
+    // A corrupt size then fails the read instead of requesting an arbitrary amount of memory
+    bool fitsInFile(std::ifstream& file, const std::uint64_t count, const std::size_t elementSize) {
+        const std::streampos position = file.tellg();
+        file.seekg(0, std::ios::end);
+        const std::streampos end = file.tellg();
+        file.seekg(position);
+
+        if (!file || position < 0 || end < position) return false;
+
+        return count <= static_cast<std::uint64_t>(end - position) / elementSize;
+    }
+
+    template<typename T>
+    requires std::is_trivially_copyable_v<T>
+    bool readArray(std::ifstream& file, std::vector<T>& values) {
+        std::uint64_t size = 0;
+        if (!read(file, size) || !fitsInFile(file, size, sizeof(T))) return false;
+
+        values.resize(size);
+        return static_cast<bool>(
+            file.read(reinterpret_cast<char*>(values.data()), static_cast<std::streamsize>(size * sizeof(T)))
+        );
+    }
+
+    bool readString(std::ifstream& file, std::string& value) {
+        std::uint32_t size = 0;
+        if (!read(file, size) || !fitsInFile(file, size, 1)) return false;
+
+        value.resize(size);
+        return static_cast<bool>(file.read(value.data(), size));
+    }
+
+    Expected<std::ofstream> openForWrite(const std::string& path) {
+        std::error_code error;
+        std::filesystem::create_directories(std::filesystem::path(path).parent_path(), error);
+
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+
+        if (!file.is_open()) {
+            return FAIL("Failed to open \"" + path + "\" for writing", "AssetCache");
+        }
+
+        return Expected(std::move(file));
+    }
+
+    void writeHeader(std::ofstream& file, const std::uint32_t magic, const AssetCache::SourceStamp& source) {
+        write(file, magic);
+        write(file, AssetCache::VERSION);
+        write(file, source.size);
+        write(file, source.writeTime);
+    }
+
+    Expected<std::ifstream> openForRead(
+        const std::string&             path,
+        const std::uint32_t            magic,
+        const AssetCache::SourceStamp& source
+    ) {
+        std::ifstream file(path, std::ios::binary);
+
+        if (!file.is_open()) {
+            return FAIL("Failed to open \"" + path + "\"", "AssetCache");
+        }
+
+        std::uint32_t fileMagic   = 0;
+        std::uint32_t fileVersion = 0;
+
+        if (!read(file, fileMagic) || !read(file, fileVersion) || fileMagic != magic) {
+            return FAIL("Invalid cache file \"" + path + "\"", "AssetCache");
+        }
+
+        if (fileVersion != AssetCache::VERSION) {
+            return FAIL("Outdated cache file \"" + path + "\", rebake assets", "AssetCache");
+        }
+
+        AssetCache::SourceStamp fileSource{};
+
+        if (!read(file, fileSource.size) || !read(file, fileSource.writeTime) || fileSource != source) {
+            return FAIL("Stale cache file \"" + path + "\", its source changed, rebake assets", "AssetCache");
+        }
+
+        return Expected(std::move(file));
+    }
+
+    /*---------------------------------------*/
+    /*               Materials               */
+    /*---------------------------------------*/
+
+    void writeMaterial(std::ofstream& file, const Material& material) {
+        writeString(file, material.name);
+
+        write(file, material.diffuse);
+        write(file, material.normal);
+        write(file, material.specular);
+        write(file, material.emission);
+
+        writeString(file, material.albedoPath);
+        writeString(file, material.normalPath);
+        writeString(file, material.specularPath);
+        writeString(file, material.roughnessPath);
+        writeString(file, material.metallicPath);
+
+        write(file, material.ior);
+        write(file, material.metallic);
+        write(file, material.roughness);
+
+        write(file, material.maxDrawDistance);
+
+        write(file, static_cast<std::uint8_t>(material.hasTransparency));
+    }
+
+    bool readMaterial(std::ifstream& file, Material& material) {
+        std::uint8_t hasTransparency = 0;
+
+        const bool valid = readString(file, material.name)
+            && read(file, material.diffuse)
+            && read(file, material.normal)
+            && read(file, material.specular)
+            && read(file, material.emission)
+            && readString(file, material.albedoPath)
+            && readString(file, material.normalPath)
+            && readString(file, material.specularPath)
+            && readString(file, material.roughnessPath)
+            && readString(file, material.metallicPath)
+            && read(file, material.ior)
+            && read(file, material.metallic)
+            && read(file, material.roughness)
+            && read(file, material.maxDrawDistance)
+            && read(file, hasTransparency);
+
+        material.hasTransparency = hasTransparency != 0;
+
+        return valid;
+    }
+
+    std::atomic<bool> lookupEnabled{true};
+
+    // Shared lookup of the loader entry points, a missing cache is the common case and stays silent
+    template<typename T, typename ReadFunction>
+    std::optional<T> findCached(
+        const std::string& cachePath, const std::string& sourcePath, const ReadFunction& readFunction
+    ) {
+        if (!lookupEnabled.load(std::memory_order_relaxed)) return std::nullopt;
+
+        std::error_code error;
+        if (!std::filesystem::exists(cachePath, error)) return std::nullopt;
+
+        const Expected<AssetCache::SourceStamp> source = AssetCache::getSourceStamp(sourcePath);
+
+        if (!source) {
+            Logger::verbose(source.failure().error.message);
+            return std::nullopt;
+        }
+
+        Expected<T> cached = readFunction(cachePath, source.value());
+
+        if (!cached) {
+            Logger::verbose(cached.failure().error.message + ", parsing the source instead");
+            return std::nullopt;
+        }
+
+        return std::optional<T>(std::move(cached.value()));
+    }
+
+    struct MeshDataKey {
+        const Mesh* mesh;
+
+        bool operator==(const MeshDataKey& other) const noexcept {
+            return mesh->getVertices() == other.mesh->getVertices() && mesh->getIndices() == other.mesh->getIndices();
+        }
+    };
+
+    struct MeshDataKeyHash {
+        std::size_t operator()(const MeshDataKey& key) const noexcept {
+            std::size_t hash = 0;
+
+            HashUtils::combine(hash, key.mesh->getIndices().size());
+
+            for (const Vertex& vertex : key.mesh->getVertices()) {
+                HashUtils::combine(hash, std::hash<Vertex>{}(vertex));
+            }
+
+            return hash;
+        }
+    };
+}
+
+namespace AssetCache {
+    Expected<SourceStamp> getSourceStamp(const std::string& sourcePath) {
+        std::error_code error;
+
+        const std::uintmax_t                  size      = std::filesystem::file_size(sourcePath, error);
+        const std::filesystem::file_time_type writeTime = error
+            ? std::filesystem::file_time_type{}
+            : std::filesystem::last_write_time(sourcePath, error);
+
+        if (error) {
+            return FAIL("Failed to stat source \"" + sourcePath + "\": " + error.message(), "AssetCache");
+        }
+
+        return Expected(SourceStamp{
+            static_cast<std::uint64_t>(size), static_cast<std::int64_t>(writeTime.time_since_epoch().count())
+        });
+    }
+
+    Texture buildMipChain(const Image& image) {
+        Texture texture{};
+        texture.path = image.path;
+
+        MipLevel base{};
+        base.width  = static_cast<std::uint32_t>(image.width);
+        base.height = static_cast<std::uint32_t>(image.height);
+
+        // Base level only, images loaded from a cache also hold their chain
+        const std::size_t baseSize = static_cast<std::size_t>(base.width) * base.height * 4;
+        base.pixels.assign(image.pixels.get(), image.pixels.get() + baseSize);
+
+        texture.mipLevels.push_back(std::move(base));
+
+        if (!image.hasMipmaps) return texture;
+
+        while (texture.mipLevels.back().width > 1 || texture.mipLevels.back().height > 1) {
+            const MipLevel& source = texture.mipLevels.back();
+
+            MipLevel level{};
+            level.width  = std::max(1u, source.width  / 2);
+            level.height = std::max(1u, source.height / 2);
+            level.pixels.resize(static_cast<std::size_t>(level.width) * level.height * 4);
+
+            // 2x2 box filter, odd edges clamp to the last source texel
+            for (std::uint32_t y = 0; y < level.height; y++) {
+                const std::uint32_t y0 = std::min(y * 2,     source.height - 1);
+                const std::uint32_t y1 = std::min(y * 2 + 1, source.height - 1);
+
+                for (std::uint32_t x = 0; x < level.width; x++) {
+                    const std::uint32_t x0 = std::min(x * 2,     source.width - 1);
+                    const std::uint32_t x1 = std::min(x * 2 + 1, source.width - 1);
+
+                    for (std::uint32_t channel = 0; channel < 4; channel++) {
+                        const auto texel = [&](const std::uint32_t sx, const std::uint32_t sy) {
+                            return static_cast<std::uint32_t>(source.pixels[(sy * source.width + sx) * 4 + channel]);
+                        };
+
+                        const std::uint32_t sum = texel(x0, y0) + texel(x1, y0) + texel(x0, y1) + texel(x1, y1);
+
+                        level.pixels[(y * level.width + x) * 4 + channel] = static_cast<std::uint8_t>((sum + 2) / 4);
+                    }
+                }
+            }
+
+            texture.mipLevels.push_back(std::move(level));
+        }
+
+        return texture;
+    }
+
+    Expected<void> writeModel(const Model& model, const SourceStamp& source, const std::string& path) {
+        std::ofstream file;
+        TRY_ASSIGN(file, openForWrite(path));
+
+        // Deduplicate mesh data
+        std::unordered_map<MeshDataKey, std::uint32_t, MeshDataKeyHash> meshDataIndices;
+        std::vector<const Mesh*>   uniqueMeshes;
+        std::vector<std::uint32_t> meshDataIndex;
+
+        for (const Mesh& mesh : model.meshes) {
+            const auto [it, inserted] = meshDataIndices.try_emplace(
+                MeshDataKey{&mesh}, static_cast<std::uint32_t>(uniqueMeshes.size())
+            );
+
+            if (inserted) uniqueMeshes.push_back(&mesh);
+
+            meshDataIndex.push_back(it->second);
+        }
+
+        writeHeader(file, MODEL_MAGIC, source);
+
+        writeString(file, model.path);
+        writeString(file, model.name);
+
+        write(file, static_cast<std::uint32_t>(uniqueMeshes.size()));
+
+        for (const Mesh* mesh : uniqueMeshes) {
+            writeArray(file, mesh->getVertices());
+            writeArray(file, mesh->getIndices());
+        }
+
+        write(file, static_cast<std::uint32_t>(model.meshes.size()));
+
+        for (std::size_t i = 0; i < model.meshes.size(); i++) {
+            write(file, meshDataIndex[i]);
+            write(file, model.meshes[i].getAABB());
+            write(file, static_cast<std::uint8_t>(model.meshes[i].isOccluder()));
+            writeMaterial(file, model.meshes[i].getMaterial());
+        }
+
+        write(file, static_cast<std::uint32_t>(model.texturePaths.size()));
+
+        for (const std::string& texturePath : model.texturePaths) {
+            writeString(file, texturePath);
+        }
+
+        if (!file) {
+            return FAIL("Failed to write model cache \"" + path + "\"", "AssetCache");
+        }
+
+        return {};
+    }
+
+    Expected<Model> readModel(const std::string& path, const SourceStamp& source) {
+        std::ifstream file;
+        TRY_ASSIGN(file, openForRead(path, MODEL_MAGIC, source));
+
+        Model model{};
+
+        struct MeshData {
+            std::vector<Vertex>        vertices;
+            std::vector<std::uint32_t> indices;
+        };
+
+        std::vector<MeshData> meshData;
+        std::uint32_t         count = 0;
+
+        // Each mesh data holds at least its two array sizes
+        bool valid = readString(file, model.path) && readString(file, model.name) && read(file, count)
+                  && fitsInFile(file, count, 2 * sizeof(std::uint64_t));
+
+        if (valid) meshData.resize(count);
+
+        for (std::size_t i = 0; valid && i < meshData.size(); i++) {
+            valid = readArray(file, meshData[i].vertices) && readArray(file, meshData[i].indices);
+        }
+
+        valid = valid && read(file, count);
+
+        for (std::uint32_t i = 0; valid && i < count; i++) {
+            std::uint32_t dataIndex = 0;
+            Math::AABB    aabb{};
+            std::uint8_t  occluder = 0;
+            Material      material{};
+
+            valid = read(file, dataIndex) && dataIndex < meshData.size()
+                 && read(file, aabb)
+                 && read(file, occluder)
+                 && readMaterial(file, material);
+            if (!valid) break;
+
+            Mesh mesh{};
+            mesh.loadData(meshData[dataIndex].vertices, meshData[dataIndex].indices);
+            mesh.setAABB(aabb);
+            mesh.setMaterial(material);
+            mesh.setOccluder(occluder != 0);
+
+            model.addMesh(mesh);
+        }
+
+        valid = valid && read(file, count);
+
+        for (std::uint32_t i = 0; valid && i < count; i++) {
+            std::string texturePath;
+            valid = readString(file, texturePath);
+
+            model.texturePaths.insert(std::move(texturePath));
+        }
+
+        if (!valid) {
+            return FAIL("Truncated model cache \"" + path + "\"", "AssetCache");
+        }
+
+        return Expected(std::move(model));
+    }
+
+    Expected<void> writeTexture(const Texture& texture, const SourceStamp& source, const std::string& path) {
+        std::ofstream file;
+        TRY_ASSIGN(file, openForWrite(path));
+
+        writeHeader(file, TEXTURE_MAGIC, source);
+
+        writeString(file, texture.path);
+
+        write(file, static_cast<std::uint32_t>(texture.mipLevels.size()));
+
+        for (const auto& [width, height, pixels] : texture.mipLevels) {
+            write(file, width);
+            write(file, height);
+            writeArray(file, pixels);
+        }
+
+        if (!file) {
+            return FAIL("Failed to write texture cache \"" + path + "\"", "AssetCache");
+        }
+
+        return {};
+    }
+
+    Expected<Texture> readTexture(const std::string& path, const SourceStamp& source) {
+        std::ifstream file;
+        TRY_ASSIGN(file, openForRead(path, TEXTURE_MAGIC, source));
+
+        Texture       texture{};
+        std::uint32_t count = 0;
+
+        // Each level holds at least its extent and its array size
+        bool valid = readString(file, texture.path) && read(file, count)
+                  && fitsInFile(file, count, 2 * sizeof(std::uint32_t) + sizeof(std::uint64_t));
+
+        if (valid) texture.mipLevels.resize(count);
+
+        valid = valid && count > 0;
+
+        for (auto& [width, height, pixels] : texture.mipLevels) {
+            valid = valid && read(file, width) && read(file, height) && readArray(file, pixels)
+                 && pixels.size() == static_cast<std::size_t>(width) * height * 4;
+        }
+
+        if (!valid) {
+            return FAIL("Truncated texture cache \"" + path + "\"", "AssetCache");
+        }
+
+        return Expected(std::move(texture));
+    }
+
+    void setLookupEnabled(const bool enabled) noexcept {
+        lookupEnabled.store(enabled, std::memory_order_relaxed);
+    }
+
+    std::optional<Model> findModel(const std::string& modelPath) {
+        return findCached<Model>(
+            getCachePath(std::string(AssetPaths::CACHE) + MODELS_DIRECTORY, modelPath, MODEL_EXTENSION),
+            AssetPaths::MODELS + modelPath,
+            readModel
+        );
+    }
+
+    std::optional<Texture> findTexture(const std::string& texturePath) {
+        return findCached<Texture>(
+            getCachePath(std::string(AssetPaths::CACHE) + TEXTURES_DIRECTORY, texturePath, TEXTURE_EXTENSION),
+            AssetPaths::TEXTURES + texturePath,
+            readTexture
+        );
+    }
+
+    std::string getCachePath(const std::string& directory, const std::string& assetPath, const char* extension) {
+        return (std::filesystem::path(directory) / (assetPath + extension)).generic_string();
+    }
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "core/debug/ErrorHandling.h"
+#include "core/resources/images/Image.h"
+#include "core/resources/models/Model.h"
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+// Binary model/texture caches written by NobleAssetBaker, read by the model and image loaders before parsing
+// Data is stored in native layout (little-endian, engine Vertex layout), caches are not portable across versions
+namespace AssetCache {
+    inline constexpr std::uint32_t MODEL_MAGIC   = 0x444D424E; // "NBMD"
+    inline constexpr std::uint32_t TEXTURE_MAGIC = 0x5854424E; // "NBTX"
+    inline constexpr std::uint32_t VERSION       = 5;
+
+    inline constexpr auto MODEL_EXTENSION   = ".nbmodel";
+    inline constexpr auto TEXTURE_EXTENSION = ".nbtexture";
+
+    // Subdirectories of a cache root (AssetPaths::CACHE by default)
+    inline constexpr auto MODELS_DIRECTORY   = "models/";
+    inline constexpr auto TEXTURES_DIRECTORY = "textures/";
+
+    // Identifies the source file a cache was baked from, a cache is only used while its source is unchanged
+    // The write time is the raw file clock count, comparable on the machine that baked the cache only
+    struct SourceStamp {
+        std::uint64_t size      = 0;
+        std::int64_t  writeTime = 0;
+
+        bool operator==(const SourceStamp&) const = default;
+    };
+
+    [[nodiscard]] Expected<SourceStamp> getSourceStamp(const std::string& sourcePath);
+
+    struct MipLevel {
+        std::uint32_t width  = 0;
+        std::uint32_t height = 0;
+
+        std::vector<std::uint8_t> pixels{};
+    };
+
+    // RGBA8 texture with its full mip chain
+    struct Texture {
+        std::string path;
+
+        std::vector<MipLevel> mipLevels{};
+    };
+
+    // Box-filtered RGBA8 mip chain down to 1x1 (base level only without mipmaps), same extents as the runtime blit chain
+    [[nodiscard]] Texture buildMipChain(const Image& image);
+
+    // Identical meshes within a model are stored once and referenced by index
+    // Reads fail on a version or source stamp mismatch, callers then fall back to parsing the source
+    [[nodiscard]] Expected<void> writeModel(const Model& model, const SourceStamp& source, const std::string& path);
+    [[nodiscard]] Expected<Model> readModel(const std::string& path, const SourceStamp& source);
+
+    [[nodiscard]] Expected<void> writeTexture(
+        const Texture& texture, const SourceStamp& source, const std::string& path
+    );
+    [[nodiscard]] Expected<Texture> readTexture(const std::string& path, const SourceStamp& source);
+
+    // Loader entry points, look up the cache of a model/texture path under AssetPaths::CACHE
+    // Returns nullopt when no usable cache exists (missing, outdated or stale), the caller then parses the source
+    [[nodiscard]] std::optional<Model>   findModel(const std::string& modelPath);
+    [[nodiscard]] std::optional<Texture> findTexture(const std::string& texturePath);
+
+    // Enabled by default, NobleAssetBaker disables lookups so that it always bakes from the sources
+    void setLookupEnabled(bool enabled) noexcept;
+
+    // Cache file path for an asset path, e.g. "sponza/albedo.png" -> "<directory>/sponza/albedo.png.nbtexture"
+    [[nodiscard]] std::string getCachePath(
+        const std::string& directory,
+        const std::string& assetPath,
+        const char*        extension
+    );
+}
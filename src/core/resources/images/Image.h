@@ -20,6 +20,9 @@ struct Image {
 
     bool hasMipmaps = false;
 
+    // Mip levels stored back to back in pixels (baked caches), the chain of a single level is generated at upload
+    std::uint32_t mipLevels = 1;
+
     static std::uint8_t toByte(const float value) {
         return static_cast<std::uint8_t>(std::clamp(value, 0.0f, 1.0f) * 255.0f);
     }
@@ -2,14 +2,43 @@
 
 #include "core/debug/Logger.h"
 #include "core/resources/AssetPaths.h"
+#include "core/resources/cache/AssetCache.h"
 
 #include "libraries/stbUsage.h"
 
+#include <algorithm>
+
 ImageManager::ResourceHandlePointer ImageManager::load(const std::string& path, const bool hasMipmaps) {
     return loadAsync(path, [path, hasMipmaps]() -> Expected<ResourcePointer> {
 
         Logger::info("Loading texture \"" + path + "\"...");
 
+        // A baked cache matching the source skips decoding, its mip chain is uploaded as is
+        if (std::optional<AssetCache::Texture> cached = AssetCache::findTexture(path)) {
+            const std::size_t levelCount = hasMipmaps ? cached->mipLevels.size() : 1;
+
+            std::size_t byteSize = 0;
+            for (std::size_t i = 0; i < levelCount; i++) byteSize += cached->mipLevels[i].pixels.size();
+
+            auto image = std::make_unique<Image>();
+
+            image->path       = path;
+            image->pixels     = std::make_unique_for_overwrite<std::uint8_t[]>(byteSize);
+            image->width      = static_cast<int>(cached->mipLevels.front().width);
+            image->height     = static_cast<int>(cached->mipLevels.front().height);
+            image->channels   = STBI_rgb_alpha;
+            image->byteSize   = byteSize;
+            image->hasMipmaps = hasMipmaps;
+            image->mipLevels  = static_cast<std::uint32_t>(levelCount);
+
+            std::uint8_t* destination = image->pixels.get();
+            for (std::size_t i = 0; i < levelCount; i++) {
+                destination = std::ranges::copy(cached->mipLevels[i].pixels, destination).out;
+            }
+
+            return Expected(std::move(image));
+        }
+
         const std::string fullPath = AssetPaths::TEXTURES + path;
 
         // Load image bytes
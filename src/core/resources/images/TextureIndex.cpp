@@ -0,0 +1,119 @@
+#include "TextureIndex.h"
+
+#include "core/debug/Logger.h"
+#include "core/resources/AssetPaths.h"
+
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+
+const TextureIndex& TextureIndex::get() {
+    static TextureIndex   index;
+    static std::once_flag built;
+
+    std::call_once(built, [] { index.build(AssetPaths::TEXTURES); });
+
+    return index;
+}
+
+std::string TextureIndex::find(const std::string_view relativePath) const {
+    if (relativePath.empty()) return "";
+
+    const std::string key = normalize(relativePath);
+
+    // Fast path: exact match
+    if (const auto it = _paths.find(key); it != _paths.end()) {
+        return it->second;
+    }
+
+    // Fallback to a case-insensitive match, asset references are often authored on case-insensitive filesystems
+    if (const auto it = _lowercasePaths.find(toLower(key)); it != _lowercasePaths.end()) {
+        return it->second;
+    }
+
+    return "";
+}
+
+std::string TextureIndex::normalize(const std::string_view path) {
+    std::string normalized(path);
+    std::ranges::replace(normalized, '\\', '/');
+
+    return std::filesystem::path(normalized).lexically_normal().generic_string();
+}
+
+void TextureIndex::build(const std::string& rootDirectory) {
+    const std::string manifestPath = rootDirectory + MANIFEST_FILENAME;
+
+    if (loadManifest(manifestPath)) {
+        Logger::info("Loaded texture index manifest (" + std::to_string(_paths.size()) + " textures)");
+        return;
+    }
+
+    scanDirectory(rootDirectory);
+
+    Logger::info("Built texture index (" + std::to_string(_paths.size()) + " textures)");
+}
+
+bool TextureIndex::loadManifest(const std::string& manifestPath) {
+    std::ifstream manifest(manifestPath);
+    if (!manifest.is_open()) return false;
+
+    std::string line;
+    while (std::getline(manifest, line)) {
+        // Tolerate CRLF manifests
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+
+        if (line.empty() || line.front() == '#') continue;
+
+        insert(normalize(line));
+    }
+
+    return true;
+}
+
+void TextureIndex::scanDirectory(const std::string& rootDirectory) {
+    std::error_code error;
+
+    const std::filesystem::path rootPath(rootDirectory);
+
+    auto iterator = std::filesystem::recursive_directory_iterator(
+        rootPath, std::filesystem::directory_options::skip_permission_denied, error
+    );
+
+    if (error) {
+        Logger::warning("Failed to scan texture directory \"" + rootDirectory + "\": " + error.message());
+        return;
+    }
+
+    for (const auto end = std::filesystem::recursive_directory_iterator(); iterator != end; iterator.increment(error)) {
+        if (error) {
+            Logger::warning("Failed to scan texture directory \"" + rootDirectory + "\": " + error.message());
+            break;
+        }
+
+        if (!iterator->is_regular_file(error)) continue;
+
+        insert(iterator->path().lexically_relative(rootPath).generic_string());
+    }
+}
+
+void TextureIndex::insert(const std::string& relativePath) {
+    if (relativePath.empty() || relativePath == MANIFEST_FILENAME) return;
+
+    _paths.emplace(relativePath, relativePath);
+
+    // Keep the first on-disk spelling if several files only differ by case
+    _lowercasePaths.emplace(toLower(relativePath), relativePath);
+}
+
+std::string TextureIndex::toLower(const std::string_view path) {
+    std::string lower(path);
+
+    std::ranges::transform(lower, lower.begin(), [](const unsigned char c) {
+        return static_cast<char>(std::tolower(c));
+    });
+
+    return lower;
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+// In-memory index of every file under AssetPaths::TEXTURES, built once on first use
+// Lookups are exact first, then case-insensitive, and always return the on-disk relative path
+class TextureIndex {
+public:
+    // Optional prebuilt list of texture paths (one relative path per line) used instead of a directory scan
+    static constexpr auto MANIFEST_FILENAME = "textures.manifest";
+
+    TextureIndex()  = default;
+    ~TextureIndex() = default;
+
+    TextureIndex(const TextureIndex&)            = delete;
+    TextureIndex& operator=(const TextureIndex&) = delete;
+
+    TextureIndex(TextureIndex&&)            = delete;
+    TextureIndex& operator=(TextureIndex&&) = delete;
+
+    // Thread-safe, the first caller builds the index
+    [[nodiscard]] static const TextureIndex& get();
+
+    // Returns the relative path as stored on disk, or an empty string if the texture doesn't exist
+    [[nodiscard]] std::string find(std::string_view relativePath) const;
+
+    [[nodiscard]] std::size_t size() const noexcept { return _paths.size(); }
+
+    [[nodiscard]] static std::string normalize(std::string_view path);
+
+private:
+    void build(const std::string& rootDirectory);
+
+    bool loadManifest(const std::string& manifestPath);
+
+    void scanDirectory(const std::string& rootDirectory);
+
+    void insert(const std::string& relativePath);
+
+    [[nodiscard]] static std::string toLower(std::string_view path);
+
+    // Normalized relative path -> itself, used for exact lookups
+    std::unordered_map<std::string, std::string> _paths{};
+
+    // Lowercase relative path -> on-disk relative path
+    std::unordered_map<std::string, std::string> _lowercasePaths{};
+};
@@ -2,7 +2,7 @@
 
 #include "common/HashUtils.h"
 
-#include "core/resources/AssetPaths.h"
+#include "core/resources/images/TextureIndex.h"
 
 #include <filesystem>
 #include <string>
@@ -34,6 +34,12 @@ struct Material {
     double metallic  = 0.0;
     double roughness = 0.0;
 
+    // Draws are rejected beyond this camera distance in world units, 0 for unlimited
+    float maxDrawDistance = 0.0f;
+
+    // Alpha tested or blended, the geometry behind such a surface can show through it
+    bool hasTransparency = false;
+
     bool operator==(const Material& other) const noexcept = default;
 };
 
@@ -57,6 +63,9 @@ struct MaterialHash {
         HashUtils::combine(hash, m.metallic);
         HashUtils::combine(hash, m.roughness);
 
+        HashUtils::combine(hash, m.maxDrawDistance);
+        HashUtils::combine(hash, m.hasTransparency);
+
         return hash;
     }
 };
@@ -65,25 +74,18 @@ namespace TextureHelper {
     inline auto sanitizeTexturePath = [](const std::string& texturePath, const std::string& modelName) -> std::string {
         if (texturePath.empty()) return "";
 
+        const TextureIndex& textureIndex = TextureIndex::get();
+
         // Fetch texture in textures/texturePath
-        std::filesystem::path initialPath = AssetPaths::TEXTURES;
-        initialPath /= texturePath;
+        std::string foundPath = textureIndex.find(texturePath);
         // Found texture
-        if (std::filesystem::exists(initialPath)) {
-            return texturePath;
+        if (!foundPath.empty()) {
+            return foundPath;
         }
 
         // Fetch texture in textures/modelName/texturePath
-        const std::filesystem::path textureName = std::filesystem::path(texturePath).filename();
-
-        std::filesystem::path candidatePath = AssetPaths::TEXTURES;
-        candidatePath /= modelName;
-        candidatePath /= textureName;
-        // Found texture
-        if (std::filesystem::exists(candidatePath)) {
-            return modelName + '/' + textureName.string();
-        }
+        const std::string textureName = std::filesystem::path(TextureIndex::normalize(texturePath)).filename().string();
 
-        return "";
+        return textureIndex.find(modelName + '/' + textureName);
     };
 }
@@ -1,58 +1,227 @@
 #include "Mesh.h"
 
+#include "common/SIMD.h"
+
+#include "core/multithreading/ParallelFor.h"
+
 #include <cmath>
 
 #include "mikktspace/mikktspace.h"
 
-int getNumFaces(const SMikkTSpaceContext* context) {
-    auto* mesh = static_cast<Mesh*>(context->m_pUserData);
-    return static_cast<int>(mesh->getIndices().size() / 3);
-}
+namespace {
+    // Below this size the work is done inline, splitting only pays off on large scans
+    constexpr std::size_t PARALLEL_GRAIN = 1 << 14;
 
-int getNumFaceVertices(const SMikkTSpaceContext*, int) {
-    return 3;
-}
+    // SoA face normal scratch, computed in parallel then accumulated in face order
+    struct FaceNormals {
+        std::vector<float> x;
+        std::vector<float> y;
+        std::vector<float> z;
 
-Vertex& getVertex(const SMikkTSpaceContext* context, const int face, const int vert) {
-    const auto mesh = static_cast<Mesh*>(context->m_pUserData);
+        void resize(const std::size_t count) {
+            x.resize(count);
+            y.resize(count);
+            z.resize(count);
+        }
+    };
 
-    const std::uint32_t index  = mesh->getIndices()[face * 3 + vert];
-    Vertex&             vertex = mesh->getVertices()[index];
+    // A face is only read when its three indices lie within the vertex range being processed
+    bool isFaceInRange(
+        const std::vector<std::uint32_t>& indices,
+        const std::size_t                 i,
+        const std::size_t                 vertexStart,
+        const std::size_t                 vertexEnd
+    ) {
+        for (std::size_t corner = 0; corner < 3; corner++) {
+            if (indices[i + corner] < vertexStart || indices[i + corner] >= vertexEnd) return false;
+        }
 
-    return vertex;
-}
+        return true;
+    }
 
-void getPosition(const SMikkTSpaceContext* context, float out[3], const int face, const int vert) {
-    const Vertex& vertex = getVertex(context, face, vert);
+    // Computes normalize(cross(p1 - p0, p2 - p0)) with the same operation order as glm to keep results identical
+    // Out of range faces are left unread, their normals are garbage and must be skipped by the caller
+    void computeFaceNormals(
+        const std::vector<Vertex>&        vertices,
+        const std::vector<std::uint32_t>& indices,
+        const std::size_t                 vertexStart,
+        const std::size_t                 vertexEnd,
+        const std::size_t                 indexStart,
+        const std::size_t                 faceBegin,
+        const std::size_t                 faceEnd,
+        FaceNormals&                      faceNormals
+    ) {
+        std::size_t face = faceBegin;
 
-    out[0] = vertex.position.x;
-    out[1] = vertex.position.y;
-    out[2] = vertex.position.z;
-}
+#if defined(NOBLE_SIMD_SSE)
+        alignas(16) float p0[3][4], p1[3][4], p2[3][4];
 
-void getNormal(const SMikkTSpaceContext* context, float out[3], const int face, const int vert) {
-    const Vertex& vertex = getVertex(context, face, vert);
+        for (; face + 4 <= faceEnd; face += 4) {
+            // Gather 4 triangles into SoA lanes
+            for (std::size_t lane = 0; lane < 4; lane++) {
+                const std::size_t i = indexStart + (face + lane) * 3;
 
-    out[0] = vertex.normal.x;
-    out[1] = vertex.normal.y;
-    out[2] = vertex.normal.z;
-}
+                if (!isFaceInRange(indices, i, vertexStart, vertexEnd)) {
+                    for (int axis = 0; axis < 3; axis++) {
+                        p0[axis][lane] = p1[axis][lane] = p2[axis][lane] = 0.0f;
+                    }
 
-void getTextureCoords(const SMikkTSpaceContext* context, float out[2], const int face, const int vert) {
-    const Vertex& vertex = getVertex(context, face, vert);
+                    continue;
+                }
 
-    out[0] = vertex.textureCoords.x;
-    out[1] = vertex.textureCoords.y;
-}
+                const glm::vec3& v0 = vertices[indices[i + 0]].position;
+                const glm::vec3& v1 = vertices[indices[i + 1]].position;
+                const glm::vec3& v2 = vertices[indices[i + 2]].position;
 
-void setTangent(
-    const SMikkTSpaceContext* context, const float tangent[3], const float sign, const int face, const int vert
-) {
-    Vertex& vertex = getVertex(context, face, vert);
-    vertex.tangent = glm::vec4(tangent[0], tangent[1], tangent[2], sign);
+                for (int axis = 0; axis < 3; axis++) {
+                    p0[axis][lane] = v0[axis];
+                    p1[axis][lane] = v1[axis];
+                    p2[axis][lane] = v2[axis];
+                }
+            }
+
+            const __m128 p0x = _mm_load_ps(p0[0]);
+            const __m128 p0y = _mm_load_ps(p0[1]);
+            const __m128 p0z = _mm_load_ps(p0[2]);
+
+            const __m128 e1x = _mm_sub_ps(_mm_load_ps(p1[0]), p0x);
+            const __m128 e1y = _mm_sub_ps(_mm_load_ps(p1[1]), p0y);
+            const __m128 e1z = _mm_sub_ps(_mm_load_ps(p1[2]), p0z);
+
+            const __m128 e2x = _mm_sub_ps(_mm_load_ps(p2[0]), p0x);
+            const __m128 e2y = _mm_sub_ps(_mm_load_ps(p2[1]), p0y);
+            const __m128 e2z = _mm_sub_ps(_mm_load_ps(p2[2]), p0z);
+
+            const __m128 cx = _mm_sub_ps(_mm_mul_ps(e1y, e2z), _mm_mul_ps(e2y, e1z));
+            const __m128 cy = _mm_sub_ps(_mm_mul_ps(e1z, e2x), _mm_mul_ps(e2z, e1x));
+            const __m128 cz = _mm_sub_ps(_mm_mul_ps(e1x, e2y), _mm_mul_ps(e2x, e1y));
+
+            const __m128 lengthSquared = _mm_add_ps(
+                _mm_add_ps(_mm_mul_ps(cx, cx), _mm_mul_ps(cy, cy)), _mm_mul_ps(cz, cz)
+            );
+            const __m128 inverseLength = _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(lengthSquared));
+
+            _mm_storeu_ps(&faceNormals.x[face], _mm_mul_ps(cx, inverseLength));
+            _mm_storeu_ps(&faceNormals.y[face], _mm_mul_ps(cy, inverseLength));
+            _mm_storeu_ps(&faceNormals.z[face], _mm_mul_ps(cz, inverseLength));
+        }
+#endif
+
+        // Scalar tail (or fallback)
+        for (; face < faceEnd; face++) {
+            const std::size_t i = indexStart + face * 3;
+
+            if (!isFaceInRange(indices, i, vertexStart, vertexEnd)) continue;
+
+            const glm::vec3& v0 = vertices[indices[i + 0]].position;
+            const glm::vec3& v1 = vertices[indices[i + 1]].position;
+            const glm::vec3& v2 = vertices[indices[i + 2]].position;
+
+            const glm::vec3 faceNormal = glm::normalize(glm::cross(v1 - v0, v2 - v0));
+
+            faceNormals.x[face] = faceNormal.x;
+            faceNormals.y[face] = faceNormal.y;
+            faceNormals.z[face] = faceNormal.z;
+        }
+    }
+
+    // SoA per-corner streams, mikktspace callbacks become flat array reads
+    struct TangentScratch {
+        std::vector<float> positionX, positionY, positionZ;
+        std::vector<float> normalX, normalY, normalZ;
+        std::vector<float> u, v;
+
+        std::vector<glm::vec4> tangents;
+
+        void resize(const std::size_t cornerCount) {
+            positionX.resize(cornerCount);
+            positionY.resize(cornerCount);
+            positionZ.resize(cornerCount);
+            normalX.resize(cornerCount);
+            normalY.resize(cornerCount);
+            normalZ.resize(cornerCount);
+            u.resize(cornerCount);
+            v.resize(cornerCount);
+
+            tangents.resize(cornerCount);
+        }
+    };
+
+    std::size_t getCorner(const int face, const int vert) {
+        return static_cast<std::size_t>(face) * 3 + static_cast<std::size_t>(vert);
+    }
+
+    const TangentScratch& getScratch(const SMikkTSpaceContext* context) {
+        return *static_cast<const TangentScratch*>(context->m_pUserData);
+    }
+
+    int getNumFaces(const SMikkTSpaceContext* context) {
+        return static_cast<int>(getScratch(context).u.size() / 3);
+    }
+
+    int getNumFaceVertices(const SMikkTSpaceContext*, int) {
+        return 3;
+    }
+
+    void getPosition(const SMikkTSpaceContext* context, float out[3], const int face, const int vert) {
+        const TangentScratch& scratch = getScratch(context);
+        const std::size_t     corner  = getCorner(face, vert);
+
+        out[0] = scratch.positionX[corner];
+        out[1] = scratch.positionY[corner];
+        out[2] = scratch.positionZ[corner];
+    }
+
+    void getNormal(const SMikkTSpaceContext* context, float out[3], const int face, const int vert) {
+        const TangentScratch& scratch = getScratch(context);
+        const std::size_t     corner  = getCorner(face, vert);
+
+        out[0] = scratch.normalX[corner];
+        out[1] = scratch.normalY[corner];
+        out[2] = scratch.normalZ[corner];
+    }
+
+    void getTextureCoords(const SMikkTSpaceContext* context, float out[2], const int face, const int vert) {
+        const TangentScratch& scratch = getScratch(context);
+        const std::size_t     corner  = getCorner(face, vert);
+
+        out[0] = scratch.u[corner];
+        out[1] = scratch.v[corner];
+    }
+
+    void setTangent(
+        const SMikkTSpaceContext* context, const float tangent[3], const float sign, const int face, const int vert
+    ) {
+        auto* scratch = static_cast<TangentScratch*>(context->m_pUserData);
+        scratch->tangents[getCorner(face, vert)] = glm::vec4(tangent[0], tangent[1], tangent[2], sign);
+    }
 }
 
 void Mesh::generateTangents() {
+    const std::size_t cornerCount = _indices.size() - _indices.size() % 3;
+    if (cornerCount == 0) return;
+
+    TangentScratch scratch{};
+    scratch.resize(cornerCount);
+
+    // Gather indexed vertex attributes into flat corner streams
+    const auto gatherCorners = [this, &scratch](const std::size_t begin, const std::size_t end) {
+        for (std::size_t corner = begin; corner < end; corner++) {
+            const Vertex& vertex = _vertices[_indices[corner]];
+
+            scratch.positionX[corner] = vertex.position.x;
+            scratch.positionY[corner] = vertex.position.y;
+            scratch.positionZ[corner] = vertex.position.z;
+            scratch.normalX[corner]   = vertex.normal.x;
+            scratch.normalY[corner]   = vertex.normal.y;
+            scratch.normalZ[corner]   = vertex.normal.z;
+            scratch.u[corner]         = vertex.textureCoords.x;
+            scratch.v[corner]         = vertex.textureCoords.y;
+        }
+    };
+
+    ParallelFor::forEachRange(cornerCount, PARALLEL_GRAIN, gatherCorners);
+
     SMikkTSpaceInterface mikkt{};
     mikkt.m_getNumFaces          = getNumFaces;
     mikkt.m_getNumVerticesOfFace = getNumFaceVertices;
@@ -63,9 +232,15 @@ void Mesh::generateTangents() {
 
     SMikkTSpaceContext context{};
     context.m_pInterface = &mikkt;
-    context.m_pUserData  = this;
+    context.m_pUserData  = &scratch;
+
+    // mikktspace welds across the whole mesh, it runs on a single thread to keep its output unchanged
+    if (!genTangSpaceDefault(&context)) return;
 
-    genTangSpaceDefault(&context);
+    // Scatter in corner order, shared vertices keep the last written tangent like the per-corner callback did
+    for (std::size_t corner = 0; corner < cornerCount; corner++) {
+        _vertices[_indices[corner]].tangent = scratch.tangents[corner];
+    }
 }
 
 void Mesh::generateSmoothNormals(
@@ -74,30 +249,61 @@ void Mesh::generateSmoothNormals(
     const std::size_t indexStart,
     const std::size_t indexEnd
 ) {
-    for (std::size_t i = indexStart; i < indexEnd; i += 3) {
+    const std::size_t faceCount = (indexEnd - indexStart) / 3;
+
+    FaceNormals faceNormals{};
+    faceNormals.resize(faceCount);
+
+    // Face normals are independent, compute them in parallel
+    ParallelFor::forEachRange(faceCount, PARALLEL_GRAIN, [&](const std::size_t begin, const std::size_t end) {
+        computeFaceNormals(_vertices, _indices, vertexStart, vertexEnd, indexStart, begin, end, faceNormals);
+    });
+
+    // Accumulate in face order so that the summation order per vertex stays deterministic
+    for (std::size_t face = 0; face < faceCount; face++) {
+        const std::size_t i = indexStart + face * 3;
+
+        if (!isFaceInRange(_indices, i, vertexStart, vertexEnd)) continue;
+
         const std::uint32_t i0 = _indices[i + 0];
         const std::uint32_t i1 = _indices[i + 1];
         const std::uint32_t i2 = _indices[i + 2];
 
-        if (i0 < vertexStart || i0 >= vertexEnd) continue;
-        if (i1 < vertexStart || i1 >= vertexEnd) continue;
-        if (i2 < vertexStart || i2 >= vertexEnd) continue;
-
-        const glm::vec3 edge1 = _vertices[i1].position - _vertices[i0].position;
-        const glm::vec3 edge2 = _vertices[i2].position - _vertices[i0].position;
-
-        const glm::vec3 faceNormal = glm::normalize(glm::cross(edge1, edge2));
+        const glm::vec3 faceNormal(faceNormals.x[face], faceNormals.y[face], faceNormals.z[face]);
 
         _vertices[i0].normal += faceNormal;
         _vertices[i1].normal += faceNormal;
         _vertices[i2].normal += faceNormal;
     }
 
-    for (std::size_t i = vertexStart; i < vertexEnd; i++) {
-        _vertices[i].normal = glm::normalize(_vertices[i].normal);
-    }
+    const auto normalizeVertices = [&](const std::size_t begin, const std::size_t end) {
+        for (std::size_t i = vertexStart + begin; i < vertexStart + end; i++) {
+            _vertices[i].normal = glm::normalize(_vertices[i].normal);
+        }
+    };
+
+    ParallelFor::forEachRange(vertexEnd - vertexStart, PARALLEL_GRAIN, normalizeVertices);
 }
 
 void Mesh::generateSmoothNormals() {
     generateSmoothNormals(0, _vertices.size(), 0, _indices.size());
 }
+
+void Mesh::optimizeVertexFetch() {
+    static constexpr std::uint32_t UNASSIGNED = UINT32_MAX;
+
+    std::vector<std::uint32_t> remap(_vertices.size(), UNASSIGNED);
+    std::vector<Vertex>        vertices;
+    vertices.reserve(_vertices.size());
+
+    for (std::uint32_t& index : _indices) {
+        if (remap[index] == UNASSIGNED) {
+            remap[index] = static_cast<std::uint32_t>(vertices.size());
+            vertices.push_back(_vertices[index]);
+        }
+
+        index = remap[index];
+    }
+
+    _vertices = std::move(vertices);
+}
@@ -33,6 +33,9 @@ public:
     // Generates tangents for the entire mesh
     void generateTangents();
 
+    // Reorders vertices by first use in the index buffer to improve vertex fetch locality, drops unused vertices
+    void optimizeVertexFetch();
+
     [[nodiscard]]       std::vector<Vertex>& getVertices()       noexcept { return _vertices; }
     [[nodiscard]] const std::vector<Vertex>& getVertices() const noexcept { return _vertices; }
 
@@ -46,6 +49,9 @@ public:
 
     [[nodiscard]] const Material& getMaterial() const noexcept { return _material; }
 
+    // Forces the mesh to be used as an occluder by the CPU occlusion culling, set from the glTF mesh extras
+    [[nodiscard]] bool isOccluder() const noexcept { return _occluder; }
+
     void addVertex(const Vertex& vertex) { _vertices.push_back(vertex); }
     void addIndex(const std::uint32_t index) { _indices.push_back(index); }
 
@@ -58,6 +64,8 @@ public:
 
     void setMaterial(const Material& material) noexcept { _material = material; }
 
+    void setOccluder(const bool occluder) noexcept { _occluder = occluder; }
+
 protected:
     std::vector<Vertex>        _vertices{};
     std::vector<std::uint32_t> _indices{};
@@ -65,6 +73,8 @@ protected:
     Math::AABB _aabb{};
 
     Material _material{};
+
+    bool _occluder = false;
 };
 
 struct MeshHash {
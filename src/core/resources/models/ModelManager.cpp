@@ -4,6 +4,10 @@
 
 #include "core/debug/Logger.h"
 #include "core/resources/AssetPaths.h"
+#include "core/resources/cache/AssetCache.h"
+#include "core/resources/models/ObjParser.h"
+
+#include <cstdlib>
 
 #include <glm/gtc/type_ptr.hpp>
 
@@ -13,6 +17,13 @@ ModelManager::ResourceHandlePointer ModelManager::load(const std::string& path)
 
         Logger::info("Loading model \"" + path + "\"...");
 
+        // A baked cache matching the source skips parsing and mesh processing
+        if (std::optional<Model> cached = AssetCache::findModel(path)) {
+            Logger::verbose("Loaded model \"" + path + "\" from its baked cache");
+
+            return Expected(std::make_unique<Model>(std::move(*cached)));
+        }
+
         // Load model
         auto model = std::make_unique<Model>();
 
@@ -85,6 +96,13 @@ void ModelManager::loadMaterial_OBJ(Mesh& mesh, const std::string& modelName, co
     meshMaterial.metallic  = material.metallic;
     meshMaterial.roughness = material.roughness;
 
+    meshMaterial.hasTransparency = material.dissolve < 1.0f || !material.alpha_texname.empty();
+
+    if (const auto maxDrawDistance = material.unknown_parameter.find("max_draw_distance");
+        maxDrawDistance != material.unknown_parameter.end()) {
+        meshMaterial.maxDrawDistance = std::strtof(maxDrawDistance->second.c_str(), nullptr);
+    }
+
     mesh.setMaterial(meshMaterial);
 }
 
@@ -191,13 +209,7 @@ Expected<void> ModelManager::load_OBJ(Model& model, const std::string& path) {
     std::vector<tinyobj::shape_t>    shapes;
     std::vector<tinyobj::material_t> materials;
 
-    std::string errorMessage;
-
-    if (!tinyobj::LoadObj(
-        &attributes, &shapes, &materials, &errorMessage, path.c_str(), AssetPaths::MODELS
-    )) {
-        return FAIL(errorMessage, "ModelManager");
-    }
+    TRY(ObjParser::load(path, AssetPaths::MODELS, attributes, shapes, materials));
 
     for (int materialIndex = -1; materialIndex < static_cast<int>(materials.size()); materialIndex++) {
         tinyobj::material_t material{};
@@ -266,11 +278,30 @@ void ModelManager::loadMaterial_glTF(
     meshMaterial.metallic  = material.pbrMetallicRoughness.metallicFactor;
     meshMaterial.roughness = material.pbrMetallicRoughness.roughnessFactor;
 
+    meshMaterial.hasTransparency = material.alphaMode == "MASK" || material.alphaMode == "BLEND";
+
+    if (material.extras.Has("maxDrawDistance")) {
+        const tinygltf::Value& maxDrawDistance = material.extras.Get("maxDrawDistance");
+
+        if (maxDrawDistance.IsNumber()) {
+            meshMaterial.maxDrawDistance = static_cast<float>(maxDrawDistance.GetNumberAsDouble());
+        }
+    }
+
     mesh.setMaterial(meshMaterial);
 }
 
 // ------ Model ------
 
+// Meshes can force their use as occluders through an "occluder" boolean in their extras
+static bool hasOccluderFlag(const tinygltf::Mesh& glTFMesh) {
+    if (!glTFMesh.extras.Has("occluder")) return false;
+
+    const tinygltf::Value& occluder = glTFMesh.extras.Get("occluder");
+
+    return occluder.IsBool() && occluder.Get<bool>();
+}
+
 struct AttributeData {
     const tinygltf::Accessor* accessor;
     const unsigned char* base;
@@ -462,6 +493,7 @@ void ModelManager::processNode_glTF(
         // For each primitive that forms the mesh
         for (const auto& glTFPrimitive : glTFMesh.primitives) {
             Mesh mesh = createMesh_glTF(model.name, glTFModel, glTFPrimitive);
+            mesh.setOccluder(hasOccluderFlag(glTFMesh));
 
             Math::AABB aabb{};
 
@@ -540,6 +572,7 @@ Expected<void> ModelManager::load_glTF(Model& model, const std::string& path, co
         // For each primitive that forms the mesh
         for (const auto& glTFPrimitive : glTFMesh.primitives) {
             Mesh mesh = createMesh_glTF(model.name, glTFModel, glTFPrimitive);
+            mesh.setOccluder(hasOccluderFlag(glTFMesh));
 
             if (!mesh.getVertices().empty()) {
                 // Progressively find the bounds of the mesh
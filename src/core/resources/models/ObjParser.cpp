@@ -0,0 +1,780 @@
+#include "ObjParser.h"
+
+#include "core/debug/Logger.h"
+#include "core/multithreading/ParallelFor.h"
+#include "core/platform/MappedFile.h"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstring>
+
+namespace {
+    // Files are split in chunks of at least this size, smaller files are parsed on the calling thread
+    constexpr std::size_t MIN_CHUNK_SIZE = 1 << 20;
+
+    constexpr std::uint8_t RELATIVE_POSITION = 1 << 0;
+    constexpr std::uint8_t RELATIVE_TEXCOORD = 1 << 1;
+    constexpr std::uint8_t RELATIVE_NORMAL   = 1 << 2;
+
+    /*---------------------------------------*/
+    /*               Tokenizer               */
+    /*---------------------------------------*/
+
+    bool isSpace(const char c) {
+        return c == ' ' || c == '\t' || c == '\r';
+    }
+
+    void skipSpaces(const char*& p, const char* end) {
+        while (p < end && isSpace(*p)) p++;
+    }
+
+    std::string_view parseToken(const char*& p, const char* end) {
+        skipSpaces(p, end);
+
+        const char* begin = p;
+        while (p < end && !isSpace(*p)) p++;
+
+        return {begin, static_cast<std::size_t>(p - begin)};
+    }
+
+    std::string_view parseRemaining(const char*& p, const char* end) {
+        skipSpaces(p, end);
+
+        const char* last = end;
+        while (last > p && isSpace(last[-1])) last--;
+
+        const std::string_view remaining(p, static_cast<std::size_t>(last - p));
+        p = end;
+
+        return remaining;
+    }
+
+    bool parseFloat(const char*& p, const char* end, float& value) {
+        skipSpaces(p, end);
+        if (p < end && *p == '+') p++;
+
+        const auto [next, error] = std::from_chars(p, end, value);
+        if (error != std::errc{}) return false;
+
+        p = next;
+        return true;
+    }
+
+    bool parseInt(const char*& p, const char* end, int& value) {
+        if (p < end && *p == '+') p++;
+
+        const auto [next, error] = std::from_chars(p, end, value);
+        if (error != std::errc{}) return false;
+
+        p = next;
+        return true;
+    }
+
+    void parseFloats(const char*& p, const char* end, float* values, const std::size_t count) {
+        for (std::size_t i = 0; i < count; i++) {
+            if (!parseFloat(p, end, values[i])) values[i] = 0.0f;
+        }
+    }
+
+    bool isNumber(const std::string_view token) {
+        float value = 0.0f;
+
+        const char* begin = token.data();
+        const char* end   = token.data() + token.size();
+        if (begin < end && *begin == '+') begin++;
+
+        const auto [next, error] = std::from_chars(begin, end, value);
+        return error == std::errc{} && next == end;
+    }
+
+    // Matches a keyword followed by whitespace and advances past it
+    bool matchKeyword(const char*& p, const char* end, const std::string_view keyword) {
+        const std::size_t length = keyword.size();
+
+        if (static_cast<std::size_t>(end - p) <= length) return false;
+        if (std::memcmp(p, keyword.data(), length) != 0 || !isSpace(p[length])) return false;
+
+        p += length + 1;
+        return true;
+    }
+
+    // Calls function(lineBegin, lineEnd) for each non-empty, non-comment line, leading spaces and '\r' stripped
+    template<typename Function>
+    void forEachLine(const std::string_view content, const Function& function) {
+        const char* lineBegin = content.data();
+        const char* end       = content.data() + content.size();
+
+        while (lineBegin < end) {
+            const auto* newline = static_cast<const char*>(
+                std::memchr(lineBegin, '\n', static_cast<std::size_t>(end - lineBegin))
+            );
+
+            const char* lineEnd  = newline ? newline : end;
+            const char* nextLine = newline ? newline + 1 : end;
+
+            if (lineEnd > lineBegin && lineEnd[-1] == '\r') lineEnd--;
+
+            const char* p = lineBegin;
+            skipSpaces(p, lineEnd);
+
+            if (p < lineEnd && *p != '#') {
+                function(p, lineEnd);
+            }
+
+            lineBegin = nextLine;
+        }
+    }
+
+    // Splits content in at most chunkCount ranges, each ending on a line boundary
+    std::vector<std::string_view> splitLineAligned(const std::string_view content, const std::size_t chunkCount) {
+        std::vector<std::string_view> chunks;
+        chunks.reserve(chunkCount);
+
+        const std::size_t targetSize = content.size() / chunkCount + 1;
+
+        std::size_t begin = 0;
+        while (begin < content.size()) {
+            std::size_t end = std::min(begin + targetSize, content.size());
+
+            if (end < content.size()) {
+                const std::size_t newline = content.find('\n', end - 1);
+                end = newline == std::string_view::npos ? content.size() : newline + 1;
+            }
+
+            chunks.push_back(content.substr(begin, end - begin));
+            begin = end;
+        }
+
+        return chunks;
+    }
+
+    /*---------------------------------------*/
+    /*             .OBJ chunks               */
+    /*---------------------------------------*/
+
+    // Order-dependent statements, replayed serially once all chunks are parsed
+    struct ObjStatement {
+        enum class Type : std::uint8_t { Object, Group, UseMaterial, MaterialLibrary };
+
+        Type        type;
+        std::size_t cornerOffset;
+        std::string value;
+    };
+
+    struct ObjCorner {
+        tinyobj::index_t index{-1, -1, -1};
+        std::uint8_t     relativeFlags = 0;
+    };
+
+    struct ObjChunk {
+        std::vector<float> positions{};
+        std::vector<float> normals{};
+        std::vector<float> texcoords{};
+
+        // Triangulated face corners, negative OBJ indices are kept relative to the chunk until merged
+        std::vector<tinyobj::index_t> corners{};
+        std::vector<std::uint8_t>     relativeFlags{};
+        bool                          hasRelativeIndices = false;
+
+        // Set on a zero face index, the file is rejected like tinyobjloader does
+        bool hasInvalidIndex = false;
+
+        std::vector<ObjStatement> statements{};
+
+        void pushCorner(const ObjCorner& corner) {
+            if (corner.relativeFlags != 0 && !hasRelativeIndices) {
+                relativeFlags.assign(corners.size(), 0);
+                hasRelativeIndices = true;
+            }
+
+            corners.push_back(corner.index);
+
+            if (hasRelativeIndices) {
+                relativeFlags.push_back(corner.relativeFlags);
+            }
+        }
+    };
+
+    // Positive indices are 1-based and absolute, negative ones are relative to the attributes parsed so far
+    // Returns false on the invalid index 0
+    bool resolveIndex(
+        const int          index,
+        const std::size_t  localCount,
+        std::uint8_t&      relativeFlags,
+        const std::uint8_t flag,
+        int&               resolved
+    ) {
+        if (index == 0) return false;
+
+        if (index > 0) {
+            resolved = index - 1;
+            return true;
+        }
+
+        relativeFlags |= flag;
+        resolved = static_cast<int>(localCount) + index;
+        return true;
+    }
+
+    // Parses v, v/vt, v//vn or v/vt/vn, flags the chunk on a zero index
+    bool parseCorner(const char*& p, const char* end, ObjChunk& chunk, ObjCorner& corner) {
+        corner = {};
+
+        int value = 0;
+
+        if (!parseInt(p, end, value)) return false;
+
+        if (!resolveIndex(
+            value, chunk.positions.size() / 3, corner.relativeFlags, RELATIVE_POSITION, corner.index.vertex_index
+        )) {
+            chunk.hasInvalidIndex = true;
+            return false;
+        }
+
+        if (p < end && *p == '/') {
+            p++;
+
+            if (p < end && *p != '/' && parseInt(p, end, value)) {
+                if (!resolveIndex(
+                    value, chunk.texcoords.size() / 2, corner.relativeFlags, RELATIVE_TEXCOORD,
+                    corner.index.texcoord_index
+                )) {
+                    chunk.hasInvalidIndex = true;
+                    return false;
+                }
+            }
+
+            if (p < end && *p == '/') {
+                p++;
+
+                if (parseInt(p, end, value)) {
+                    if (!resolveIndex(
+                        value, chunk.normals.size() / 3, corner.relativeFlags, RELATIVE_NORMAL,
+                        corner.index.normal_index
+                    )) {
+                        chunk.hasInvalidIndex = true;
+                        return false;
+                    }
+                }
+            }
+        }
+
+        // Skip anything left in the token
+        while (p < end && !isSpace(*p)) p++;
+
+        return true;
+    }
+
+    void parseObjChunk(const std::string_view content, ObjChunk& chunk) {
+        // Rough upper bounds to limit reallocations, most lines are attributes or triangles of ~30 bytes
+        const std::size_t estimatedLines = content.size() / 32;
+        chunk.positions.reserve(estimatedLines * 3 / 2);
+        chunk.corners.reserve(estimatedLines * 3 / 2);
+
+        std::vector<ObjCorner> polygon;
+        polygon.reserve(8);
+
+        forEachLine(content, [&](const char* p, const char* end) {
+            switch (*p) {
+                case 'v': {
+                    std::array<float, 3> values{};
+
+                    if (matchKeyword(p, end, "v")) {
+                        parseFloats(p, end, values.data(), 3);
+                        chunk.positions.insert(chunk.positions.end(), values.begin(), values.end());
+
+                    } else if (matchKeyword(p, end, "vn")) {
+                        parseFloats(p, end, values.data(), 3);
+                        chunk.normals.insert(chunk.normals.end(), values.begin(), values.end());
+
+                    } else if (matchKeyword(p, end, "vt")) {
+                        parseFloats(p, end, values.data(), 2);
+                        chunk.texcoords.insert(chunk.texcoords.end(), values.begin(), values.begin() + 2);
+                    }
+                    break;
+                }
+
+                case 'f': {
+                    if (!matchKeyword(p, end, "f")) break;
+
+                    polygon.clear();
+
+                    ObjCorner corner{};
+                    while (true) {
+                        skipSpaces(p, end);
+                        if (p >= end || !parseCorner(p, end, chunk, corner)) break;
+
+                        polygon.push_back(corner);
+                    }
+
+                    // Polygon to triangle fan, same winding as tinyobjloader
+                    for (std::size_t k = 2; k < polygon.size(); k++) {
+                        chunk.pushCorner(polygon[0]);
+                        chunk.pushCorner(polygon[k - 1]);
+                        chunk.pushCorner(polygon[k]);
+                    }
+                    break;
+                }
+
+                case 'u': {
+                    if (matchKeyword(p, end, "usemtl")) {
+                        chunk.statements.push_back({
+                            ObjStatement::Type::UseMaterial, chunk.corners.size(), std::string(parseToken(p, end))
+                        });
+                    }
+                    break;
+                }
+
+                case 'm': {
+                    if (matchKeyword(p, end, "mtllib")) {
+                        chunk.statements.push_back({
+                            ObjStatement::Type::MaterialLibrary,
+                            chunk.corners.size(),
+                            std::string(parseRemaining(p, end))
+                        });
+                    }
+                    break;
+                }
+
+                case 'g': {
+                    if (matchKeyword(p, end, "g")) {
+                        chunk.statements.push_back({
+                            ObjStatement::Type::Group, chunk.corners.size(), std::string(parseToken(p, end))
+                        });
+                    }
+                    break;
+                }
+
+                case 'o': {
+                    if (matchKeyword(p, end, "o")) {
+                        chunk.statements.push_back({
+                            ObjStatement::Type::Object, chunk.corners.size(), std::string(parseToken(p, end))
+                        });
+                    }
+                    break;
+                }
+
+                default:
+                    break;
+            }
+        });
+    }
+
+    /*---------------------------------------*/
+    /*                Shapes                 */
+    /*---------------------------------------*/
+
+    struct ShapeSegment {
+        std::size_t begin;
+        std::size_t end;
+        int         materialId;
+    };
+
+    struct ShapeBuild {
+        std::string               name{};
+        std::vector<ShapeSegment> segments{};
+    };
+
+    void buildShape(const ShapeBuild& build, const std::vector<tinyobj::index_t>& corners, tinyobj::shape_t& shape) {
+        shape.name = build.name;
+
+        std::size_t cornerCount = 0;
+        for (const auto& segment : build.segments) {
+            cornerCount += segment.end - segment.begin;
+        }
+
+        tinyobj::mesh_t& mesh = shape.mesh;
+        mesh.indices.reserve(cornerCount);
+        mesh.num_face_vertices.reserve(cornerCount / 3);
+        mesh.material_ids.reserve(cornerCount / 3);
+
+        for (const auto& [begin, end, materialId] : build.segments) {
+            const auto cornersBegin = corners.begin() + static_cast<std::ptrdiff_t>(begin);
+            const auto cornersEnd   = corners.begin() + static_cast<std::ptrdiff_t>(end);
+
+            mesh.indices.insert(mesh.indices.end(), cornersBegin, cornersEnd);
+            mesh.num_face_vertices.insert(mesh.num_face_vertices.end(), (end - begin) / 3, 3);
+            mesh.material_ids.insert(mesh.material_ids.end(), (end - begin) / 3, materialId);
+        }
+    }
+
+    /*---------------------------------------*/
+    /*               Materials               */
+    /*---------------------------------------*/
+
+    void initMaterial(tinyobj::material_t& material) {
+        material = tinyobj::material_t{};
+
+        material.dissolve  = 1.0f;
+        material.shininess = 1.0f;
+        material.ior       = 1.0f;
+    }
+
+    // Texture statements may carry options (-bm 1.0, -s 1 1 1, ...), the file name is the non-option token
+    std::string parseTextureName(const char* p, const char* end) {
+        struct TextureOption {
+            std::string_view name;
+            std::size_t      maxArguments;
+            bool             numericArguments;
+        };
+
+        static constexpr std::array<TextureOption, 13> options{{
+            {"-blendu", 1, false}, {"-blendv", 1, false}, {"-clamp", 1, false}, {"-cc",      1, false},
+            {"-boost",  1, true }, {"-bm",     1, true }, {"-texres", 1, true}, {"-o",       3, true },
+            {"-s",      3, true }, {"-t",      3, true }, {"-mm",    2, true }, {"-type",    1, false},
+            {"-imfchan", 1, false}
+        }};
+
+        std::string_view textureName;
+
+        while (true) {
+            const std::string_view token = parseToken(p, end);
+            if (token.empty()) break;
+
+            const auto option = std::ranges::find(options, token, &TextureOption::name);
+
+            if (option == options.end()) {
+                textureName = token;
+                continue;
+            }
+
+            // Skip option arguments
+            for (std::size_t i = 0; i < option->maxArguments; i++) {
+                const char*            next     = p;
+                const std::string_view argument = parseToken(next, end);
+
+                if (argument.empty() || (option->numericArguments && !isNumber(argument))) break;
+
+                p = next;
+            }
+        }
+
+        return std::string(textureName);
+    }
+
+    void parseMaterialLine(const char* p, const char* end, tinyobj::material_t& material, bool& hasDissolve) {
+        // Colors
+        if (matchKeyword(p, end, "Ka")) { parseFloats(p, end, material.ambient, 3);       return; }
+        if (matchKeyword(p, end, "Kd")) { parseFloats(p, end, material.diffuse, 3);       return; }
+        if (matchKeyword(p, end, "Ks")) { parseFloats(p, end, material.specular, 3);      return; }
+        if (matchKeyword(p, end, "Ke")) { parseFloats(p, end, material.emission, 3);      return; }
+        if (matchKeyword(p, end, "Kt")) { parseFloats(p, end, material.transmittance, 3); return; }
+        if (matchKeyword(p, end, "Tf")) { parseFloats(p, end, material.transmittance, 3); return; }
+
+        // Scalars
+        if (matchKeyword(p, end, "Ni"))     { parseFloats(p, end, &material.ior, 1);                 return; }
+        if (matchKeyword(p, end, "Ns"))     { parseFloats(p, end, &material.shininess, 1);           return; }
+        if (matchKeyword(p, end, "Pr"))     { parseFloats(p, end, &material.roughness, 1);           return; }
+        if (matchKeyword(p, end, "Pm"))     { parseFloats(p, end, &material.metallic, 1);            return; }
+        if (matchKeyword(p, end, "Ps"))     { parseFloats(p, end, &material.sheen, 1);               return; }
+        if (matchKeyword(p, end, "Pc"))     { parseFloats(p, end, &material.clearcoat_thickness, 1); return; }
+        if (matchKeyword(p, end, "Pcr"))    { parseFloats(p, end, &material.clearcoat_roughness, 1); return; }
+        if (matchKeyword(p, end, "aniso"))  { parseFloats(p, end, &material.anisotropy, 1);          return; }
+        if (matchKeyword(p, end, "anisor")) { parseFloats(p, end, &material.anisotropy_rotation, 1); return; }
+
+        if (matchKeyword(p, end, "illum")) {
+            skipSpaces(p, end);
+            if (!parseInt(p, end, material.illum)) material.illum = 0;
+            return;
+        }
+
+        if (matchKeyword(p, end, "d")) {
+            parseFloats(p, end, &material.dissolve, 1);
+            hasDissolve = true;
+            return;
+        }
+
+        // Transparency, only used when no dissolve is given
+        if (matchKeyword(p, end, "Tr")) {
+            float transparency = 0.0f;
+            parseFloats(p, end, &transparency, 1);
+
+            if (!hasDissolve) material.dissolve = 1.0f - transparency;
+            return;
+        }
+
+        // Textures
+        static constexpr std::array<std::pair<std::string_view, std::string tinyobj::material_t::*>, 13> textures{{
+            {"map_Ka",   &tinyobj::material_t::ambient_texname},
+            {"map_Kd",   &tinyobj::material_t::diffuse_texname},
+            {"map_Ks",   &tinyobj::material_t::specular_texname},
+            {"map_Ns",   &tinyobj::material_t::specular_highlight_texname},
+            {"map_bump", &tinyobj::material_t::bump_texname},
+            {"bump",     &tinyobj::material_t::bump_texname},
+            {"map_d",    &tinyobj::material_t::alpha_texname},
+            {"disp",     &tinyobj::material_t::displacement_texname},
+            {"map_Pr",   &tinyobj::material_t::roughness_texname},
+            {"map_Pm",   &tinyobj::material_t::metallic_texname},
+            {"map_Ps",   &tinyobj::material_t::sheen_texname},
+            {"map_Ke",   &tinyobj::material_t::emissive_texname},
+            {"norm",     &tinyobj::material_t::normal_texname}
+        }};
+
+        for (const auto& [keyword, texture] : textures) {
+            if (matchKeyword(p, end, keyword)) {
+                material.*texture = parseTextureName(p, end);
+                return;
+            }
+        }
+
+        // Engine specific parameters, e.g. max_draw_distance
+        const std::string_view key = parseToken(p, end);
+        if (!key.empty()) material.unknown_parameter[std::string(key)] = std::string(parseRemaining(p, end));
+    }
+
+    void parseMaterialBlock(const std::string_view content, tinyobj::material_t& material) {
+        initMaterial(material);
+
+        bool hasDissolve = false;
+
+        forEachLine(content, [&](const char* p, const char* end) {
+            if (matchKeyword(p, end, "newmtl")) {
+                material.name = std::string(parseToken(p, end));
+                return;
+            }
+
+            parseMaterialLine(p, end, material, hasDissolve);
+        });
+    }
+}
+
+Expected<void> ObjParser::load(
+    const std::string&                path,
+    const std::string&                materialDirectory,
+    tinyobj::attrib_t&                attributes,
+    std::vector<tinyobj::shape_t>&    shapes,
+    std::vector<tinyobj::material_t>& materials
+) {
+    MappedFile file;
+    TRY(file.open(path));
+
+    const std::string_view content = file.view();
+
+    // Parse line-aligned chunks in parallel
+    const std::size_t chunkCount = std::clamp<std::size_t>(
+        content.size() / MIN_CHUNK_SIZE, 1, ParallelFor::getThreadCount() * 4
+    );
+
+    const std::vector<std::string_view> ranges = splitLineAligned(content, chunkCount);
+
+    std::vector<ObjChunk> chunks(ranges.size());
+
+    ParallelFor::forEachRange(ranges.size(), 1, [&](const std::size_t begin, const std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            parseObjChunk(ranges[i], chunks[i]);
+        }
+    });
+
+    if (std::ranges::any_of(chunks, [](const ObjChunk& chunk) { return chunk.hasInvalidIndex; })) {
+        return FAIL("Invalid face index 0 in OBJ file \"" + path + "\"", "ObjParser");
+    }
+
+    // Prefix sums give each chunk its offset in the merged arrays
+    struct ChunkOffsets {
+        std::size_t positions = 0;
+        std::size_t normals   = 0;
+        std::size_t texcoords = 0;
+        std::size_t corners   = 0;
+    };
+
+    std::vector<ChunkOffsets> offsets(chunks.size() + 1);
+
+    for (std::size_t i = 0; i < chunks.size(); i++) {
+        offsets[i + 1].positions = offsets[i].positions + chunks[i].positions.size();
+        offsets[i + 1].normals   = offsets[i].normals   + chunks[i].normals.size();
+        offsets[i + 1].texcoords = offsets[i].texcoords + chunks[i].texcoords.size();
+        offsets[i + 1].corners   = offsets[i].corners   + chunks[i].corners.size();
+    }
+
+    const ChunkOffsets& totals = offsets.back();
+
+    attributes.vertices.resize(totals.positions);
+    attributes.normals.resize(totals.normals);
+    attributes.texcoords.resize(totals.texcoords);
+
+    std::vector<tinyobj::index_t> corners(totals.corners);
+
+    // Merge chunks in parallel, relative indices are rebased on the attributes of preceding chunks
+    ParallelFor::forEachRange(chunks.size(), 1, [&](const std::size_t begin, const std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            const ObjChunk&     chunk  = chunks[i];
+            const ChunkOffsets& offset = offsets[i];
+
+            std::ranges::copy(chunk.positions, attributes.vertices.data()  + offset.positions);
+            std::ranges::copy(chunk.normals,   attributes.normals.data()   + offset.normals);
+            std::ranges::copy(chunk.texcoords, attributes.texcoords.data() + offset.texcoords);
+
+            tinyobj::index_t* chunkCorners = corners.data() + offset.corners;
+            std::ranges::copy(chunk.corners, chunkCorners);
+
+            if (!chunk.hasRelativeIndices) continue;
+
+            const int positionBase = static_cast<int>(offset.positions / 3);
+            const int texcoordBase = static_cast<int>(offset.texcoords / 2);
+            const int normalBase   = static_cast<int>(offset.normals   / 3);
+
+            for (std::size_t corner = 0; corner < chunk.corners.size(); corner++) {
+                const std::uint8_t flags = chunk.relativeFlags[corner];
+
+                if (flags & RELATIVE_POSITION) chunkCorners[corner].vertex_index   += positionBase;
+                if (flags & RELATIVE_TEXCOORD) chunkCorners[corner].texcoord_index += texcoordBase;
+                if (flags & RELATIVE_NORMAL)   chunkCorners[corner].normal_index   += normalBase;
+            }
+        }
+    });
+
+    // Replay order-dependent statements to split faces into shapes and material groups
+    MaterialMap materialMap;
+
+    std::vector<ShapeBuild> shapeBuilds;
+    ShapeBuild              currentShape{};
+
+    int         currentMaterial = -1;
+    std::size_t groupBegin      = 0;
+
+    const auto flushGroup = [&](const std::size_t cornerOffset) {
+        if (cornerOffset > groupBegin) {
+            currentShape.segments.push_back({groupBegin, cornerOffset, currentMaterial});
+        }
+
+        groupBegin = cornerOffset;
+    };
+
+    const auto flushShape = [&] {
+        if (!currentShape.segments.empty()) {
+            shapeBuilds.push_back(std::move(currentShape));
+        }
+
+        currentShape = {};
+    };
+
+    for (std::size_t i = 0; i < chunks.size(); i++) {
+        for (const auto& [type, cornerOffset, value] : chunks[i].statements) {
+            const std::size_t globalOffset = offsets[i].corners + cornerOffset;
+
+            switch (type) {
+                case ObjStatement::Type::UseMaterial: {
+                    const auto material   = materialMap.find(value);
+                    const int  materialId = material != materialMap.end() ? material->second : -1;
+
+                    if (materialId != currentMaterial) {
+                        flushGroup(globalOffset);
+                        currentMaterial = materialId;
+                    }
+                    break;
+                }
+
+                case ObjStatement::Type::Group:
+                case ObjStatement::Type::Object: {
+                    flushGroup(globalOffset);
+                    flushShape();
+
+                    currentShape.name = value;
+                    break;
+                }
+
+                case ObjStatement::Type::MaterialLibrary: {
+                    // Several files may be listed, the first one that loads is used
+                    const char* p   = value.data();
+                    const char* end = value.data() + value.size();
+
+                    bool loaded = false;
+
+                    while (!loaded) {
+                        const std::string_view filename = parseToken(p, end);
+                        if (filename.empty()) break;
+
+                        loaded = static_cast<bool>(
+                            loadMaterials(materialDirectory + std::string(filename), materials, materialMap)
+                        );
+                    }
+
+                    if (!loaded) {
+                        Logger::warning("Failed to load material library \"" + value + "\", using default material");
+                    }
+                    break;
+                }
+            }
+        }
+    }
+
+    flushGroup(totals.corners);
+    flushShape();
+
+    // Build shapes in parallel, a single shape spanning every face takes the merged corners as is
+    shapes.resize(shapeBuilds.size());
+
+    if (shapeBuilds.size() == 1 && shapeBuilds.front().segments.size() == 1) {
+        const ShapeSegment& segment = shapeBuilds.front().segments.front();
+        const std::size_t   faces   = (segment.end - segment.begin) / 3;
+
+        if (segment.begin == 0 && segment.end == corners.size()) {
+            shapes.front().name = shapeBuilds.front().name;
+            shapes.front().mesh.indices = std::move(corners);
+            shapes.front().mesh.num_face_vertices.assign(faces, 3);
+            shapes.front().mesh.material_ids.assign(faces, segment.materialId);
+
+            return {};
+        }
+    }
+
+    ParallelFor::forEachRange(shapeBuilds.size(), 1, [&](const std::size_t begin, const std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            buildShape(shapeBuilds[i], corners, shapes[i]);
+        }
+    });
+
+    return {};
+}
+
+Expected<void> ObjParser::loadMaterials(
+    const std::string&                path,
+    std::vector<tinyobj::material_t>& materials,
+    MaterialMap&                      materialMap
+) {
+    MappedFile file;
+    TRY(file.open(path));
+
+    parseMaterials(file.view(), materials, materialMap);
+
+    return {};
+}
+
+void ObjParser::parseMaterials(
+    const std::string_view            content,
+    std::vector<tinyobj::material_t>& materials,
+    MaterialMap&                      materialMap
+) {
+    // Each newmtl statement starts an independent block, blocks are parsed in parallel
+    std::vector<std::string_view> blocks;
+
+    forEachLine(content, [&](const char* p, const char* end) {
+        if (!matchKeyword(p, end, "newmtl")) return;
+
+        const auto blockBegin = static_cast<std::size_t>(p - content.data()) - (sizeof("newmtl") - 1) - 1;
+
+        if (!blocks.empty()) {
+            const std::size_t previousBegin = static_cast<std::size_t>(blocks.back().data() - content.data());
+            blocks.back() = content.substr(previousBegin, blockBegin - previousBegin);
+        }
+
+        blocks.push_back(content.substr(blockBegin));
+    });
+
+    std::vector<tinyobj::material_t> parsedMaterials(blocks.size());
+
+    ParallelFor::forEachRange(blocks.size(), 1, [&](const std::size_t begin, const std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            parseMaterialBlock(blocks[i], parsedMaterials[i]);
+        }
+    });
+
+    for (auto& material : parsedMaterials) {
+        if (material.name.empty()) continue;
+
+        // First definition wins, as with tinyobjloader
+        materialMap.emplace(material.name, static_cast<int>(materials.size()));
+        materials.push_back(std::move(material));
+    }
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "core/debug/ErrorHandling.h"
+
+#include "libraries/tinyobjloaderUsage.h"
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Multithreaded .obj/.mtl parser producing tinyobjloader-compatible data (triangulated faces)
+// Files are memory mapped, split into line-aligned chunks parsed in parallel, then merged with prefix sums
+class ObjParser {
+public:
+    using MaterialMap = std::unordered_map<std::string, int>;
+
+    [[nodiscard]] static Expected<void> load(
+        const std::string&                path,
+        const std::string&                materialDirectory,
+        tinyobj::attrib_t&                attributes,
+        std::vector<tinyobj::shape_t>&    shapes,
+        std::vector<tinyobj::material_t>& materials
+    );
+
+    // Appends materials from a .mtl file, existing names are not overridden
+    [[nodiscard]] static Expected<void> loadMaterials(
+        const std::string&                path,
+        std::vector<tinyobj::material_t>& materials,
+        MaterialMap&                      materialMap
+    );
+
+    // Parses .mtl content already in memory
+    static void parseMaterials(
+        std::string_view                  content,
+        std::vector<tinyobj::material_t>& materials,
+        MaterialMap&                      materialMap
+    );
+};
@@ -4,6 +4,9 @@
 
 #include "graphics/vulkan/rendergraph/VulkanRenderGraphBuilder.h"
 
+#include "core/debug/Profiler.h"
+#include "core/multithreading/ParallelFor.h"
+
 VulkanRenderer::VulkanRenderer(const std::uint32_t framesInFlight) : _framesInFlight(framesInFlight) {}
 
 Expected<void> VulkanRenderer::init(
@@ -27,6 +30,19 @@ Expected<void> VulkanRenderer::init(
     // Resource managers creation
     TRY(createVulkanEntity(&swapchainManager, window, surface, device, swapchain, _framesInFlight));
     TRY(createVulkanEntity(&commandManager, device, _framesInFlight));
+
+    // One secondary command pool per parallel recording slot and frame in flight
+    const auto recordingSlotCount = static_cast<std::uint32_t>(ParallelFor::getThreadCount());
+    TRY(createVulkanEntity(&secondaryCommandPools, device, _framesInFlight, recordingSlotCount));
+
+    // Drawn primitives, read back a ring turn later instead of waiting on each frame
+    TRY(createVulkanEntity(&statisticsQueries,
+        device, vk::QueryType::ePipelineStatistics, 1, _framesInFlight,
+        vk::QueryPipelineStatisticFlagBits::eInputAssemblyPrimitives
+    ));
+
+    TRY(createVulkanEntity(&gpuProfiler, device, _framesInFlight));
+
     TRY(createVulkanEntity(&meshManager, device, commandManager));
     TRY(createVulkanEntity(&imageManager, device, commandManager));
 
@@ -36,7 +52,7 @@ Expected<void> VulkanRenderer::init(
     TRY(createVulkanEntity(&renderResources, device, swapchain, commandManager, _framesInFlight));
     TRY(createVulkanEntity(&frameResources, device, imageManager, uniformBufferManager, _framesInFlight));
 
-    TRY(createVulkanEntity(&materialManager, device, imageManager, _framesInFlight));
+    TRY(createVulkanEntity(&materialManager, device, imageManager, storageBufferManager, _framesInFlight));
 
     TRY(createVulkanEntity(&renderObjectManager,
         VulkanRenderObjectCreateContext{
@@ -50,11 +66,22 @@ Expected<void> VulkanRenderer::init(
         }
     ));
 
-    TRY(createVulkanEntity(&frameCuller, device, storageBufferManager, _framesInFlight));
+    // Mesh draws are culled on the GPU when indirect draw counts are available
+    // Two phases: draws visible last frame, then the newly visible ones tested against a depth pyramid of the first
+    // Opt-in through NOBLE_ENABLE_GPU_CULLING until the compute path is validated on every target driver
+#if defined(NOBLE_GPU_CULLING)
+    const bool gpuCulling = device.supportsDrawIndirectCount();
+#else
+    const bool gpuCulling = false;
+#endif
+
+    // The GPU culling buffers and depth pyramid are only allocated with GPU culling
+    TRY(createVulkanEntity(&frameCuller, device, storageBufferManager, objectManager, _framesInFlight, gpuCulling));
 
     // Pipeline creation
     TRY(createVulkanEntity(&shaderProgramManager, logicalDevice));
     TRY(createVulkanEntity(&pipelineManager, logicalDevice));
+    TRY(createVulkanEntity(&computePipelineManager, logicalDevice));
 
     // Render graph construction
     TRY(createVulkanEntity(&renderGraph,
@@ -65,7 +92,10 @@ Expected<void> VulkanRenderer::init(
             &frameResources,
             &frameCuller,
             &renderObjectManager,
-            device.getQueryPool()
+            &materialManager,
+            &secondaryCommandPools,
+            &statisticsQueries,
+            &gpuProfiler
         }
     ));
 
@@ -86,29 +116,73 @@ Expected<void> VulkanRenderer::init(
             renderObjectManager,
             frameCuller,
             shaderProgramManager,
-            pipelineManager
+            pipelineManager,
+            computePipelineManager
         },
         passFactory
     );
 
+    const VulkanGraphicsPassCullMode meshCullMode = gpuCulling
+        ? VulkanGraphicsPassCullMode::Gpu
+        : VulkanGraphicsPassCullMode::Frustum;
+
     renderGraphBuilder
         .registerResource({"depthBuffer", vk::Format::eD32Sfloat})
         .registerResource({"albedoBuffer"})
         .registerResource({"normalBuffer"})
         .registerResource({"debugBuffer", vk::Format::eR32G32B32A32Sfloat})
         .registerResource({"compositeBuffer", vk::Format::eR16G16B16A16Sfloat})
-        .registerResource({"swapchainOutput", vk::Format::eB8G8R8A8Srgb, VulkanPassResourceType::SwapchainOutput})
-        .addPass(
+        .registerResource({"swapchainOutput", vk::Format::eB8G8R8A8Srgb, VulkanPassResourceType::SwapchainOutput});
+
+    if (gpuCulling) {
+        renderGraphBuilder.addComputePass(
             {
-                VulkanPassDescriptor{
-                    "Gbuffer_Pass", "mesh_render",
-                    {},
-                    {{"albedoBuffer"}, {"normalBuffer"}}
-                },
-                VulkanGraphicsPassType::MeshRender, VulkanGraphicsPassCullMode::Frustum,
-                {"depthBuffer"}
+                VulkanPassDescriptor{"DrawCull_Pass", "draw_cull"},
+                VulkanComputePassType::DrawCull
             }
-        )
+        );
+    }
+
+    renderGraphBuilder.addPass(
+        {
+            VulkanPassDescriptor{
+                "Gbuffer_Pass", "mesh_render",
+                {},
+                {{"albedoBuffer"}, {"normalBuffer"}}
+            },
+            VulkanGraphicsPassType::MeshRender, meshCullMode,
+            {"depthBuffer"}
+        }
+    );
+
+    if (gpuCulling) {
+        renderGraphBuilder
+            .addComputePass(
+                {
+                    VulkanPassDescriptor{"DepthPyramid_Pass", "depth_pyramid", {{"depthBuffer"}}},
+                    VulkanComputePassType::DepthPyramid
+                }
+            )
+            .addComputePass(
+                {
+                    VulkanPassDescriptor{"DrawCullLate_Pass", "draw_cull_late"},
+                    VulkanComputePassType::DrawCullLate
+                }
+            )
+            .addPass(
+                {
+                    VulkanPassDescriptor{
+                        "GbufferLate_Pass", "mesh_render",
+                        {},
+                        {{"albedoBuffer"}, {"normalBuffer"}}
+                    },
+                    VulkanGraphicsPassType::MeshRender, VulkanGraphicsPassCullMode::GpuLate,
+                    {"depthBuffer"}
+                }
+            );
+    }
+
+    renderGraphBuilder
         .addPass(
             {
                 VulkanPassDescriptor{
@@ -143,6 +217,8 @@ Expected<void> VulkanRenderer::init(
 
     TRY(renderGraphBuilder.build());
 
+    TRY(resizeDepthPyramid());
+
     TRY(meshManager.fillBuffers());
 
     guard.release();
@@ -162,7 +238,11 @@ Expected<void> VulkanRenderer::drawFrame(const FrameUniforms& uniforms) {
     TRY(onFramebufferResize());
 
     VulkanSwapchain::SwapchainOp<uint32_t> imageAcquireResult;
-    TRY_ASSIGN(imageAcquireResult, swapchainManager.acquireNextImage(currentFrame));
+
+    {
+        PROFILE_ZONE("AcquireImage");
+        TRY_ASSIGN(imageAcquireResult, swapchainManager.acquireNextImage(currentFrame));
+    }
 
     if (!imageAcquireResult.value.has_value()) {
         return {};
@@ -170,12 +250,34 @@ Expected<void> VulkanRenderer::drawFrame(const FrameUniforms& uniforms) {
 
     const uint32_t imageIndex = imageAcquireResult.value.value();
 
+    FrameStats frameStats{};
+
+    // Queried drawn triangles count of the last submission of this frame, complete since its fence was waited on
+    // A frame without results (first frames, skipped submission) keeps the previous count
+    std::uint64_t primitiveCount    = 0;
+    bool          primitivesQueried = false;
+    TRY_ASSIGN(primitivesQueried, statisticsQueries.read(currentFrame, std::span(&primitiveCount, 1)));
+
+    if (primitivesQueried) _lastPrimitiveCount = primitiveCount;
+
+    frameStats.primitiveCount = _lastPrimitiveCount;
+
+    // Pass timings of that same submission
+    TRY(gpuProfiler.collect(currentFrame));
+
+    frameStats.gpuTimeMs = gpuProfiler.getFrameMs();
+
     // Frame data update
     frameResources.update(currentFrame, imageIndex, uniforms);
     // Render objects update
     renderObjectManager.updateObjects(currentFrame);
     // Frustum culling
-    TRY(frameCuller.cull(renderGraph.getPasses(), uniforms));
+    {
+        PROFILE_ZONE("Cull");
+        TRY(frameCuller.cull(renderGraph.getPasses(), renderGraph.getComputePasses(), uniforms, currentFrame));
+    }
+
+    frameStats.cullStats = frameCuller.getStats();
 
     // Command buffer record and submit
     const vk::CommandBuffer currentCommandBuffer = commandManager.getCommandBuffers()[currentFrame];
@@ -183,22 +285,35 @@ Expected<void> VulkanRenderer::drawFrame(const FrameUniforms& uniforms) {
     TRY(commandManager.record(
         currentCommandBuffer,
         [this](const vk::CommandBuffer cmd) -> Expected<void> {
+            PROFILE_ZONE("RecordCommands");
             return renderGraph.execute(cmd);
         }
     ));
 
-    TRY(swapchainManager.submitCommandBuffer(currentCommandBuffer, currentFrame, imageIndex));
+    frameStats.recordingStats = renderGraph.getRecordingStats();
 
-    currentFrame = (currentFrame + 1) % _framesInFlight;
+    {
+        PROFILE_ZONE("Submit");
+        TRY(swapchainManager.submitCommandBuffer(currentCommandBuffer, currentFrame, imageIndex));
+    }
 
-    // Queried drawn triangles count
-    TRY(context.getDevice().getQueryPoolResults<std::uint64_t>(
-        &primitiveCount, vk::QueryResultFlagBits::eWait | vk::QueryResultFlagBits::e64
-    ));
+    publishFrameStats(frameStats);
+
+    currentFrame = (currentFrame + 1) % _framesInFlight;
 
     return {};
 }
 
+VulkanRenderer::FrameStats VulkanRenderer::getFrameStats() const {
+    std::lock_guard lock(_frameStatsMutex);
+    return _frameStats;
+}
+
+void VulkanRenderer::publishFrameStats(const FrameStats& stats) {
+    std::lock_guard lock(_frameStatsMutex);
+    _frameStats = stats;
+}
+
 Expected<void> VulkanRenderer::onFramebufferResize() {
     if (!_window || !_window->isFramebufferResized()) return {};
 
@@ -209,7 +324,21 @@ Expected<void> VulkanRenderer::onFramebufferResize() {
     TRY(swapchainManager.recreateSwapchain());
     TRY(renderResources.recreate(renderGraph));
 
+    TRY(resizeDepthPyramid());
+
     _window->setFramebufferResized(false);
 
     return {};
 }
+
+Expected<void> VulkanRenderer::resizeDepthPyramid() {
+    const VulkanPassResource* depthBuffer = renderResources.getResource("depthBuffer");
+
+    if (!depthBuffer || !depthBuffer->resolveImage()) {
+        return VK_FAIL("Failed to resize depth pyramid: missing depth buffer.");
+    }
+
+    TRY(frameCuller.resizeDepthPyramid(*depthBuffer->resolveImage(), commandManager));
+
+    return {};
+}
@@ -8,6 +8,8 @@
 
 #include "graphics/vulkan/core/VulkanCommandManager.h"
 #include "graphics/vulkan/core/VulkanContext.h"
+#include "graphics/vulkan/core/VulkanQueryRing.h"
+#include "graphics/vulkan/core/VulkanSecondaryCommandPools.h"
 #include "graphics/vulkan/core/VulkanSwapchainManager.h"
 
 #include "graphics/vulkan/resources/frame/VulkanFrameResources.h"
@@ -18,11 +20,14 @@
 #include "graphics/vulkan/resources/ssbo/VulkanStorageBufferManager.h"
 #include "graphics/vulkan/resources/ubo/VulkanUniformBufferManager.h"
 
+#include "graphics/vulkan/pipeline/compute/VulkanComputePipelineManager.h"
 #include "graphics/vulkan/pipeline/graphics/VulkanGraphicsPipelineManager.h"
 #include "graphics/vulkan/pipeline/shaders/VulkanShaderProgramManager.h"
 
 #include "graphics/vulkan/rendergraph/VulkanRenderGraph.h"
 
+#include <mutex>
+
 class VulkanRenderer final : public GraphicsAPI, public VulkanEntityOwner<VulkanRenderer> {
 public:
     explicit VulkanRenderer(std::uint32_t framesInFlight = 2);
@@ -37,13 +42,40 @@ public:
 
     Expected<void> drawFrame(const FrameUniforms& uniforms) override;
 
-    std::uint64_t primitiveCount = 0;
+    // Counters of the last drawn frame, copied once per frame so other threads never read them mid update
+    struct FrameStats {
+        // Primitives drawn by the mesh passes, frames in flight - 1 frames behind
+        std::uint64_t                primitiveCount = 0;
+        VulkanFrameCuller::CullStats cullStats{};
+        VulkanCommandRecorder::Stats recordingStats{};
+
+        // Summed pass times of the last collected frame, 0 without timestamp support
+        double gpuTimeMs = 0.0;
+    };
+
+    [[nodiscard]] FrameStats getFrameStats() const;
+
+    // Rolling GPU time per pass, and the per frame dump, render thread only
+    [[nodiscard]]       VulkanGpuProfiler& getGpuProfiler()       noexcept { return gpuProfiler; }
+    [[nodiscard]] const VulkanGpuProfiler& getGpuProfiler() const noexcept { return gpuProfiler; }
 
 private:
     [[nodiscard]] Expected<void> onFramebufferResize();
 
+    // The depth pyramid follows the depth buffer extent
+    [[nodiscard]] Expected<void> resizeDepthPyramid();
+
+    // Written by the render thread at the end of drawFrame
+    void publishFrameStats(const FrameStats& stats);
+
     Window* _window = nullptr;
 
+    mutable std::mutex _frameStatsMutex{};
+    FrameStats         _frameStats{};
+
+    // Render thread only, last primitive count read back from the statistics queries
+    std::uint64_t _lastPrimitiveCount = 0;
+
     std::uint32_t _framesInFlight = 0;
 
     unsigned int currentFrame = 0;
@@ -55,6 +87,10 @@ private:
     VulkanMeshManager          meshManager{};
     VulkanImageManager         imageManager{};
 
+    VulkanSecondaryCommandPools secondaryCommandPools{};
+    VulkanQueryRing             statisticsQueries{};
+    VulkanGpuProfiler           gpuProfiler{};
+
     VulkanStorageBufferManager storageBufferManager{};
     VulkanUniformBufferManager uniformBufferManager{};
 
@@ -68,5 +104,6 @@ private:
 
     VulkanShaderProgramManager    shaderProgramManager{};
     VulkanGraphicsPipelineManager pipelineManager{};
+    VulkanComputePipelineManager  computePipelineManager{};
     VulkanRenderGraph             renderGraph{};
 };
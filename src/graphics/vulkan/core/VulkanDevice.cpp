@@ -39,16 +39,14 @@ Expected<void> VulkanDevice::create(
 
     TRY(createLogicalDevice(_queueFamilyIndices));
     TRY(createAllocator());
-    TRY(createQueryPool());
+
+    TRY(_samplerCache->create(_logicalDevice, _properties.limits.maxSamplerAnisotropy));
 
     return {};
 }
 
 void VulkanDevice::destroy() noexcept {
-    if (_queryPool && _logicalDevice) {
-        _logicalDevice.destroyQueryPool(_queryPool);
-        _queryPool = VK_NULL_HANDLE;
-    }
+    _samplerCache->destroy();
 
     if (_allocator) {
         vmaDestroyAllocator(_allocator);
@@ -127,7 +125,9 @@ Expected<void> VulkanDevice::pickPhysicalDevice() {
         return VK_FAIL("Failed to find suitable graphics devices.");
     }
 
-    Logger::info("Using graphics device \"" + std::string(_physicalDevice.getProperties().deviceName.data()) + "\"");
+    _properties = _physicalDevice.getProperties2().properties;
+
+    Logger::info("Using graphics device \"" + std::string(_properties.deviceName.data()) + "\"");
 
     return {};
 }
@@ -231,11 +231,50 @@ Expected<void> VulkanDevice::createLogicalDevice(const QueueFamilyIndices queueF
         );
     }
 
+    // GPU-driven draws are optional, passes fall back to CPU culling without them
+    const auto supportedFeatures = _physicalDevice.getFeatures2<
+        vk::PhysicalDeviceFeatures2, vk::PhysicalDeviceVulkan12Features
+    >();
+
+    const vk::PhysicalDeviceFeatures& supportedFeatures_1_0 =
+        supportedFeatures.get<vk::PhysicalDeviceFeatures2>().features;
+
+    _supportsMultiDrawIndirect = supportedFeatures_1_0.multiDrawIndirect
+                              && supportedFeatures_1_0.drawIndirectFirstInstance;
+
+    _supportsDrawIndirectCount = _supportsMultiDrawIndirect
+                              && supportedFeatures.get<vk::PhysicalDeviceVulkan12Features>().drawIndirectCount;
+
+    // Parallel recording is optional as well, passes are recorded inline without it
+    _supportsInheritedQueries = supportedFeatures_1_0.inheritedQueries;
+
+    // Bindless materials are required, there is no per material descriptor set path to fall back to
+    const vk::PhysicalDeviceVulkan12Features& supportedFeatures_1_2 =
+        supportedFeatures.get<vk::PhysicalDeviceVulkan12Features>();
+
+    if (!supportedFeatures_1_2.descriptorIndexing
+     || !supportedFeatures_1_2.runtimeDescriptorArray
+     || !supportedFeatures_1_2.descriptorBindingPartiallyBound
+     || !supportedFeatures_1_2.descriptorBindingSampledImageUpdateAfterBind
+     || !supportedFeatures_1_2.shaderSampledImageArrayNonUniformIndexing) {
+        return VK_FAIL(
+            "Failed to create logical device: bindless materials require descriptor indexing with runtime, partially "
+            "bound, update after bind and non uniformly indexed sampled image arrays."
+        );
+    }
+
+    const vk::Bool32 multiDrawIndirect = _supportsMultiDrawIndirect ? vk::True : vk::False;
+    const vk::Bool32 drawIndirectCount = _supportsDrawIndirectCount ? vk::True : vk::False;
+    const vk::Bool32 inheritedQueries  = _supportsInheritedQueries  ? vk::True : vk::False;
+
     VkPhysicalDeviceFeatures deviceFeatures{
-        .fillModeNonSolid        = vk::True,
-        .wideLines               = vk::True,
-        .samplerAnisotropy       = vk::True,
-        .pipelineStatisticsQuery = vk::True
+        .multiDrawIndirect         = multiDrawIndirect,
+        .drawIndirectFirstInstance = multiDrawIndirect,
+        .fillModeNonSolid          = vk::True,
+        .wideLines                 = vk::True,
+        .samplerAnisotropy         = vk::True,
+        .pipelineStatisticsQuery   = vk::True,
+        .inheritedQueries          = inheritedQueries
     };
 
     VkPhysicalDeviceVulkan11Features deviceFeatures_1_1{
@@ -248,24 +287,31 @@ Expected<void> VulkanDevice::createLogicalDevice(const QueueFamilyIndices queueF
         .dynamicRendering = vk::True
     };
 
-    VkPhysicalDeviceBufferDeviceAddressFeatures deviceBufferAddressFeatures{
+    // Vulkan 1.2 features must all live in the aggregate struct once it is chained
+    VkPhysicalDeviceVulkan12Features deviceFeatures_1_2{
+        .sType               = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES,
         .pNext               = &deviceFeatures_1_3,
+        .drawIndirectCount   = drawIndirectCount,
+
+        // Bindless materials, checked above
+        .descriptorIndexing                           = vk::True,
+        .shaderSampledImageArrayNonUniformIndexing    = vk::True,
+        .descriptorBindingSampledImageUpdateAfterBind = vk::True,
+        .descriptorBindingPartiallyBound              = vk::True,
+        .runtimeDescriptorArray                       = vk::True,
+
+        .timelineSemaphore   = vk::True,
         .bufferDeviceAddress = vk::True
     };
 
     VkPhysicalDeviceDynamicRenderingUnusedAttachmentsFeaturesEXT deviceDynamicRenderingFeatures{
-        .pNext                             = &deviceBufferAddressFeatures,
+        .pNext                             = &deviceFeatures_1_2,
         .dynamicRenderingUnusedAttachments = vk::True
     };
 
-    VkPhysicalDeviceTimelineSemaphoreFeaturesKHR timelineSemaphoreFeatures{
-        .pNext             = &deviceDynamicRenderingFeatures,
-        .timelineSemaphore = vk::True
-    };
-
     VkDeviceCreateInfo deviceInfo{
         .sType                   = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO,
-        .pNext                   = &timelineSemaphoreFeatures,
+        .pNext                   = &deviceDynamicRenderingFeatures,
         .queueCreateInfoCount    = static_cast<std::uint32_t>(queueCreateInfos.size()),
         .pQueueCreateInfos       = queueCreateInfos.data(),
         .enabledExtensionCount   = static_cast<std::uint32_t>(deviceExtensions.size()),
@@ -307,15 +353,3 @@ Expected<void> VulkanDevice::createAllocator() {
 
     return {};
 }
-
-Expected<void> VulkanDevice::createQueryPool() {
-    vk::QueryPoolCreateInfo queryPoolInfo{};
-    queryPoolInfo
-        .setQueryType(vk::QueryType::ePipelineStatistics)
-        .setQueryCount(1)
-        .setPipelineStatistics(vk::QueryPipelineStatisticFlagBits::eInputAssemblyPrimitives);
-
-    VK_CREATE(_queryPool, _logicalDevice.createQueryPool(queryPoolInfo));
-
-    return {};
-}
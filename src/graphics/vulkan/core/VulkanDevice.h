@@ -6,9 +6,12 @@
 #include "graphics/vulkan/common/VulkanHeader.h"
 
 #include "graphics/vulkan/core/VulkanCapabilities.h"
+#include "graphics/vulkan/core/VulkanSamplerCache.h"
 
 #include "graphics/vulkan/core/memory/VmaUsage.h"
 
+#include <memory>
+
 class VulkanDevice {
 public:
     VulkanDevice()  = default;
@@ -37,9 +40,10 @@ public:
     [[nodiscard]] vk::PhysicalDevice getPhysicalDevice() const noexcept { return _physicalDevice; }
     [[nodiscard]] const vk::Device& getLogicalDevice() const noexcept { return _logicalDevice; }
 
-    [[nodiscard]] vk::PhysicalDeviceLimits getLimits() const noexcept {
-        return _physicalDevice.getProperties2().properties.limits;
-    }
+    [[nodiscard]] const vk::PhysicalDeviceProperties& getProperties() const noexcept { return _properties; }
+    [[nodiscard]] const vk::PhysicalDeviceLimits& getLimits() const noexcept { return _properties.limits; }
+
+    [[nodiscard]] VulkanSamplerCache& getSamplerCache() const noexcept { return *_samplerCache; }
 
     [[nodiscard]] VmaAllocator getAllocator() const noexcept { return _allocator; }
 
@@ -49,27 +53,14 @@ public:
     [[nodiscard]] vk::Queue getPresentQueue() const noexcept { return _presentQueue; }
     [[nodiscard]] vk::Queue getComputeQueue() const noexcept { return _computeQueue; }
 
-    [[nodiscard]] vk::QueryPool getQueryPool() const noexcept { return _queryPool; }
-
-    template<typename QueryDataType>
-    [[nodiscard]] Expected<void> getQueryPoolResults(
-        QueryDataType*             pData,
-        const vk::QueryResultFlags flags,
-        const std::uint32_t        firstQuery = 0,
-        const std::uint32_t        queryCount = 1
-    ) const {
-        VK_TRY(_logicalDevice.getQueryPoolResults(
-            _queryPool,
-            firstQuery,
-            queryCount,
-            sizeof(QueryDataType) * queryCount,
-            pData,
-            sizeof(QueryDataType),
-            flags
-        ));
-
-        return {};
-    }
+    // Multi-draw indirect with a first instance, CPU written commands
+    [[nodiscard]] bool supportsMultiDrawIndirect() const noexcept { return _supportsMultiDrawIndirect; }
+
+    // Multi-draw indirect with a GPU written draw count and first instance
+    [[nodiscard]] bool supportsDrawIndirectCount() const noexcept { return _supportsDrawIndirectCount; }
+
+    // Secondary command buffers executed while a query is active, required to record passes in parallel
+    [[nodiscard]] bool supportsInheritedQueries() const noexcept { return _supportsInheritedQueries; }
 
 private:
     static bool isPhysicalDeviceSuitable(vk::PhysicalDevice device);
@@ -82,8 +73,6 @@ private:
 
     Expected<void> createAllocator();
 
-    Expected<void> createQueryPool();
-
     const VulkanCapabilities* _capabilities = nullptr;
 
     vk::Instance _instance{};
@@ -91,6 +80,9 @@ private:
     vk::PhysicalDevice _physicalDevice{};
     vk::Device         _logicalDevice{};
 
+    // Queried once at device selection, limits are immutable for the lifetime of the physical device
+    vk::PhysicalDeviceProperties _properties{};
+
     VmaAllocator _allocator;
 
     QueueFamilyIndices _queueFamilyIndices{};
@@ -99,5 +91,9 @@ private:
     vk::Queue _presentQueue{};
     vk::Queue _computeQueue{};
 
-    vk::QueryPool _queryPool{};
+    bool _supportsMultiDrawIndirect = false;
+    bool _supportsDrawIndirectCount = false;
+    bool _supportsInheritedQueries  = false;
+
+    std::unique_ptr<VulkanSamplerCache> _samplerCache = std::make_unique<VulkanSamplerCache>();
 };
@@ -0,0 +1,80 @@
+#include "VulkanQueryRing.h"
+
+#include "graphics/vulkan/common/VulkanDebugger.h"
+
+#include <algorithm>
+
+Expected<void> VulkanQueryRing::create(
+    const VulkanDevice&                   device,
+    const vk::QueryType                   queryType,
+    const std::uint32_t                   queriesPerFrame,
+    const std::uint32_t                   framesInFlight,
+    const vk::QueryPipelineStatisticFlags pipelineStatistics
+) noexcept {
+    _device          = &device;
+    _queriesPerFrame = queriesPerFrame;
+
+    _written.assign(framesInFlight, false);
+    _readback.resize(static_cast<std::size_t>(queriesPerFrame) * 2);
+
+    vk::QueryPoolCreateInfo queryPoolInfo{};
+    queryPoolInfo
+        .setQueryType(queryType)
+        .setQueryCount(queriesPerFrame * framesInFlight)
+        .setPipelineStatistics(pipelineStatistics);
+
+    VK_CREATE(_queryPool, device.getLogicalDevice().createQueryPool(queryPoolInfo));
+
+    return {};
+}
+
+void VulkanQueryRing::destroy() noexcept {
+    if (!_device) return;
+
+    if (_queryPool) {
+        _device->getLogicalDevice().destroyQueryPool(_queryPool);
+        _queryPool = VK_NULL_HANDLE;
+    }
+
+    _written.clear();
+    _readback.clear();
+
+    _device = nullptr;
+}
+
+void VulkanQueryRing::reset(const vk::CommandBuffer commandBuffer, const std::uint32_t frameIndex) {
+    commandBuffer.resetQueryPool(_queryPool, getQuery(frameIndex, 0), _queriesPerFrame);
+
+    _written[frameIndex] = true;
+}
+
+Expected<bool> VulkanQueryRing::read(const std::uint32_t frameIndex, const std::span<std::uint64_t> results) {
+    if (!_written[frameIndex] || results.empty()) return Expected(false);
+
+    const auto queryCount = static_cast<std::uint32_t>(std::min<std::size_t>(results.size(), _queriesPerFrame));
+
+    // Without the wait flag unavailable queries return eNotReady instead of blocking
+    const vk::Result result = _device->getLogicalDevice().getQueryPoolResults(
+        _queryPool,
+        getQuery(frameIndex, 0),
+        queryCount,
+        queryCount * 2 * sizeof(std::uint64_t),
+        _readback.data(),
+        2 * sizeof(std::uint64_t),
+        vk::QueryResultFlagBits::e64 | vk::QueryResultFlagBits::eWithAvailability
+    );
+
+    if (result != vk::Result::eNotReady) {
+        VK_TRY(result);
+    }
+
+    for (std::uint32_t i = 0; i < queryCount; i++) {
+        if (_readback[i * 2 + 1] == 0) return Expected(false);
+    }
+
+    for (std::uint32_t i = 0; i < queryCount; i++) {
+        results[i] = _readback[i * 2];
+    }
+
+    return Expected(true);
+}
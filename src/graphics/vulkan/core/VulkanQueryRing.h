@@ -0,0 +1,64 @@
+#pragma once
+
+#include "core/debug/ErrorHandling.h"
+
+#include "graphics/vulkan/common/VulkanHeader.h"
+
+#include "graphics/vulkan/core/VulkanDevice.h"
+
+#include <span>
+#include <vector>
+
+// A query pool split into one slice of queries per frame in flight
+// A frame only resets and writes its own slice, which is read back without waiting once the frame comes around again
+// and its fence was waited on, the availability bits cover slices whose submission did not complete
+class VulkanQueryRing {
+public:
+    VulkanQueryRing()  = default;
+    ~VulkanQueryRing() = default;
+
+    VulkanQueryRing(const VulkanQueryRing&)            = delete;
+    VulkanQueryRing& operator=(const VulkanQueryRing&) = delete;
+
+    VulkanQueryRing(VulkanQueryRing&&)            = delete;
+    VulkanQueryRing& operator=(VulkanQueryRing&&) = delete;
+
+    [[nodiscard]] Expected<void> create(
+        const VulkanDevice&             device,
+        vk::QueryType                   queryType,
+        std::uint32_t                   queriesPerFrame,
+        std::uint32_t                   framesInFlight,
+        vk::QueryPipelineStatisticFlags pipelineStatistics = {}
+    ) noexcept;
+
+    void destroy() noexcept;
+
+    // Records the reset of the frame slice, to be done before any of its queries is written
+    void reset(vk::CommandBuffer commandBuffer, std::uint32_t frameIndex);
+
+    // Query of the frame slice, as passed to the query commands
+    [[nodiscard]] std::uint32_t getQuery(const std::uint32_t frameIndex, const std::uint32_t index) const noexcept {
+        return frameIndex * _queriesPerFrame + index;
+    }
+
+    // The first results.size() queries of the frame slice as of its last submission, never waits
+    // False when the slice was never written or any of its queries is not available yet
+    [[nodiscard]] Expected<bool> read(std::uint32_t frameIndex, std::span<std::uint64_t> results);
+
+    [[nodiscard]] vk::QueryPool getQueryPool() const noexcept { return _queryPool; }
+
+    [[nodiscard]] std::uint32_t getQueriesPerFrame() const noexcept { return _queriesPerFrame; }
+
+private:
+    const VulkanDevice* _device = nullptr;
+
+    vk::QueryPool _queryPool{};
+
+    std::uint32_t _queriesPerFrame = 0;
+
+    // Slices reset by a recorded frame, queries are undefined before their first reset
+    std::vector<bool> _written{};
+
+    // Value and availability pairs of the read queries
+    std::vector<std::uint64_t> _readback{};
+};
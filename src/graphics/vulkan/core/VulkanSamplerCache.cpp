@@ -0,0 +1,72 @@
+#include "VulkanSamplerCache.h"
+
+#include "graphics/vulkan/common/VulkanDebugger.h"
+
+#include <algorithm>
+#include <ranges>
+
+Expected<void> VulkanSamplerCache::create(const vk::Device& device, const float maxSamplerAnisotropy) noexcept {
+    _device               = device;
+    _maxSamplerAnisotropy = maxSamplerAnisotropy;
+
+    return {};
+}
+
+void VulkanSamplerCache::destroy() noexcept {
+    std::lock_guard lock(_mutex);
+
+    if (_device) {
+        for (const vk::Sampler sampler : _samplers | std::views::values) {
+            _device.destroySampler(sampler);
+        }
+    }
+
+    _samplers.clear();
+
+    _device = VK_NULL_HANDLE;
+}
+
+Expected<vk::Sampler> VulkanSamplerCache::getOrCreate(const VulkanSamplerDescriptor& descriptor) {
+    // Normalize the key so that requests resolving to the same sampler state share an entry
+    VulkanSamplerDescriptor key = descriptor;
+
+    if (key.anisotropyEnable) {
+        key.maxAnisotropy = key.maxAnisotropy <= 0.0f
+            ? _maxSamplerAnisotropy
+            : std::min(key.maxAnisotropy, _maxSamplerAnisotropy);
+    } else {
+        key.maxAnisotropy = 1.0f;
+    }
+
+    std::lock_guard lock(_mutex);
+
+    // Fast path: sampler already exists
+    if (const auto it = _samplers.find(key); it != _samplers.end()) {
+        return Expected(it->second);
+    }
+
+    vk::SamplerCreateInfo samplerInfo{};
+    samplerInfo
+        .setMagFilter(key.filter)
+        .setMinFilter(key.filter)
+        .setMipmapMode(key.mipmapMode)
+        .setAddressModeU(key.addressMode)
+        .setAddressModeV(key.addressMode)
+        .setAddressModeW(key.addressMode)
+        .setMipLodBias(0.0f)
+        .setAnisotropyEnable(key.anisotropyEnable ? vk::True : vk::False)
+        .setMaxAnisotropy(key.maxAnisotropy)
+        .setCompareEnable(vk::False)
+        .setCompareOp(vk::CompareOp::eAlways)
+        .setMinLod(key.minLod)
+        .setMaxLod(key.maxLod)
+        .setBorderColor(vk::BorderColor::eIntOpaqueBlack)
+        .setUnnormalizedCoordinates(vk::False);
+
+    vk::Sampler sampler{};
+    VK_CREATE(sampler, _device.createSampler(samplerInfo));
+
+    _samplers.emplace(key, sampler);
+
+    return Expected(sampler);
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "common/HashUtils.h"
+#include "core/debug/ErrorHandling.h"
+
+#include "graphics/vulkan/common/VulkanHeader.h"
+
+#include <mutex>
+#include <unordered_map>
+
+struct VulkanSamplerDescriptor {
+    vk::Filter             filter      = vk::Filter::eLinear;
+    vk::SamplerMipmapMode  mipmapMode  = vk::SamplerMipmapMode::eLinear;
+    vk::SamplerAddressMode addressMode = vk::SamplerAddressMode::eRepeat;
+
+    // Anisotropy is clamped to the device limit, a value of 0 means "use the device maximum"
+    bool  anisotropyEnable = true;
+    float maxAnisotropy    = 0.0f;
+
+    float minLod = 0.0f;
+    float maxLod = vk::LodClampNone;
+
+    bool operator==(const VulkanSamplerDescriptor& other) const noexcept = default;
+};
+
+template<>
+struct std::hash<VulkanSamplerDescriptor> {
+    std::size_t operator()(const VulkanSamplerDescriptor& descriptor) const noexcept {
+        std::size_t hash = 0;
+
+        HashUtils::combine(hash, static_cast<std::uint32_t>(descriptor.filter));
+        HashUtils::combine(hash, static_cast<std::uint32_t>(descriptor.mipmapMode));
+        HashUtils::combine(hash, static_cast<std::uint32_t>(descriptor.addressMode));
+        HashUtils::combine(hash, descriptor.anisotropyEnable);
+        HashUtils::combine(hash, descriptor.maxAnisotropy);
+        HashUtils::combine(hash, descriptor.minLod);
+        HashUtils::combine(hash, descriptor.maxLod);
+
+        return hash;
+    }
+};
+
+// Device-level sampler cache, samplers are shared between images and owned by the cache
+class VulkanSamplerCache {
+public:
+    VulkanSamplerCache()  = default;
+    ~VulkanSamplerCache() = default;
+
+    VulkanSamplerCache(const VulkanSamplerCache&)            = delete;
+    VulkanSamplerCache& operator=(const VulkanSamplerCache&) = delete;
+
+    VulkanSamplerCache(VulkanSamplerCache&&)            = delete;
+    VulkanSamplerCache& operator=(VulkanSamplerCache&&) = delete;
+
+    [[nodiscard]] Expected<void> create(const vk::Device& device, float maxSamplerAnisotropy) noexcept;
+
+    void destroy() noexcept;
+
+    [[nodiscard]] Expected<vk::Sampler> getOrCreate(const VulkanSamplerDescriptor& descriptor);
+
+    [[nodiscard]] std::size_t size() const noexcept {
+        std::lock_guard lock(_mutex);
+        return _samplers.size();
+    }
+
+private:
+    vk::Device _device{};
+
+    float _maxSamplerAnisotropy = 1.0f;
+
+    mutable std::mutex _mutex{};
+
+    std::unordered_map<VulkanSamplerDescriptor, vk::Sampler> _samplers{};
+};
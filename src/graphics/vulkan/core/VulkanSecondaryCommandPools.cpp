@@ -0,0 +1,87 @@
+#include "VulkanSecondaryCommandPools.h"
+
+#include "graphics/vulkan/common/VulkanDebugger.h"
+
+Expected<void> VulkanSecondaryCommandPools::create(
+    const VulkanDevice& device, const std::uint32_t framesInFlight, const std::uint32_t slotCount
+) noexcept {
+    _device    = &device;
+    _slotCount = slotCount;
+
+    _slotPools.resize(static_cast<std::size_t>(framesInFlight) * slotCount);
+
+    // Buffers are only reset with their pool and re-recorded every frame
+    vk::CommandPoolCreateInfo commandPoolInfo{};
+    commandPoolInfo
+        .setFlags(vk::CommandPoolCreateFlagBits::eTransient)
+        .setQueueFamilyIndex(device.getQueueFamilyIndices().graphicsFamily);
+
+    const vk::Device& logicalDevice = device.getLogicalDevice();
+
+    for (SlotPool& slotPool : _slotPools) {
+        VK_CREATE(slotPool.commandPool, logicalDevice.createCommandPool(commandPoolInfo));
+    }
+
+    return {};
+}
+
+void VulkanSecondaryCommandPools::destroy() noexcept {
+    if (!_device) return;
+
+    const vk::Device& logicalDevice = _device->getLogicalDevice();
+
+    // Command buffers are freed with their pool
+    for (const SlotPool& slotPool : _slotPools) {
+        if (slotPool.commandPool) {
+            logicalDevice.destroyCommandPool(slotPool.commandPool);
+        }
+    }
+
+    _slotPools.clear();
+    _slotCount = 0;
+
+    _device = nullptr;
+}
+
+Expected<void> VulkanSecondaryCommandPools::reset(const std::uint32_t frameIndex) {
+    const vk::Device& logicalDevice = _device->getLogicalDevice();
+
+    for (std::uint32_t slot = 0; slot < _slotCount; slot++) {
+        SlotPool& slotPool = getSlotPool(frameIndex, slot);
+
+        if (slotPool.usedCount == 0) continue;
+
+        VK_TRY(logicalDevice.resetCommandPool(slotPool.commandPool));
+
+        slotPool.usedCount = 0;
+    }
+
+    return {};
+}
+
+Expected<vk::CommandBuffer> VulkanSecondaryCommandPools::acquire(
+    const std::uint32_t frameIndex, const std::uint32_t slot
+) {
+    SlotPool& slotPool = getSlotPool(frameIndex, slot);
+
+    if (slotPool.usedCount == slotPool.commandBuffers.size()) {
+        vk::CommandBufferAllocateInfo allocateInfo{};
+        allocateInfo
+            .setCommandPool(slotPool.commandPool)
+            .setLevel(vk::CommandBufferLevel::eSecondary)
+            .setCommandBufferCount(1);
+
+        std::vector<vk::CommandBuffer> commandBuffers;
+        VK_CREATE(commandBuffers, _device->getLogicalDevice().allocateCommandBuffers(allocateInfo));
+
+        slotPool.commandBuffers.push_back(commandBuffers.front());
+    }
+
+    return Expected(slotPool.commandBuffers[slotPool.usedCount++]);
+}
+
+VulkanSecondaryCommandPools::SlotPool& VulkanSecondaryCommandPools::getSlotPool(
+    const std::uint32_t frameIndex, const std::uint32_t slot
+) noexcept {
+    return _slotPools[static_cast<std::size_t>(frameIndex) * _slotCount + slot];
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "core/debug/ErrorHandling.h"
+
+#include "graphics/vulkan/common/VulkanHeader.h"
+
+#include "graphics/vulkan/core/VulkanDevice.h"
+
+#include <vector>
+
+// Secondary command buffers recorded in parallel, one command pool per recording slot and frame in flight
+// A slot is only ever recorded by one thread at a time, so its pool needs no locking. The pools of a frame are reset
+// as a whole once its fence is signaled, their command buffers are kept and handed out again
+class VulkanSecondaryCommandPools {
+public:
+    VulkanSecondaryCommandPools()  = default;
+    ~VulkanSecondaryCommandPools() = default;
+
+    VulkanSecondaryCommandPools(const VulkanSecondaryCommandPools&)            = delete;
+    VulkanSecondaryCommandPools& operator=(const VulkanSecondaryCommandPools&) = delete;
+
+    VulkanSecondaryCommandPools(VulkanSecondaryCommandPools&&)            = delete;
+    VulkanSecondaryCommandPools& operator=(VulkanSecondaryCommandPools&&) = delete;
+
+    [[nodiscard]] Expected<void> create(
+        const VulkanDevice& device, std::uint32_t framesInFlight, std::uint32_t slotCount
+    ) noexcept;
+
+    void destroy() noexcept;
+
+    // Recycles every command buffer of the frame, its previous submission must be complete
+    [[nodiscard]] Expected<void> reset(std::uint32_t frameIndex);
+
+    // Next unused command buffer of the slot, allocated on first use
+    [[nodiscard]] Expected<vk::CommandBuffer> acquire(std::uint32_t frameIndex, std::uint32_t slot);
+
+    [[nodiscard]] std::uint32_t getSlotCount() const noexcept { return _slotCount; }
+
+private:
+    struct SlotPool {
+        vk::CommandPool                commandPool{};
+        std::vector<vk::CommandBuffer> commandBuffers{};
+        std::uint32_t                  usedCount = 0;
+    };
+
+    [[nodiscard]] SlotPool& getSlotPool(std::uint32_t frameIndex, std::uint32_t slot) noexcept;
+
+    const VulkanDevice* _device = nullptr;
+
+    std::uint32_t _slotCount = 0;
+
+    // Indexed by frameIndex * _slotCount + slot
+    std::vector<SlotPool> _slotPools{};
+};
@@ -2,8 +2,6 @@
 
 #include "graphics/vulkan/common/VulkanDebugger.h"
 
-#include <ranges>
-
 void VulkanPipeline::destroy() noexcept {
     if (!_device) return;
 
@@ -25,7 +23,7 @@ Expected<void> VulkanPipeline::createPipelineLayout(
 ) {
     std::vector<vk::PushConstantRange> pushConstantRanges{};
 
-    for (const auto& [stageFlags, offset, size] : descriptor.pushConstantRanges | std::views::values) {
+    for (const auto& [stageFlags, offset, size] : descriptor.pushConstants.getRanges()) {
         pushConstantRanges.emplace_back(stageFlags, offset, size);
     }
 
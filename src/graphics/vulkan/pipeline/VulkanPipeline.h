@@ -8,7 +8,7 @@
 
 struct VulkanPipelineLayoutDescriptor {
     std::vector<vk::DescriptorSetLayout> descriptorLayouts{};
-    VulkanPushConstantsMap               pushConstantRanges{};
+    VulkanPushConstantLayout             pushConstants{};
 };
 
 class VulkanPipeline {
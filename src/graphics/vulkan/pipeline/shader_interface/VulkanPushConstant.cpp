@@ -0,0 +1,40 @@
+#include "VulkanPushConstant.h"
+
+#include <algorithm>
+#include <vector>
+
+Expected<void> VulkanPushConstantLayout::compile(const VulkanPushConstantsMap& pushConstants) {
+    if (pushConstants.size() > MAX_RANGES) {
+        return VK_FAIL("Failed to compile push constant layout: exceeded maximum push constant ranges.");
+    }
+
+    // Ordered by offset, ranges are pushed in memory order
+    std::vector<std::pair<std::string, VulkanPushConstantRange>> sorted(pushConstants.begin(), pushConstants.end());
+
+    std::ranges::sort(sorted, {}, [](const auto& pushConstant) { return pushConstant.second.offset; });
+
+    _rangeCount = 0;
+    _size       = 0;
+
+    for (const auto& [name, range] : sorted) {
+        if (range.offset + range.size > MAX_SIZE) {
+            return VK_FAIL("Failed to compile push constant layout: \"" + name + "\" exceeds the push constant size.");
+        }
+
+        _names[_rangeCount]  = name;
+        _ranges[_rangeCount] = range;
+        _rangeCount++;
+
+        _size = std::max(_size, range.offset + range.size);
+    }
+
+    return {};
+}
+
+std::optional<std::uint32_t> VulkanPushConstantLayout::findRange(const std::string& name) const noexcept {
+    for (std::uint32_t i = 0; i < _rangeCount; i++) {
+        if (_names[i] == name) return i;
+    }
+
+    return std::nullopt;
+}
@@ -1,7 +1,13 @@
 #pragma once
 
+#include "core/debug/ErrorHandling.h"
+
 #include "graphics/vulkan/common/VulkanHeader.h"
 
+#include <array>
+#include <optional>
+#include <span>
+#include <string>
 #include <unordered_map>
 
 struct VulkanPushConstantRange {
@@ -10,9 +16,34 @@ struct VulkanPushConstantRange {
     std::uint32_t        size   = 0;
 };
 
-struct VulkanPushConstant {
-    const void*             data = nullptr;
-    VulkanPushConstantRange range{};
-};
-
+// Reflected push constant blocks by name, a block shared by several stages holds all of them
 using VulkanPushConstantsMap = std::unordered_map<std::string, VulkanPushConstantRange>;
+
+// Push constant blocks of a pipeline layout compiled into a flat table ordered by offset
+// Names are only resolved when draws are set up, draws refer to ranges by index and pack their values in a byte blob
+// laid out like the push constant block
+class VulkanPushConstantLayout {
+public:
+    static constexpr std::uint32_t MAX_RANGES = 8;
+
+    // Minimum maxPushConstantsSize guaranteed by every device
+    static constexpr std::uint32_t MAX_SIZE = 128;
+
+    [[nodiscard]] Expected<void> compile(const VulkanPushConstantsMap& pushConstants);
+
+    [[nodiscard]] std::optional<std::uint32_t> findRange(const std::string& name) const noexcept;
+
+    [[nodiscard]] std::span<const VulkanPushConstantRange> getRanges() const noexcept {
+        return std::span(_ranges).first(_rangeCount);
+    }
+
+    // End of the last range, bytes of the blob that are pushed
+    [[nodiscard]] std::uint32_t getSize() const noexcept { return _size; }
+
+private:
+    std::array<VulkanPushConstantRange, MAX_RANGES> _ranges{};
+    std::array<std::string, MAX_RANGES>             _names{};
+
+    std::uint32_t _rangeCount = 0;
+    std::uint32_t _size       = 0;
+};
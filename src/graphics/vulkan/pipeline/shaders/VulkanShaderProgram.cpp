@@ -2,6 +2,7 @@
 
 #include "graphics/vulkan/common/VulkanDebugger.h"
 
+#include <algorithm>
 #include <filesystem>
 #include <fstream>
 #include <ranges>
@@ -120,13 +121,22 @@ Expected<void> VulkanShaderProgram::reflectShaderResources(
     for (const auto& pushConstant : pushConstants) {
         const std::string& name = pushConstant->name;
 
-        const VulkanPushConstantRange pushConstantRange{
+        const auto [cachedRange, inserted] = _pushConstants.try_emplace(name, VulkanPushConstantRange{
             .stageFlags = stage,
-            .offset     = 0,
+            .offset     = pushConstant->offset,
             .size       = pushConstant->size
-        };
+        });
 
-        _pushConstants[name] = pushConstantRange;
+        // Block shared with a previous stage, a single range covers both
+        if (!inserted) {
+            VulkanPushConstantRange& range = cachedRange->second;
+
+            const std::uint32_t end = std::max(range.offset + range.size, pushConstant->offset + pushConstant->size);
+
+            range.stageFlags |= stage;
+            range.offset      = std::min(range.offset, pushConstant->offset);
+            range.size        = end - range.offset;
+        }
     }
 
     spvReflectDestroyShaderModule(&module);
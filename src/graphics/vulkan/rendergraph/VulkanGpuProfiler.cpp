@@ -0,0 +1,207 @@
+#include "VulkanGpuProfiler.h"
+
+#include <algorithm>
+#include <filesystem>
+
+namespace {
+
+// Pass names are written quoted, quotes and backslashes are escaped the JSON way and doubled the CSV way
+std::string quote(const std::string& name, const VulkanGpuProfiler::DumpFormat format) {
+    std::string quoted = "\"";
+
+    for (const char c : name) {
+        if (c == '"') {
+            quoted += format == VulkanGpuProfiler::DumpFormat::Json ? "\\\"" : "\"\"";
+        } else if (c == '\\' && format == VulkanGpuProfiler::DumpFormat::Json) {
+            quoted += "\\\\";
+        } else {
+            quoted += c;
+        }
+    }
+
+    return quoted + "\"";
+}
+
+}
+
+Expected<void> VulkanGpuProfiler::create(const VulkanDevice& device, const std::uint32_t framesInFlight) noexcept {
+    _frames.resize(framesInFlight);
+    _timestamps.resize(MAX_SCOPES * 2);
+    _durations.resize(MAX_SCOPES);
+
+    const auto queueFamilies = device.getPhysicalDevice().getQueueFamilyProperties();
+
+    const std::uint32_t validBits = queueFamilies[device.getQueueFamilyIndices().graphicsFamily].timestampValidBits;
+
+    // Passes are simply not timed without timestamps
+    if (validBits == 0) return {};
+
+    _timestampPeriod = device.getLimits().timestampPeriod;
+    _timestampMask   = validBits >= 64 ? ~std::uint64_t{0} : (std::uint64_t{1} << validBits) - 1;
+
+    TRY(_queries.create(device, vk::QueryType::eTimestamp, MAX_SCOPES * 2, framesInFlight));
+
+    return {};
+}
+
+void VulkanGpuProfiler::destroy() noexcept {
+    stopDump();
+
+    _queries.destroy();
+
+    _frames.clear();
+    _scopeIDs.clear();
+    _timings.clear();
+    _histories.clear();
+    _timestamps.clear();
+    _durations.clear();
+
+    _frameMs       = 0.0;
+    _timestampMask = 0;
+}
+
+void VulkanGpuProfiler::beginFrame(const vk::CommandBuffer commandBuffer, const std::uint32_t frameIndex) {
+    _frameIndex = frameIndex;
+    _frames[frameIndex].scopeIDs.clear();
+
+    if (!isSupported()) return;
+
+    _queries.reset(commandBuffer, frameIndex);
+}
+
+std::optional<std::uint32_t> VulkanGpuProfiler::beginScope(
+    const vk::CommandBuffer commandBuffer, const std::string& name
+) {
+    std::vector<std::uint32_t>& scopeIDs = _frames[_frameIndex].scopeIDs;
+
+    if (!isSupported() || scopeIDs.size() == MAX_SCOPES) return std::nullopt;
+
+    const auto scope = static_cast<std::uint32_t>(scopeIDs.size());
+    scopeIDs.push_back(getScopeID(name));
+
+    commandBuffer.writeTimestamp2(
+        vk::PipelineStageFlagBits2::eTopOfPipe, _queries.getQueryPool(), _queries.getQuery(_frameIndex, scope * 2)
+    );
+
+    return scope;
+}
+
+void VulkanGpuProfiler::endScope(const vk::CommandBuffer commandBuffer, const std::optional<std::uint32_t> scope) {
+    if (!scope) return;
+
+    commandBuffer.writeTimestamp2(
+        vk::PipelineStageFlagBits2::eBottomOfPipe, _queries.getQueryPool(),
+        _queries.getQuery(_frameIndex, *scope * 2 + 1)
+    );
+}
+
+Expected<void> VulkanGpuProfiler::collect(const std::uint32_t frameIndex) {
+    FrameScopes& frame = _frames[frameIndex];
+
+    if (frame.scopeIDs.empty()) return {};
+
+    const std::span timestamps = std::span(_timestamps).first(frame.scopeIDs.size() * 2);
+
+    bool available = false;
+    TRY_ASSIGN(available, _queries.read(frameIndex, timestamps));
+
+    if (available) {
+        _frameMs = 0.0;
+
+        for (std::size_t i = 0; i < frame.scopeIDs.size(); i++) {
+            const std::uint64_t ticks = (timestamps[i * 2 + 1] - timestamps[i * 2]) & _timestampMask;
+
+            _durations[i] = static_cast<double>(ticks) * _timestampPeriod / 1e6;
+            _frameMs     += _durations[i];
+
+            addSample(frame.scopeIDs[i], _durations[i]);
+        }
+
+        if (_dumpFile.is_open()) dumpFrame(frame);
+
+        _collectedCount++;
+    }
+
+    // A frame skipping its submission must not be collected twice
+    frame.scopeIDs.clear();
+
+    return {};
+}
+
+Expected<void> VulkanGpuProfiler::startDump(const std::string& path, const DumpFormat format) {
+    stopDump();
+
+    std::error_code error;
+    std::filesystem::create_directories(std::filesystem::path(path).parent_path(), error);
+
+    _dumpFile.open(path, std::ios::trunc);
+
+    if (!_dumpFile.is_open()) {
+        return FAIL("Failed to open \"" + path + "\" for writing", "VulkanGpuProfiler");
+    }
+
+    _dumpFormat = format;
+
+    if (format == DumpFormat::Csv) {
+        _dumpFile << "frame,pass,gpu_ms\n";
+    }
+
+    return {};
+}
+
+void VulkanGpuProfiler::stopDump() noexcept {
+    if (_dumpFile.is_open()) _dumpFile.close();
+}
+
+std::uint32_t VulkanGpuProfiler::getScopeID(const std::string& name) {
+    const auto [it, inserted] = _scopeIDs.try_emplace(name, static_cast<std::uint32_t>(_timings.size()));
+
+    if (inserted) {
+        _timings.push_back({name});
+        _histories.emplace_back();
+    }
+
+    return it->second;
+}
+
+void VulkanGpuProfiler::addSample(const std::uint32_t scopeID, const double milliseconds) {
+    History& history = _histories[scopeID];
+
+    history.samples[history.cursor] = milliseconds;
+    history.cursor                  = (history.cursor + 1) % HISTORY_SIZE;
+    history.count                   = std::min(history.count + 1, HISTORY_SIZE);
+
+    const auto samples = std::span(history.samples).first(history.count);
+
+    const auto [min, max] = std::minmax_element(samples.begin(), samples.end());
+
+    double sum = 0.0;
+    for (const double sample : samples) sum += sample;
+
+    ScopeTimings& timings = _timings[scopeID];
+    timings.lastMs = milliseconds;
+    timings.minMs  = *min;
+    timings.avgMs  = sum / history.count;
+    timings.maxMs  = *max;
+}
+
+void VulkanGpuProfiler::dumpFrame(const FrameScopes& frame) {
+    // CSV: one row per pass, JSON: one object per frame and line
+    if (_dumpFormat == DumpFormat::Json) {
+        _dumpFile << "{\"frame\":" << _collectedCount << ",\"passes\":[";
+    }
+
+    for (std::size_t i = 0; i < frame.scopeIDs.size(); i++) {
+        const std::string name = quote(_timings[frame.scopeIDs[i]].name, _dumpFormat);
+
+        if (_dumpFormat == DumpFormat::Csv) {
+            _dumpFile << _collectedCount << ',' << name << ',' << _durations[i] << '\n';
+        } else {
+            _dumpFile << (i == 0 ? "" : ",") << "{\"name\":" << name << ",\"gpu_ms\":" << _durations[i] << '}';
+        }
+    }
+
+    if (_dumpFormat == DumpFormat::Json) {
+        _dumpFile << "]}\n";
+    }
+}
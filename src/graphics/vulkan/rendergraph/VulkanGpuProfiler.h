@@ -0,0 +1,118 @@
+#pragma once
+
+#include "core/debug/ErrorHandling.h"
+
+#include "graphics/vulkan/common/VulkanHeader.h"
+
+#include "graphics/vulkan/core/VulkanQueryRing.h"
+
+#include <array>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// GPU time of the render graph passes, from timestamps written around each pass into a query ring
+// A frame is collected once its fence was waited on, durations are kept as rolling min/avg/max per pass name and can
+// be dumped per frame to a CSV or JSON lines file for offline analysis
+class VulkanGpuProfiler {
+public:
+    // Timed scopes per frame, the following ones are not timed
+    static constexpr std::uint32_t MAX_SCOPES = 64;
+
+    // Frames the rolling timings are taken over
+    static constexpr std::uint32_t HISTORY_SIZE = 120;
+
+    enum class DumpFormat : std::uint8_t { Csv, Json };
+
+    struct ScopeTimings {
+        std::string name{};
+
+        double lastMs = 0.0;
+        double minMs  = 0.0;
+        double avgMs  = 0.0;
+        double maxMs  = 0.0;
+    };
+
+    VulkanGpuProfiler()  = default;
+    ~VulkanGpuProfiler() = default;
+
+    VulkanGpuProfiler(const VulkanGpuProfiler&)            = delete;
+    VulkanGpuProfiler& operator=(const VulkanGpuProfiler&) = delete;
+
+    VulkanGpuProfiler(VulkanGpuProfiler&&)            = delete;
+    VulkanGpuProfiler& operator=(VulkanGpuProfiler&&) = delete;
+
+    [[nodiscard]] Expected<void> create(const VulkanDevice& device, std::uint32_t framesInFlight) noexcept;
+
+    void destroy() noexcept;
+
+    // Resets the queries of the frame, its previous timestamps must have been collected
+    void beginFrame(vk::CommandBuffer commandBuffer, std::uint32_t frameIndex);
+
+    // Scope to end, none when timestamps are unsupported or the frame has no scope left
+    [[nodiscard]] std::optional<std::uint32_t> beginScope(vk::CommandBuffer commandBuffer, const std::string& name);
+
+    void endScope(vk::CommandBuffer commandBuffer, std::optional<std::uint32_t> scope);
+
+    // Reads the last submission of the frame without waiting, unavailable timestamps drop the frame
+    [[nodiscard]] Expected<void> collect(std::uint32_t frameIndex);
+
+    // Every collected frame is appended to the file until stopDump()
+    [[nodiscard]] Expected<void> startDump(const std::string& path, DumpFormat format);
+
+    void stopDump() noexcept;
+
+    [[nodiscard]] bool isSupported() const noexcept { return _timestampMask != 0; }
+
+    // Per scope name, in first timed order
+    [[nodiscard]] const std::vector<ScopeTimings>& getTimings() const noexcept { return _timings; }
+
+    // Summed scope durations of the last collected frame, kept while frames are dropped
+    [[nodiscard]] double getFrameMs() const noexcept { return _frameMs; }
+
+private:
+    struct History {
+        std::array<double, HISTORY_SIZE> samples{};
+
+        std::uint32_t count  = 0;
+        std::uint32_t cursor = 0;
+    };
+
+    // Scope IDs timed by a frame, in query order
+    struct FrameScopes {
+        std::vector<std::uint32_t> scopeIDs{};
+    };
+
+    [[nodiscard]] std::uint32_t getScopeID(const std::string& name);
+
+    void addSample(std::uint32_t scopeID, double milliseconds);
+
+    // Writes the durations of the collected frame
+    void dumpFrame(const FrameScopes& frame);
+
+    VulkanQueryRing _queries{};
+
+    // Nanoseconds per tick, ticks wrap past the valid bits of the graphics queue
+    double        _timestampPeriod = 0.0;
+    std::uint64_t _timestampMask   = 0;
+
+    std::uint32_t _frameIndex = 0;
+
+    std::vector<FrameScopes> _frames{};
+
+    std::unordered_map<std::string, std::uint32_t> _scopeIDs{};
+
+    std::vector<ScopeTimings> _timings{};
+    std::vector<History>      _histories{};
+
+    // Begin and end pairs of the collected frame, and their durations in milliseconds
+    std::vector<std::uint64_t> _timestamps{};
+    std::vector<double>        _durations{};
+    double                     _frameMs = 0.0;
+
+    std::ofstream _dumpFile{};
+    DumpFormat    _dumpFormat     = DumpFormat::Csv;
+    std::uint64_t _collectedCount = 0;
+};
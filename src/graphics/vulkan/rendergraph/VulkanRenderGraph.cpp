@@ -2,11 +2,12 @@
 
 #include "graphics/vulkan/common/VulkanDebugger.h"
 
+#include "graphics/vulkan/pipeline/compute/VulkanComputePipeline.h"
 #include "graphics/vulkan/pipeline/graphics/VulkanGraphicsPipeline.h"
 #include "graphics/vulkan/rendergraph/resources/VulkanRenderResourceManager.h"
 
-#include "draw/VulkanDrawBatchBuilder.h"
-
+#include "core/debug/Profiler.h"
+#include "core/multithreading/ParallelFor.h"
 #include "core/render/BindingSlots.h"
 
 Expected<void> VulkanRenderGraph::create(const VulkanRenderGraphCreateContext& context) noexcept {
@@ -17,6 +18,13 @@ Expected<void> VulkanRenderGraph::create(const VulkanRenderGraphCreateContext& c
         context.device->getLogicalDevice(), vkGetDeviceProcAddr
     );
 
+    // Secondaries execute inside the primitives query, without inherited queries passes are recorded inline
+    if (context.commandPools && context.device->supportsInheritedQueries()) {
+        for (std::uint32_t slot = 0; slot < context.commandPools->getSlotCount(); slot++) {
+            _slotRecorders.push_back(std::make_unique<VulkanCommandRecorder>());
+        }
+    }
+
     return {};
 }
 
@@ -25,17 +33,16 @@ void VulkanRenderGraph::destroy() noexcept {
         pass->destroy();
     }
 
-    _passes.clear();
-}
-
-Expected<void> VulkanRenderGraph::execute(const vk::CommandBuffer commandBuffer) const {
-    commandBuffer.resetQueryPool(_context.queryPool, 0, 1);
-
-    for (const auto& pass : _passes) {
-        TRY(executePass(commandBuffer, *pass));
+    for (const auto& pass : _computePasses) {
+        pass->destroy();
     }
 
-    return {};
+    _nodes.clear();
+    _passes.clear();
+    _computePasses.clear();
+
+    _recordingJobs.clear();
+    _slotRecorders.clear();
 }
 
 namespace {
@@ -52,14 +59,123 @@ Expected<void> executePassTransitions(
     return {};
 }
 
+// One indirect count draw per pass group, commands and counts come from the draw cull pass
+void executeIndirectDraws(
+    VulkanCommandRecorder&      recorder,
+    const VulkanGraphicsPass&   pass,
+    const vk::Extent2D          extent,
+    const VulkanFrameResources* frame,
+    const VulkanFrameCuller*    frameCuller
+) {
+    const std::uint32_t frameIndex = frame->getFrameIndex();
+
+    const VulkanFrameCuller::GpuPassData* passData = frameCuller->getGpuPassData(&pass);
+
+    if (!passData || !passData->vertexBuffer || !passData->indexBuffer) return;
+
+    // The late phase commands and counts follow the early phase ones
+    const bool latePhase = pass.getGraphicsPassDescriptor().cullMode == VulkanGraphicsPassCullMode::GpuLate;
+
+    const std::uint32_t commandOffset = latePhase ? VulkanFrameCuller::MAX_GPU_DRAWS       : 0;
+    const std::uint32_t countOffset   = latePhase ? VulkanFrameCuller::MAX_GPU_DRAW_GROUPS : 0;
+
+    recorder.setViewport(vk::Viewport{
+        0.0f, 0.0f, static_cast<float>(extent.width), static_cast<float>(extent.height), 0.0f, 1.0f
+    });
+    recorder.setScissor(vk::Rect2D{vk::Offset2D(0, 0), extent});
+
+    // Offsets are baked into the commands
+    recorder.bindVertexBuffer(passData->vertexBuffer->handle());
+    recorder.bindIndexBuffer(passData->indexBuffer->handle(), 0, vk::IndexType::eUint32);
+
+    const vk::Buffer commandsBuffer = frameCuller->getGpuCommandBuffer()->getBuffers()[frameIndex].handle();
+    const vk::Buffer countBuffer    = frameCuller->getGpuCountBuffer()->getBuffers()[frameIndex].handle();
+
+    for (const auto& [firstCommand, maxDrawCount, countIndex] : passData->groups) {
+        recorder.getCommandBuffer().drawIndexedIndirectCount(
+            commandsBuffer, (commandOffset + firstCommand) * sizeof(vk::DrawIndexedIndirectCommand),
+            countBuffer,    (countOffset   + countIndex)   * sizeof(std::uint32_t),
+            maxDrawCount,   sizeof(vk::DrawIndexedIndirectCommand)
+        );
+    }
+}
+
+// A single multi-draw indirect, commands are written by the batch builder of the pass
+void executeDrawCommands(
+    VulkanCommandRecorder&      recorder,
+    const VulkanGraphicsPass&   pass,
+    const vk::Extent2D          extent,
+    const VulkanFrameResources* frame,
+    const VulkanFrameCuller*    frameCuller
+) {
+    const std::uint32_t frameIndex = frame->getFrameIndex();
+
+    const VulkanDrawBatchBuilder& batchBuilder = pass.getBatchBuilder();
+
+    recorder.setViewport(vk::Viewport{
+        0.0f, 0.0f, static_cast<float>(extent.width), static_cast<float>(extent.height), 0.0f, 1.0f
+    });
+    recorder.setScissor(vk::Rect2D{vk::Offset2D(0, 0), extent});
+
+    // Offsets are baked into the commands
+    recorder.bindVertexBuffer(batchBuilder.getVertexBuffer()->handle());
+    recorder.bindIndexBuffer(batchBuilder.getIndexBuffer()->handle(), 0, vk::IndexType::eUint32);
+
+    const vk::Buffer commandsBuffer = frameCuller->getDrawCommandBuffer()->getBuffers()[frameIndex].handle();
+
+    recorder.getCommandBuffer().drawIndexedIndirect(
+        commandsBuffer,                 batchBuilder.getCommandOffset() * sizeof(vk::DrawIndexedIndirectCommand),
+        batchBuilder.getCommandCount(), sizeof(vk::DrawIndexedIndirectCommand)
+    );
+}
+
+void prepareDrawCalls(
+    VulkanGraphicsPass& pass, const VulkanFrameResources* frame, const VulkanFrameCuller* frameCuller
+) {
+    const VulkanGraphicsPassCullMode cullMode = pass.getGraphicsPassDescriptor().cullMode;
+
+    // Written by the draw cull pass for GPU culled passes
+    if (cullMode == VulkanGraphicsPassCullMode::Gpu || cullMode == VulkanGraphicsPassCullMode::GpuLate) return;
+
+    // Update draw batches and the indirection entries this frame copy is missing
+    VulkanDrawBatchBuilder& batchBuilder = pass.getBatchBuilder();
+
+    batchBuilder.build(
+        frameCuller->getDrawCalls(&pass), pass.getGraphicsPipeline(), frameCuller->getCameraPosition(),
+        frameCuller->getIndirectionOffset(&pass), frameCuller->getCommandOffset(&pass)
+    );
+
+    batchBuilder.upload({
+        frameCuller->getIndirectionBuffer(), frameCuller->getInstanceMaterialBuffer(),
+        frameCuller->getDrawCommandBuffer()
+    }, frame->getFrameIndex());
+}
+
+// Batches drawn one by one, zero when the pass draws indirectly
+std::uint32_t getDirectBatchCount(const VulkanGraphicsPass& pass) {
+    const VulkanGraphicsPassCullMode cullMode = pass.getGraphicsPassDescriptor().cullMode;
+
+    if (cullMode == VulkanGraphicsPassCullMode::Gpu || cullMode == VulkanGraphicsPassCullMode::GpuLate) return 0;
+
+    const VulkanDrawBatchBuilder& batchBuilder = pass.getBatchBuilder();
+
+    if (batchBuilder.hasDrawCommands()) return 0;
+
+    return static_cast<std::uint32_t>(batchBuilder.getBuiltDrawBatches().size());
+}
+
+// Draws of a prepared pass, direct batches are limited to [firstBatch, lastBatch)
 void executeDrawCalls(
-    const vk::CommandBuffer                  commandBuffer,
+    VulkanCommandRecorder&                   recorder,
     const VulkanGraphicsPass&                pass,
     const vk::Extent2D                       extent,
     const vk::detail::DispatchLoaderDynamic& dispatchLoader,
     const VulkanFrameResources*              frame,
     const VulkanFrameCuller*                 frameCuller,
-    const VulkanRenderObjectManager*         renderObjectManager
+    const VulkanRenderObjectManager*         renderObjectManager,
+    const VulkanMaterialManager*             materialManager,
+    const std::uint32_t                      firstBatch,
+    const std::uint32_t                      lastBatch
 ) {
     const std::uint32_t frameIndex = frame->getFrameIndex();
 
@@ -69,66 +185,198 @@ void executeDrawCalls(
 
     // Bind pipeline
 
-    commandBuffer.bindPipeline(pipelineBindPoint, pipeline->handle());
+    recorder.bindPipeline(pipelineBindPoint, pipeline->handle());
 
-    // Build draw batches and update the indirection buffer
-    const std::uint32_t indirectionOffset = frameCuller->getIndirectionOffset(&pass);
+    const VulkanGraphicsPassCullMode cullMode = pass.getGraphicsPassDescriptor().cullMode;
 
-    VulkanDrawBatchBuilder batchBuilder;
-    batchBuilder.build(frameCuller->getDrawCalls(&pass), indirectionOffset);
+    const bool gpuCulled = cullMode == VulkanGraphicsPassCullMode::Gpu
+                        || cullMode == VulkanGraphicsPassCullMode::GpuLate;
 
-    frameCuller->getIndirectionBuffer()->updateArrayMemory(frameIndex, batchBuilder.getIndirectionData(), indirectionOffset);
+    const VulkanDrawBatchBuilder& batchBuilder = pass.getBatchBuilder();
 
     const std::array fixedSets = {
         frame->getDescriptorSets()->getSet(frameIndex),               // slot 0: FrameData
         renderObjectManager->getDescriptorSets()->getSet(frameIndex), // slot 1: ObjectData
         frameCuller->getDescriptorSets()->getSet(frameIndex),         // slot 2: CullingData
     };
-    commandBuffer.bindDescriptorSets(pipelineBindPoint, pipelineLayout, 0, fixedSets, nullptr);
+    recorder.bindDescriptorSets(pipelineBindPoint, pipelineLayout, 0, fixedSets);
 
     // slot 3: PassData
     if (const VulkanDescriptorSets* passDataSets = pass.base().getDescriptorSets()) {
-        commandBuffer.bindDescriptorSets(
+        recorder.bindDescriptorSet(
             pipelineBindPoint, pipelineLayout,
             BindingSlots::PassData,
-            passDataSets->getSet(frameIndex),
-            nullptr
+            passDataSets->getSet(frameIndex)
         );
     }
 
-    for (auto& [drawCall, firstInstance, instanceCount] : batchBuilder.getBuiltDrawBatches()) {
+    // slot 4: MaterialData, bindless so draws only index it
+    recorder.bindDescriptorSet(
+        pipelineBindPoint, pipelineLayout,
+        BindingSlots::MaterialData,
+        materialManager->getDescriptorSets()->getSet(frameIndex)
+    );
+
+    if (gpuCulled) {
+        executeIndirectDraws(recorder, pass, extent, frame, frameCuller);
+        return;
+    }
+
+    if (batchBuilder.hasDrawCommands()) {
+        executeDrawCommands(recorder, pass, extent, frame, frameCuller);
+        return;
+    }
+
+    const std::vector<VulkanDrawBatchBuilder::BuiltDrawBatch>& batches = batchBuilder.getBuiltDrawBatches();
+
+    const std::uint32_t batchCount = static_cast<std::uint32_t>(batches.size());
+
+    for (std::uint32_t i = firstBatch; i < std::min(lastBatch, batchCount); i++) {
+        const auto& [drawCall, firstInstance, instanceCount] = batches[i];
+
         auto& draw = *drawCall;
 
 #ifdef VULKAN_DEBUG_UTILS
-        VulkanDebugger::beginLabel(commandBuffer, dispatchLoader, draw.getName());
+        VulkanDebugger::beginLabel(recorder.getCommandBuffer(), dispatchLoader, draw.getName());
 #endif
 
-        // slot 4: MaterialData
-        if (const VulkanMaterial* material = draw.getRenderMesh().material) {
-            const vk::DescriptorSet materialSet = material->getDescriptorSets()->getSet(frameIndex);
-            commandBuffer.bindDescriptorSets(
-                pipelineBindPoint, pipelineLayout, BindingSlots::MaterialData, materialSet, nullptr
-            );
-        }
-
         // Draw mesh
 
-        draw.record(commandBuffer, extent, pipelineLayout, instanceCount, firstInstance);
+        draw.record(recorder, extent, pipelineLayout, instanceCount, firstInstance);
 
 #ifdef VULKAN_DEBUG_UTILS
-        VulkanDebugger::endLabel(commandBuffer, dispatchLoader);
+        VulkanDebugger::endLabel(recorder.getCommandBuffer(), dispatchLoader);
 #endif
     }
 }
 
+// Formats the secondary command buffers of a pass are recorded for
+void getAttachmentFormats(
+    const VulkanGraphicsPass& pass, std::vector<vk::Format>& colorFormats, vk::Format& depthFormat
+) {
+    for (const auto& colorAttachment : pass.getColorAttachments()) {
+        colorFormats.push_back(colorAttachment->resource->resolveImage()->getFormat());
+    }
+
+    if (pass.getDepthAttachment()) {
+        depthFormat = pass.getDepthAttachment()->resource->resolveImage()->getFormat();
+    }
+}
+
+}
+
+Expected<void> VulkanRenderGraph::execute(const vk::CommandBuffer commandBuffer) {
+    _recorder.begin(commandBuffer);
+    _recorder.resetStats();
+
+    for (const auto& recorder : _slotRecorders) {
+        recorder->resetStats();
+    }
+
+    // Batches are built and uploaded serially, draws are then recorded into secondaries when possible
+    for (const VulkanRenderGraphNode& node : _nodes) {
+        if (node.pass) prepareDrawCalls(*node.pass, _context.frame, _context.frameCuller);
+    }
+
+    const bool parallelRecording = !_slotRecorders.empty();
+
+    if (parallelRecording) {
+        TRY(recordSecondaryCommandBuffers());
+    }
+
+    const std::uint32_t frameIndex = _context.frame->getFrameIndex();
+
+    // Only the query of this frame is reset, the others may still be pending or unread
+    const std::uint32_t primitivesQuery = _context.statisticsQueries->getQuery(frameIndex, 0);
+
+    _context.statisticsQueries->reset(commandBuffer, frameIndex);
+
+    _context.profiler->beginFrame(commandBuffer, frameIndex);
+
+    // The primitives query spans every mesh pass, nodes in between are included
+    std::size_t firstMeshNode = _nodes.size();
+    std::size_t lastMeshNode  = _nodes.size();
+
+    for (std::size_t i = 0; i < _nodes.size(); i++) {
+        if (!_nodes[i].pass || _nodes[i].pass->getGraphicsPassDescriptor().type != VulkanGraphicsPassType::MeshRender)
+            continue;
+
+        if (firstMeshNode == _nodes.size()) firstMeshNode = i;
+        lastMeshNode = i;
+    }
+
+    // Jobs of a pass are contiguous and in node order
+    std::size_t                    nextJob = 0;
+    std::vector<vk::CommandBuffer> secondaries{};
+
+    for (std::size_t i = 0; i < _nodes.size(); i++) {
+        const VulkanRenderGraphNode& node = _nodes[i];
+
+        if (i == firstMeshNode)
+            commandBuffer.beginQuery(_context.statisticsQueries->getQueryPool(), primitivesQuery, {});
+
+        if (node.computePass) {
+            TRY(executeComputePass(_recorder, *node.computePass));
+
+            // Make compute results visible to indirect draws, shaders, the following dispatches
+            // and to the host reading back the cull statistics once the frame fence is signaled
+            vk::MemoryBarrier2 computeBarrier{};
+            computeBarrier
+                .setSrcStageMask(vk::PipelineStageFlagBits2::eComputeShader)
+                .setSrcAccessMask(vk::AccessFlagBits2::eShaderStorageWrite)
+                .setDstStageMask(
+                    vk::PipelineStageFlagBits2::eDrawIndirect   |
+                    vk::PipelineStageFlagBits2::eVertexShader   |
+                    vk::PipelineStageFlagBits2::eFragmentShader |
+                    vk::PipelineStageFlagBits2::eComputeShader  |
+                    vk::PipelineStageFlagBits2::eHost
+                )
+                .setDstAccessMask(
+                    vk::AccessFlagBits2::eIndirectCommandRead |
+                    vk::AccessFlagBits2::eShaderRead          |
+                    vk::AccessFlagBits2::eShaderStorageWrite  |
+                    vk::AccessFlagBits2::eHostRead
+                );
+
+            vk::DependencyInfo dependencyInfo{};
+            dependencyInfo.setMemoryBarriers(computeBarrier);
+
+            commandBuffer.pipelineBarrier2(dependencyInfo);
+        } else {
+            secondaries.clear();
+
+            for (; parallelRecording && nextJob < _recordingJobs.size(); nextJob++) {
+                if (_recordingJobs[nextJob].pass != node.pass) break;
+                secondaries.push_back(_recordingJobs[nextJob].commandBuffer);
+            }
+
+            TRY(executePass(_recorder, *node.pass, secondaries));
+        }
+
+        if (i == lastMeshNode)
+            commandBuffer.endQuery(_context.statisticsQueries->getQueryPool(), primitivesQuery);
+    }
+
+    _recordingStats = _recorder.getStats();
+
+    for (const auto& recorder : _slotRecorders) {
+        _recordingStats += recorder->getStats();
+    }
+
+    return {};
 }
 
 Expected<void> VulkanRenderGraph::executePass(
-    const vk::CommandBuffer commandBuffer, const VulkanGraphicsPass& pass
+    VulkanCommandRecorder&                   recorder,
+    const VulkanGraphicsPass&                pass,
+    const std::span<const vk::CommandBuffer> secondaries
 ) const {
+    const vk::CommandBuffer commandBuffer = recorder.getCommandBuffer();
+
     const vk::Extent2D extent = _context.swapchain->getExtent();
 
-    const bool isMeshPass = pass.getGraphicsPassDescriptor().type == VulkanGraphicsPassType::MeshRender;
+    // Timed along with its transitions
+    const auto profilerScope = _context.profiler->beginScope(commandBuffer, pass.getGraphicsPassDescriptor().base.name);
 
     // Transition resources for current pass
     TRY(executePassTransitions(commandBuffer, pass.base().getEntryTransitions()));
@@ -139,13 +387,17 @@ Expected<void> VulkanRenderGraph::executePass(
         colorAttachments.push_back(colorAttachment->getInfo());
     }
 
-    // Rendering info
+    // Rendering info, draws recorded in secondary command buffers are only executed
     vk::RenderingInfo renderingInfo{};
     renderingInfo
         .setRenderArea({{0, 0}, extent})
         .setLayerCount(1)
         .setColorAttachments(colorAttachments);
 
+    if (!secondaries.empty()) {
+        renderingInfo.setFlags(vk::RenderingFlagBits::eContentsSecondaryCommandBuffers);
+    }
+
     // Depth attachment
     if (pass.getDepthAttachment()) {
         vk::RenderingAttachmentInfo depthAttachment = pass.getDepthAttachment()->getInfo();
@@ -159,14 +411,19 @@ Expected<void> VulkanRenderGraph::executePass(
 
     commandBuffer.beginRendering(renderingInfo);
 
-    if (isMeshPass)
-        commandBuffer.beginQuery(_context.queryPool, 0, {});
-
     // Draw calls
-    executeDrawCalls(commandBuffer, pass, extent, _context.dispatchLoader, _context.frame, _context.frameCuller, _context.renderObjectManager);
+    if (secondaries.empty()) {
+        executeDrawCalls(
+            recorder, pass, extent, _context.dispatchLoader, _context.frame, _context.frameCuller,
+            _context.renderObjectManager, _context.materialManager, 0, UINT32_MAX
+        );
+    } else {
+        commandBuffer.executeCommands(secondaries);
 
-    if (isMeshPass)
-        commandBuffer.endQuery(_context.queryPool, 0);
+        // State bound in the primary command buffer is undefined after executing secondaries
+        recorder.invalidate(vk::PipelineBindPoint::eGraphics);
+        recorder.invalidate(vk::PipelineBindPoint::eCompute);
+    }
 
     // Stop rendering
     commandBuffer.endRendering();
@@ -178,5 +435,185 @@ Expected<void> VulkanRenderGraph::executePass(
     // Transition resources for next pass
     TRY(executePassTransitions(commandBuffer, pass.base().getExitTransitions()));
 
+    _context.profiler->endScope(commandBuffer, profilerScope);
+
+    return {};
+}
+
+Expected<void> VulkanRenderGraph::recordSecondaryCommandBuffers() {
+    const std::uint32_t frameIndex = _context.frame->getFrameIndex();
+
+    TRY(_context.commandPools->reset(frameIndex));
+
+    // Jobs in node order, direct batches of large passes are split into ranges
+    _recordingJobs.clear();
+
+    for (const VulkanRenderGraphNode& node : _nodes) {
+        if (!node.pass) continue;
+
+        const std::uint32_t batchCount = getDirectBatchCount(*node.pass);
+
+        if (batchCount <= BATCHES_PER_RECORDING_JOB) {
+            _recordingJobs.push_back({node.pass, 0, UINT32_MAX});
+            continue;
+        }
+
+        for (std::uint32_t firstBatch = 0; firstBatch < batchCount; firstBatch += BATCHES_PER_RECORDING_JOB) {
+            _recordingJobs.push_back({node.pass, firstBatch, firstBatch + BATCHES_PER_RECORDING_JOB});
+        }
+    }
+
+    // Each slot records one contiguous range of jobs, so a slot pool is never used by two threads at once
+    const std::size_t slotCount = _slotRecorders.size();
+    const std::size_t grain     = (_recordingJobs.size() + slotCount - 1) / slotCount;
+
+    std::vector<Expected<void>> results(slotCount);
+
+    ParallelFor::forEachRange(_recordingJobs.size(), grain, [&](const std::size_t begin, const std::size_t end) {
+        const auto slot = static_cast<std::uint32_t>(begin / grain);
+
+        PROFILE_ZONE("RecordSecondaries");
+
+        for (std::size_t i = begin; i < end; i++) {
+            Expected<void> result = recordJob(*_slotRecorders[slot], _recordingJobs[i], frameIndex, slot);
+
+            if (!result) {
+                results[slot] = std::move(result);
+                return;
+            }
+        }
+    });
+
+    for (Expected<void>& result : results) {
+        TRY(std::move(result));
+    }
+
+    return {};
+}
+
+Expected<void> VulkanRenderGraph::recordJob(
+    VulkanCommandRecorder& recorder, RecordingJob& job, const std::uint32_t frameIndex, const std::uint32_t slot
+) const {
+    const VulkanGraphicsPass& pass = *job.pass;
+
+    TRY_ASSIGN(job.commandBuffer, _context.commandPools->acquire(frameIndex, slot));
+
+    std::vector<vk::Format> colorFormats{};
+    vk::Format              depthFormat = vk::Format::eUndefined;
+    getAttachmentFormats(pass, colorFormats, depthFormat);
+
+    // Flags must match the rendering info of the pass, minus the secondary contents bit
+    vk::CommandBufferInheritanceRenderingInfo inheritanceRenderingInfo{};
+    inheritanceRenderingInfo
+        .setColorAttachmentFormats(colorFormats)
+        .setDepthAttachmentFormat(depthFormat)
+        .setRasterizationSamples(vk::SampleCountFlagBits::e1);
+
+    // Mesh passes run inside the primitives query
+    vk::CommandBufferInheritanceInfo inheritanceInfo{};
+    inheritanceInfo
+        .setPNext(&inheritanceRenderingInfo)
+        .setPipelineStatistics(vk::QueryPipelineStatisticFlagBits::eInputAssemblyPrimitives);
+
+    vk::CommandBufferBeginInfo beginInfo{};
+    beginInfo
+        .setFlags(
+            vk::CommandBufferUsageFlagBits::eRenderPassContinue |
+            vk::CommandBufferUsageFlagBits::eOneTimeSubmit
+        )
+        .setPInheritanceInfo(&inheritanceInfo);
+
+    VK_TRY(job.commandBuffer.begin(beginInfo));
+
+    recorder.begin(job.commandBuffer);
+
+    executeDrawCalls(
+        recorder, pass, _context.swapchain->getExtent(), _context.dispatchLoader, _context.frame,
+        _context.frameCuller, _context.renderObjectManager, _context.materialManager, job.firstBatch, job.lastBatch
+    );
+
+    VK_TRY(job.commandBuffer.end());
+
+    return {};
+}
+
+Expected<void> VulkanRenderGraph::executeComputePass(
+    VulkanCommandRecorder& recorder, const VulkanComputePass& pass
+) const {
+    const VulkanComputePipeline* pipeline = pass.getComputePipeline();
+
+    if (!pipeline) return {};
+
+    const vk::CommandBuffer commandBuffer = recorder.getCommandBuffer();
+
+    const std::uint32_t frameIndex = _context.frame->getFrameIndex();
+
+    const vk::PipelineLayout&    pipelineLayout    = pipeline->getLayout();
+    const vk::PipelineBindPoint& pipelineBindPoint = VulkanComputePipeline::getBindPoint();
+
+    const auto profilerScope = _context.profiler->beginScope(commandBuffer, pass.getComputePassDescriptor().base.name);
+
+    TRY(executePassTransitions(commandBuffer, pass.base().getEntryTransitions()));
+
+#ifdef VULKAN_DEBUG_UTILS
+    VulkanDebugger::beginLabel(commandBuffer, _context.dispatchLoader, pass.getComputePassDescriptor().base.name);
+#endif
+
+    recorder.bindPipeline(pipelineBindPoint, pipeline->handle());
+
+    const std::array fixedSets = {
+        _context.frame->getDescriptorSets()->getSet(frameIndex),               // slot 0: FrameData
+        _context.renderObjectManager->getDescriptorSets()->getSet(frameIndex), // slot 1: ObjectData
+        _context.frameCuller->getDescriptorSets()->getSet(frameIndex),         // slot 2: CullingData
+    };
+    recorder.bindDescriptorSets(pipelineBindPoint, pipelineLayout, 0, fixedSets);
+
+    // slot 3: PassData
+    if (const VulkanDescriptorSets* passDataSets = pass.base().getDescriptorSets()) {
+        recorder.bindDescriptorSet(
+            pipelineBindPoint, pipelineLayout,
+            BindingSlots::PassData,
+            passDataSets->getSet(frameIndex)
+        );
+    }
+
+    for (const auto& [name, groupCountX, groupCountY, groupCountZ, passDataSets, barrier] : pass.getDispatchCalls()) {
+        if (groupCountX == 0 || groupCountY == 0 || groupCountZ == 0) continue;
+
+        // Dispatches reading the results of the previous ones
+        if (barrier) {
+            vk::MemoryBarrier2 dispatchBarrier{};
+            dispatchBarrier
+                .setSrcStageMask(vk::PipelineStageFlagBits2::eComputeShader)
+                .setSrcAccessMask(vk::AccessFlagBits2::eShaderStorageWrite)
+                .setDstStageMask(vk::PipelineStageFlagBits2::eComputeShader)
+                .setDstAccessMask(vk::AccessFlagBits2::eShaderRead);
+
+            vk::DependencyInfo dependencyInfo{};
+            dependencyInfo.setMemoryBarriers(dispatchBarrier);
+
+            commandBuffer.pipelineBarrier2(dependencyInfo);
+        }
+
+        // slot 3: PassData, per dispatch
+        if (passDataSets) {
+            recorder.bindDescriptorSet(
+                pipelineBindPoint, pipelineLayout,
+                BindingSlots::PassData,
+                passDataSets->getSet(frameIndex)
+            );
+        }
+
+        commandBuffer.dispatch(groupCountX, groupCountY, groupCountZ);
+    }
+
+#ifdef VULKAN_DEBUG_UTILS
+    VulkanDebugger::endLabel(commandBuffer, _context.dispatchLoader);
+#endif
+
+    TRY(executePassTransitions(commandBuffer, pass.base().getExitTransitions()));
+
+    _context.profiler->endScope(commandBuffer, profilerScope);
+
     return {};
 }
@@ -5,17 +5,30 @@
 #include "graphics/vulkan/common/VulkanHeader.h"
 
 #include "graphics/vulkan/core/VulkanInstance.h"
+#include "graphics/vulkan/core/VulkanQueryRing.h"
+#include "graphics/vulkan/core/VulkanSecondaryCommandPools.h"
 #include "graphics/vulkan/core/VulkanSwapchain.h"
 
 #include "graphics/vulkan/resources/frame/VulkanFrameResources.h"
 
+#include "VulkanGpuProfiler.h"
+
+#include "draw/VulkanCommandRecorder.h"
 #include "draw/VulkanFrameCuller.h"
+#include "nodes/VulkanComputePass.h"
 #include "nodes/VulkanPass.h"
 
+#include "graphics/vulkan/resources/materials/VulkanMaterialManager.h"
 #include "graphics/vulkan/resources/objects/VulkanRenderObjectManager.h"
 
 class VulkanRenderResourceManager;
 
+// Graph nodes in declaration order, either a graphics or a compute pass
+struct VulkanRenderGraphNode {
+    VulkanGraphicsPass*       pass        = nullptr;
+    const VulkanComputePass*  computePass = nullptr;
+};
+
 struct VulkanRenderGraphCreateContext {
     const VulkanInstance*             instance    = nullptr;
     const VulkanDevice*               device      = nullptr;
@@ -24,8 +37,17 @@ struct VulkanRenderGraphCreateContext {
     VulkanFrameResources*             frame               = nullptr;
     const VulkanFrameCuller*          frameCuller         = nullptr;
     const VulkanRenderObjectManager*  renderObjectManager = nullptr;
+    const VulkanMaterialManager*      materialManager     = nullptr;
+
+    // Optional, passes are recorded into the primary command buffer without
+    VulkanSecondaryCommandPools*      commandPools        = nullptr;
+
+    // Primitives pipeline statistics, one query per frame in flight
+    VulkanQueryRing*                  statisticsQueries   = nullptr;
+
+    // Times every pass
+    VulkanGpuProfiler*                profiler            = nullptr;
 
-    vk::QueryPool                     queryPool;
     vk::detail::DispatchLoaderDynamic dispatchLoader{};
 };
 
@@ -44,19 +66,76 @@ public:
 
     void destroy() noexcept;
 
-    Expected<void> execute(vk::CommandBuffer commandBuffer) const;
+    Expected<void> execute(vk::CommandBuffer commandBuffer);
+
+    // Draws are recorded inline, or executed from the secondaries recorded for the pass
+    Expected<void> executePass(
+        VulkanCommandRecorder&             recorder,
+        const VulkanGraphicsPass&          pass,
+        std::span<const vk::CommandBuffer> secondaries = {}
+    ) const;
 
-    Expected<void> executePass(vk::CommandBuffer commandBuffer, const VulkanGraphicsPass& pass) const;
+    Expected<void> executeComputePass(VulkanCommandRecorder& recorder, const VulkanComputePass& pass) const;
+
+    // Issued and elided state calls of the last executed frame, over the primary and every secondary
+    [[nodiscard]] const VulkanCommandRecorder::Stats& getRecordingStats() const noexcept { return _recordingStats; }
 
     [[nodiscard]]       std::vector<std::unique_ptr<VulkanGraphicsPass>>& getPasses()       noexcept { return _passes; }
     [[nodiscard]] const std::vector<std::unique_ptr<VulkanGraphicsPass>>& getPasses() const noexcept { return _passes; }
 
+    [[nodiscard]]       std::vector<std::unique_ptr<VulkanComputePass>>& getComputePasses()       noexcept {
+        return _computePasses;
+    }
+    [[nodiscard]] const std::vector<std::unique_ptr<VulkanComputePass>>& getComputePasses() const noexcept {
+        return _computePasses;
+    }
+
     void addPass(std::unique_ptr<VulkanGraphicsPass> pass) {
         _passes.push_back(std::move(pass));
     }
 
+    void addComputePass(std::unique_ptr<VulkanComputePass> pass) {
+        _computePasses.push_back(std::move(pass));
+    }
+
+    void addNode(const VulkanRenderGraphNode& node) {
+        _nodes.push_back(node);
+    }
+
 private:
+    // Direct batches per recording job, larger passes are split across several secondaries
+    static constexpr std::uint32_t BATCHES_PER_RECORDING_JOB = 512;
+
+    // One secondary command buffer drawing the batches [firstBatch, lastBatch) of a pass
+    struct RecordingJob {
+        const VulkanGraphicsPass* pass       = nullptr;
+        std::uint32_t             firstBatch = 0;
+        std::uint32_t             lastBatch  = UINT32_MAX;
+        vk::CommandBuffer         commandBuffer{};
+    };
+
+    // Records the draws of every graphics pass in parallel, one recording slot per worker range
+    Expected<void> recordSecondaryCommandBuffers();
+
+    Expected<void> recordJob(
+        VulkanCommandRecorder& recorder, RecordingJob& job, std::uint32_t frameIndex, std::uint32_t slot
+    ) const;
+
     VulkanRenderGraphCreateContext _context{};
 
     std::vector<std::unique_ptr<VulkanGraphicsPass>> _passes{};
+
+    // Produce data consumed by the draws and dispatches of the following nodes
+    std::vector<std::unique_ptr<VulkanComputePass>> _computePasses{};
+
+    std::vector<VulkanRenderGraphNode> _nodes{};
+
+    VulkanCommandRecorder _recorder{};
+
+    // Per recording slot, empty when passes are recorded inline
+    std::vector<std::unique_ptr<VulkanCommandRecorder>> _slotRecorders{};
+
+    std::vector<RecordingJob> _recordingJobs{};
+
+    VulkanCommandRecorder::Stats _recordingStats{};
 };
@@ -18,7 +18,7 @@ Expected<void> VulkanRenderGraphBuilder::build() {
 
         TRY_ASSIGN(pass->base().getShaderProgram(), _context.shaderProgramManager.load(passDescriptor.base.programPath));
 
-        TRY(resolvePushConstantRanges(pass));
+        TRY(resolvePushConstantRanges(&pass->base()));
 
         TRY(_passFactory.createPass(pass, _context));
 
@@ -28,6 +28,44 @@ Expected<void> VulkanRenderGraphBuilder::build() {
         TRY(createPipeline(pass));
     }
 
+    // Build compute passes, dispatches are driven by the systems consuming their results
+    for (const auto& passDescriptor : _computePassDescriptors) {
+        VulkanComputePass* pass;
+        TRY_ASSIGN(pass, allocateComputePass(passDescriptor));
+
+        TRY_ASSIGN(
+            pass->base().getShaderProgram(), _context.shaderProgramManager.load(passDescriptor.base.programPath)
+        );
+
+        TRY(resolvePushConstantRanges(&pass->base()));
+
+        for (const auto& readDescriptor : passDescriptor.base.readDescriptors) {
+            _context.renderResources.addResourceReader(readDescriptor.name, &pass->base());
+        }
+
+        // The depth pyramid binds its own per level sets, reads only schedule transitions
+        if (passDescriptor.type != VulkanComputePassType::DepthPyramid) {
+            TRY(allocateDescriptors(&pass->base()));
+        }
+
+        TRY(resolveComputeDescriptorLayouts(pass));
+        TRY(createComputePipeline(pass));
+    }
+
+    // Execution follows the declaration order
+    const auto& passes        = _context.renderGraph.getPasses();
+    const auto& computePasses = _context.renderGraph.getComputePasses();
+
+    std::size_t passIndex        = 0;
+    std::size_t computePassIndex = 0;
+
+    for (const bool computeNode : _computeNodes) {
+        if (computeNode)
+            _context.renderGraph.addNode({.computePass = computePasses[computePassIndex++].get()});
+        else
+            _context.renderGraph.addNode({.pass = passes[passIndex++].get()});
+    }
+
     scheduleResourceTransitions();
 
     Logger::debug("Built render graph");
@@ -44,6 +82,14 @@ Expected<VulkanGraphicsPass*> VulkanRenderGraphBuilder::allocatePass(const Vulka
 }
 
 
+Expected<VulkanComputePass*> VulkanRenderGraphBuilder::allocateComputePass(
+    const VulkanComputePassDescriptor& descriptor
+) const {
+    _context.renderGraph.addComputePass(std::make_unique<VulkanComputePass>(descriptor));
+
+    return Expected(_context.renderGraph.getComputePasses().back().get());
+}
+
 Expected<void> VulkanRenderGraphBuilder::allocateResources() const {
     for (const auto& resourceDescriptor : _resourceDescriptors) {
 
@@ -81,14 +127,21 @@ Expected<void> VulkanRenderGraphBuilder::resolveAttachments(VulkanGraphicsPass*
         _context.renderResources.addResourceReader(readDescriptor.name, &pass->base());
     }
 
+    // Determine loadOp based on whether previously built passes write to the resource
+    const auto wasWrittenTo = [&writers = _context.renderResources.getResourceWriters()](const std::string& name) {
+        return writers.contains(name) && !writers.at(name).empty();
+    };
+
     // Writes (color attachments)
-    for (const auto& attachmentDescriptor : passDescriptor.base.writeDescriptors) {
+    for (auto attachmentDescriptor : passDescriptor.base.writeDescriptors) {
         const VulkanPassResource* resource = _context.renderResources.getResource(attachmentDescriptor.name);
 
         if (!resource) {
             return VK_FAIL("Failed to resolve color resource \"" + attachmentDescriptor.name + "\".");
         }
 
+        if (wasWrittenTo(attachmentDescriptor.name)) attachmentDescriptor.loadOp = vk::AttachmentLoadOp::eLoad;
+
         VulkanGraphicsPassAttachment attachment(attachmentDescriptor);
         attachment.setResource(resource);
 
@@ -106,11 +159,9 @@ Expected<void> VulkanRenderGraphBuilder::resolveAttachments(VulkanGraphicsPass*
             return VK_FAIL("Failed to resolve depth resource \"" + depthDescriptor.name + "\".");
         }
 
-        // Determine loadOp based on whether previously built passes write to the depth buffer
-        const auto& writers      = _context.renderResources.getResourceWriters();
-        const bool  wasWrittenTo = writers.contains(depthDescriptor.name) && !writers.at(depthDescriptor.name).empty();
-
-        depthDescriptor.loadOp = wasWrittenTo ? vk::AttachmentLoadOp::eLoad : vk::AttachmentLoadOp::eClear;
+        depthDescriptor.loadOp = wasWrittenTo(depthDescriptor.name)
+            ? vk::AttachmentLoadOp::eLoad
+            : vk::AttachmentLoadOp::eClear;
 
         VulkanGraphicsPassAttachment depthAttachment(depthDescriptor);
         depthAttachment.setResource(resource);
@@ -148,11 +199,32 @@ Expected<void> VulkanRenderGraphBuilder::resolveDescriptorLayouts(VulkanGraphics
     return {};
 }
 
-Expected<void> VulkanRenderGraphBuilder::resolvePushConstantRanges(VulkanGraphicsPass* pass) {
-    for (const auto& pushConstant : pass->base().getShaderProgram()->getPushConstants()) {
-        pass->base().getPipelineLayoutDescriptor().pushConstantRanges.emplace(pushConstant);
+Expected<void> VulkanRenderGraphBuilder::resolveComputeDescriptorLayouts(VulkanComputePass* pass) const {
+    auto& layouts = pass->base().getPipelineLayoutDescriptor().descriptorLayouts;
+    layouts.resize(BindingSlots::PassData + 1);
+
+    layouts[BindingSlots::FrameData]   = _context.frameResources.getDescriptorManager().getLayout();
+
+    layouts[BindingSlots::ObjectData]  = _context.renderObjectManager.getDescriptorManager().getLayout();
+
+    layouts[BindingSlots::CullingData] = _context.frameCuller.getDescriptorManager().getLayout();
+
+    if (pass->getComputePassDescriptor().type == VulkanComputePassType::DepthPyramid) {
+        layouts[BindingSlots::PassData] = _context.frameCuller.getDepthPyramid().getDescriptorManager().getLayout();
+        return {};
     }
 
+    layouts[BindingSlots::PassData]    = pass->base().getPassDescriptor().readDescriptors.empty()
+        ? _emptyDescriptorLayout
+        : pass->base().getDescriptorManager()->getLayout();
+
+    return {};
+}
+
+Expected<void> VulkanRenderGraphBuilder::resolvePushConstantRanges(VulkanPass* pass) {
+    // Compiled once per pipeline, draws only index the ranges
+    TRY(pass->getPipelineLayoutDescriptor().pushConstants.compile(pass->getShaderProgram()->getPushConstants()));
+
     return {};
 }
 
@@ -181,6 +253,29 @@ Expected<void> VulkanRenderGraphBuilder::createPipeline(VulkanGraphicsPass* pass
     return {};
 }
 
+Expected<void> VulkanRenderGraphBuilder::createComputePipeline(VulkanComputePass* pass) const {
+    const auto& shaderStages = pass->base().getShaderProgram()->getStages();
+
+    if (shaderStages.size() != 1 || shaderStages.front().stage != vk::ShaderStageFlagBits::eCompute) {
+        return VK_FAIL(
+            "Failed to create compute pipeline for \"" + pass->getComputePassDescriptor().base.name +
+            "\": expected a single compute stage."
+        );
+    }
+
+    VulkanComputePipelineDescriptor descriptor{};
+
+    descriptor.shaderStage = shaderStages.front();
+    descriptor.layout      = pass->base().getPipelineLayoutDescriptor();
+
+    const VulkanComputePipeline* pipeline = nullptr;
+    TRY_ASSIGN(pipeline, _context.computePipelineManager.createComputePipeline(descriptor));
+
+    pass->setComputePipeline(pipeline);
+
+    return {};
+}
+
 void VulkanRenderGraphBuilder::scheduleResourceTransitions() const {
     const auto& writers = _context.renderResources.getResourceWriters();
     const auto& readers = _context.renderResources.getResourceReaders();
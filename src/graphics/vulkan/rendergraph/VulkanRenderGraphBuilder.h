@@ -7,6 +7,7 @@
 
 #include "graphics/vulkan/core/VulkanSwapchain.h"
 
+#include "graphics/vulkan/pipeline/compute/VulkanComputePipelineManager.h"
 #include "graphics/vulkan/pipeline/graphics/VulkanGraphicsPipelineManager.h"
 #include "graphics/vulkan/pipeline/shaders/VulkanShaderProgramManager.h"
 
@@ -33,6 +34,7 @@ struct VulkanRenderGraphBuilderContext {
 
     VulkanShaderProgramManager&    shaderProgramManager;
     VulkanGraphicsPipelineManager& pipelineManager;
+    VulkanComputePipelineManager&  computePipelineManager;
 };
 
 class VulkanRenderGraphBuilder {
@@ -58,12 +60,21 @@ public:
 
     VulkanRenderGraphBuilder& addPass(const VulkanGraphicsPassDescriptor& descriptor) {
         _passDescriptors.push_back(descriptor);
+        _computeNodes.push_back(false);
+        return *this;
+    }
+
+    VulkanRenderGraphBuilder& addComputePass(const VulkanComputePassDescriptor& descriptor) {
+        _computePassDescriptors.push_back(descriptor);
+        _computeNodes.push_back(true);
         return *this;
     }
 
 private:
     [[nodiscard]] Expected<VulkanGraphicsPass*> allocatePass(const VulkanGraphicsPassDescriptor& descriptor) const;
 
+    [[nodiscard]] Expected<VulkanComputePass*> allocateComputePass(const VulkanComputePassDescriptor& descriptor) const;
+
     [[nodiscard]] Expected<void> allocateResources() const;
 
     [[nodiscard]] Expected<void> resolveAttachments(VulkanGraphicsPass* pass) const;
@@ -72,9 +83,13 @@ private:
 
     [[nodiscard]] Expected<void> resolveDescriptorLayouts(VulkanGraphicsPass* pass) const;
 
-    [[nodiscard]] static Expected<void> resolvePushConstantRanges(VulkanGraphicsPass* pass);
+    [[nodiscard]] Expected<void> resolveComputeDescriptorLayouts(VulkanComputePass* pass) const;
+
+    [[nodiscard]] static Expected<void> resolvePushConstantRanges(VulkanPass* pass);
 
     [[nodiscard]] Expected<void> createPipeline(VulkanGraphicsPass* pass) const;
+
+    [[nodiscard]] Expected<void> createComputePipeline(VulkanComputePass* pass) const;
     
     void scheduleResourceTransitions() const;
 
@@ -86,6 +101,11 @@ private:
 
     std::vector<VulkanGraphicsPassDescriptor> _passDescriptors{};
 
+    std::vector<VulkanComputePassDescriptor> _computePassDescriptors{};
+
+    // Declaration order of the passes, true for compute passes
+    std::vector<bool> _computeNodes{};
+
     // Placeholder descriptor layout for passes with no incoming data
     vk::DescriptorSetLayout _emptyDescriptorLayout{};
 };
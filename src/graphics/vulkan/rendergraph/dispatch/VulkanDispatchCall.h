@@ -3,10 +3,18 @@
 #include <cstdint>
 #include <string>
 
+class VulkanDescriptorSets;
+
 struct VulkanDispatchCall {
     std::string name = "Undefined_Dispatch_Call";
 
     std::uint32_t groupCountX = 1;
     std::uint32_t groupCountY = 1;
     std::uint32_t groupCountZ = 1;
+
+    // Replaces the pass data set of the pass for this dispatch
+    const VulkanDescriptorSets* passDataSets = nullptr;
+
+    // Waits for the shader writes of the previous dispatches of the pass
+    bool barrier = false;
 };
@@ -0,0 +1,182 @@
+#include "VulkanCommandRecorder.h"
+
+#include <algorithm>
+#include <cstring>
+
+void VulkanCommandRecorder::begin(const vk::CommandBuffer commandBuffer) noexcept {
+    _commandBuffer = commandBuffer;
+
+    invalidate(vk::PipelineBindPoint::eGraphics);
+    invalidate(vk::PipelineBindPoint::eCompute);
+}
+
+void VulkanCommandRecorder::bindPipeline(const vk::PipelineBindPoint bindPoint, const vk::Pipeline pipeline) {
+    BindPointState& state = getBindPointState(bindPoint);
+
+    if (state.pipeline == pipeline) {
+        _stats.pipelines.elided++;
+        return;
+    }
+
+    _commandBuffer.bindPipeline(bindPoint, pipeline);
+
+    state.pipeline = pipeline;
+    _stats.pipelines.issued++;
+}
+
+void VulkanCommandRecorder::bindDescriptorSets(
+    const vk::PipelineBindPoint              bindPoint,
+    const vk::PipelineLayout                 layout,
+    const std::uint32_t                      firstSet,
+    const std::span<const vk::DescriptorSet> sets
+) {
+    BindPointState& state = getBindPointState(bindPoint);
+
+    setLayout(state, layout);
+
+    // Only the sets from the first changed one to the last changed one are rebound
+    std::uint32_t first = 0;
+    std::uint32_t last  = static_cast<std::uint32_t>(sets.size());
+
+    const auto isBound = [&](const std::uint32_t i) {
+        return firstSet + i < MAX_DESCRIPTOR_SETS && state.sets[firstSet + i] == sets[i];
+    };
+
+    while (first < last && isBound(first)) first++;
+    while (last > first && isBound(last - 1)) last--;
+
+    _stats.descriptorSets.elided += static_cast<std::uint32_t>(sets.size()) - (last - first);
+
+    if (first == last) return;
+
+    _commandBuffer.bindDescriptorSets(bindPoint, layout, firstSet + first, sets.subspan(first, last - first), nullptr);
+
+    for (std::uint32_t i = first; i < last && firstSet + i < MAX_DESCRIPTOR_SETS; i++) {
+        state.sets[firstSet + i] = sets[i];
+    }
+
+    _stats.descriptorSets.issued += last - first;
+}
+
+void VulkanCommandRecorder::bindDescriptorSet(
+    const vk::PipelineBindPoint bindPoint,
+    const vk::PipelineLayout    layout,
+    const std::uint32_t         set,
+    const vk::DescriptorSet     descriptorSet
+) {
+    bindDescriptorSets(bindPoint, layout, set, std::span(&descriptorSet, 1));
+}
+
+void VulkanCommandRecorder::bindVertexBuffer(const vk::Buffer buffer, const vk::DeviceSize offset) {
+    if (_vertexBuffer && _vertexBuffer->buffer == buffer && _vertexBuffer->offset == offset) {
+        _stats.vertexBuffers.elided++;
+        return;
+    }
+
+    _commandBuffer.bindVertexBuffers(0, buffer, offset);
+
+    _vertexBuffer = VertexBufferState{buffer, offset};
+    _stats.vertexBuffers.issued++;
+}
+
+void VulkanCommandRecorder::bindIndexBuffer(
+    const vk::Buffer buffer, const vk::DeviceSize offset, const vk::IndexType indexType
+) {
+    if (_indexBuffer && _indexBuffer->buffer == buffer && _indexBuffer->offset == offset
+        && _indexBuffer->type == indexType) {
+        _stats.indexBuffers.elided++;
+        return;
+    }
+
+    _commandBuffer.bindIndexBuffer(buffer, offset, indexType);
+
+    _indexBuffer = IndexBufferState{buffer, offset, indexType};
+    _stats.indexBuffers.issued++;
+}
+
+void VulkanCommandRecorder::setViewport(const vk::Viewport& viewport) {
+    if (_viewport == viewport) {
+        _stats.viewports.elided++;
+        return;
+    }
+
+    _commandBuffer.setViewport(0, viewport);
+
+    _viewport = viewport;
+    _stats.viewports.issued++;
+}
+
+void VulkanCommandRecorder::setScissor(const vk::Rect2D& scissor) {
+    if (_scissor == scissor) {
+        _stats.scissors.elided++;
+        return;
+    }
+
+    _commandBuffer.setScissor(0, scissor);
+
+    _scissor = scissor;
+    _stats.scissors.issued++;
+}
+
+void VulkanCommandRecorder::pushConstants(
+    const vk::PipelineLayout   layout,
+    const vk::ShaderStageFlags stageFlags,
+    const std::uint32_t        offset,
+    const std::uint32_t        size,
+    const void*                data
+) {
+    if (layout != _pushConstantLayout) {
+        _pushConstantLayout = layout;
+        _pushConstantStages.fill({});
+    }
+
+    const bool tracked = offset + size <= MAX_PUSH_CONSTANT_SIZE;
+
+    if (tracked) {
+        const bool samePushed = std::all_of(
+            _pushConstantStages.begin() + offset, _pushConstantStages.begin() + offset + size,
+            [&](const vk::ShaderStageFlags stages) { return stages == stageFlags; }
+        );
+
+        if (samePushed && std::memcmp(_pushConstantData.data() + offset, data, size) == 0) {
+            _stats.pushConstants.elided++;
+            return;
+        }
+    }
+
+    _commandBuffer.pushConstants(layout, stageFlags, offset, size, data);
+
+    if (tracked) {
+        std::memcpy(_pushConstantData.data() + offset, data, size);
+        std::fill_n(_pushConstantStages.begin() + offset, size, stageFlags);
+    }
+
+    _stats.pushConstants.issued++;
+}
+
+void VulkanCommandRecorder::invalidate(const vk::PipelineBindPoint bindPoint) noexcept {
+    getBindPointState(bindPoint) = {};
+
+    // Buffers, dynamic state and push constants are shared by the bind points
+    _vertexBuffer.reset();
+    _indexBuffer.reset();
+    _viewport.reset();
+    _scissor.reset();
+
+    _pushConstantLayout = nullptr;
+    _pushConstantStages.fill({});
+}
+
+VulkanCommandRecorder::BindPointState& VulkanCommandRecorder::getBindPointState(
+    const vk::PipelineBindPoint bindPoint
+) noexcept {
+    return bindPoint == vk::PipelineBindPoint::eCompute ? _compute : _graphics;
+}
+
+void VulkanCommandRecorder::setLayout(BindPointState& state, const vk::PipelineLayout layout) noexcept {
+    if (state.layout == layout) return;
+
+    // Layouts are not checked for compatibility, any change conservatively forgets the bound sets
+    state.layout = layout;
+    state.sets.fill(nullptr);
+}
@@ -0,0 +1,147 @@
+#pragma once
+
+#include "graphics/vulkan/common/VulkanHeader.h"
+
+#include <array>
+#include <optional>
+#include <span>
+
+// Records into a command buffer while shadowing the state it binds, calls that would not change the bound state are
+// elided. State is tracked per command buffer: begin() forgets it, and everything bound outside the recorder must be
+// followed by the matching invalidate call
+class VulkanCommandRecorder {
+public:
+    static constexpr std::uint32_t MAX_DESCRIPTOR_SETS = 8;
+
+    // Push constant bytes shadowed, larger ranges are always pushed
+    static constexpr std::uint32_t MAX_PUSH_CONSTANT_SIZE = 256;
+
+    struct StateCounter {
+        std::uint32_t issued = 0;
+        std::uint32_t elided = 0;
+
+        StateCounter& operator+=(const StateCounter& other) noexcept {
+            issued += other.issued;
+            elided += other.elided;
+            return *this;
+        }
+    };
+
+    // Calls recorded since the last resetStats()
+    struct Stats {
+        StateCounter pipelines{};
+        StateCounter descriptorSets{};
+        StateCounter vertexBuffers{};
+        StateCounter indexBuffers{};
+        StateCounter viewports{};
+        StateCounter scissors{};
+        StateCounter pushConstants{};
+
+        [[nodiscard]] std::uint32_t getElidedCount() const noexcept {
+            return pipelines.elided + descriptorSets.elided + vertexBuffers.elided + indexBuffers.elided
+                 + viewports.elided + scissors.elided + pushConstants.elided;
+        }
+
+        Stats& operator+=(const Stats& other) noexcept {
+            pipelines      += other.pipelines;
+            descriptorSets += other.descriptorSets;
+            vertexBuffers  += other.vertexBuffers;
+            indexBuffers   += other.indexBuffers;
+            viewports      += other.viewports;
+            scissors       += other.scissors;
+            pushConstants  += other.pushConstants;
+            return *this;
+        }
+    };
+
+    VulkanCommandRecorder()  = default;
+    ~VulkanCommandRecorder() = default;
+
+    VulkanCommandRecorder(const VulkanCommandRecorder&)            = delete;
+    VulkanCommandRecorder& operator=(const VulkanCommandRecorder&) = delete;
+
+    VulkanCommandRecorder(VulkanCommandRecorder&&)            = delete;
+    VulkanCommandRecorder& operator=(VulkanCommandRecorder&&) = delete;
+
+    // Starts tracking a freshly begun command buffer, nothing is bound yet
+    void begin(vk::CommandBuffer commandBuffer) noexcept;
+
+    // Stats accumulate over every command buffer begun since
+    void resetStats() noexcept { _stats = {}; }
+
+    void bindPipeline(vk::PipelineBindPoint bindPoint, vk::Pipeline pipeline);
+
+    void bindDescriptorSets(
+        vk::PipelineBindPoint              bindPoint,
+        vk::PipelineLayout                 layout,
+        std::uint32_t                      firstSet,
+        std::span<const vk::DescriptorSet> sets
+    );
+
+    void bindDescriptorSet(
+        vk::PipelineBindPoint bindPoint, vk::PipelineLayout layout, std::uint32_t set, vk::DescriptorSet descriptorSet
+    );
+
+    void bindVertexBuffer(vk::Buffer buffer, vk::DeviceSize offset = 0);
+    void bindIndexBuffer(vk::Buffer buffer, vk::DeviceSize offset, vk::IndexType indexType);
+
+    void setViewport(const vk::Viewport& viewport);
+    void setScissor(const vk::Rect2D& scissor);
+
+    void pushConstants(
+        vk::PipelineLayout   layout,
+        vk::ShaderStageFlags stageFlags,
+        std::uint32_t        offset,
+        std::uint32_t        size,
+        const void*          data
+    );
+
+    // Forgets the bindings of a bind point and the shared state, e.g. after commands recorded without the recorder
+    void invalidate(vk::PipelineBindPoint bindPoint) noexcept;
+
+    // Draws, dispatches and barriers are recorded directly
+    [[nodiscard]] vk::CommandBuffer getCommandBuffer() const noexcept { return _commandBuffer; }
+
+    [[nodiscard]] const Stats& getStats() const noexcept { return _stats; }
+
+private:
+    struct BindPointState {
+        vk::Pipeline       pipeline{};
+        vk::PipelineLayout layout{};
+
+        std::array<vk::DescriptorSet, MAX_DESCRIPTOR_SETS> sets{};
+    };
+
+    struct VertexBufferState {
+        vk::Buffer     buffer{};
+        vk::DeviceSize offset = 0;
+    };
+
+    struct IndexBufferState {
+        vk::Buffer     buffer{};
+        vk::DeviceSize offset = 0;
+        vk::IndexType  type   = vk::IndexType::eUint32;
+    };
+
+    [[nodiscard]] BindPointState& getBindPointState(vk::PipelineBindPoint bindPoint) noexcept;
+
+    // Sets bound with another layout may be disturbed by the new one
+    void setLayout(BindPointState& state, vk::PipelineLayout layout) noexcept;
+
+    vk::CommandBuffer _commandBuffer{};
+
+    BindPointState _graphics{};
+    BindPointState _compute{};
+
+    std::optional<VertexBufferState> _vertexBuffer{};
+    std::optional<IndexBufferState>  _indexBuffer{};
+    std::optional<vk::Viewport>      _viewport{};
+    std::optional<vk::Rect2D>        _scissor{};
+
+    // Push constants are shared by every bind point, bytes are only valid for the layout they were pushed with
+    vk::PipelineLayout                                       _pushConstantLayout{};
+    std::array<std::byte, MAX_PUSH_CONSTANT_SIZE>            _pushConstantData{};
+    std::array<vk::ShaderStageFlags, MAX_PUSH_CONSTANT_SIZE> _pushConstantStages{};
+
+    Stats _stats{};
+};
@@ -0,0 +1,140 @@
+#include "VulkanDepthPyramid.h"
+
+#include "graphics/vulkan/common/VulkanDebugger.h"
+
+#include <algorithm>
+#include <bit>
+#include <string>
+
+Expected<void> VulkanDepthPyramid::create(const VulkanDevice& device, const std::uint32_t framesInFlight) noexcept {
+    _device = &device;
+
+    // One set per level, the same pyramid is shared by every frame in flight
+    TRY(_descriptorManager.create(device.getLogicalDevice(), getDescriptorScheme(), framesInFlight, MAX_LEVELS));
+
+    for (VulkanDescriptorSets*& levelDescriptors : _levelDescriptors) {
+        TRY(_descriptorManager.allocate(levelDescriptors));
+    }
+
+    TRY_ASSIGN(_sampler, device.getSamplerCache().getOrCreate({
+        .filter           = vk::Filter::eNearest,
+        .mipmapMode       = vk::SamplerMipmapMode::eNearest,
+        .addressMode      = vk::SamplerAddressMode::eClampToEdge,
+        .anisotropyEnable = false
+    }));
+
+    return {};
+}
+
+void VulkanDepthPyramid::destroy() noexcept {
+    destroyImage();
+
+    _descriptorManager.destroy();
+    _levelDescriptors.fill(nullptr);
+
+    _sampler = VK_NULL_HANDLE;
+    _device  = nullptr;
+}
+
+void VulkanDepthPyramid::destroyImage() noexcept {
+    if (_device) {
+        for (const vk::ImageView levelView : _levelViews) {
+            _device->getLogicalDevice().destroyImageView(levelView);
+        }
+    }
+
+    _levelViews.clear();
+
+    _image.destroy();
+
+    _extent     = vk::Extent2D{};
+    _levelCount = 0;
+}
+
+Expected<void> VulkanDepthPyramid::resize(const VulkanImage& depthImage, const VulkanCommandManager& commandManager) {
+    destroyImage();
+
+    const vk::Extent3D depthExtent = depthImage.getExtent();
+
+    // Levels halve exactly, the first level footprints span up to 3 depth texels
+    _extent     = vk::Extent2D(std::bit_floor(depthExtent.width), std::bit_floor(depthExtent.height));
+    _levelCount = std::min<std::uint32_t>(std::bit_width(std::max(_extent.width, _extent.height)), MAX_LEVELS);
+
+    constexpr vk::Format format = vk::Format::eR32Sfloat;
+
+    const vk::Extent3D        extent(_extent.width, _extent.height, 1);
+    const vk::ImageUsageFlags usage = vk::ImageUsageFlagBits::eStorage | vk::ImageUsageFlagBits::eSampled;
+
+    _image
+        .setFormat(format)
+        .setExtent(extent)
+        .setUsageFlags(usage)
+        .setAspectFlags(vk::ImageAspectFlagBits::eColor)
+        .setLayout(vk::ImageLayout::eUndefined);
+
+    TRY(_image.createImage(
+        vk::ImageType::e2D, format, extent, _levelCount, usage, VMA_MEMORY_USAGE_GPU_ONLY, _device
+    ));
+
+    TRY(_image.createImageView(vk::ImageViewType::e2D, format, vk::ImageAspectFlagBits::eColor, _levelCount, _device));
+
+    TRY(_image.transitionLayout(&commandManager, vk::ImageLayout::eGeneral, _levelCount));
+
+    // Single level views, written by a reduction and read by the next one
+    for (std::uint32_t level = 0; level < _levelCount; level++) {
+        vk::ImageViewCreateInfo levelViewInfo{};
+        levelViewInfo
+            .setImage(_image.handle())
+            .setViewType(vk::ImageViewType::e2D)
+            .setFormat(format)
+            .setSubresourceRange({vk::ImageAspectFlagBits::eColor, level, 1, 0, 1});
+
+        vk::ImageView levelView{};
+        VK_CREATE(levelView, _device->getLogicalDevice().createImageView(levelViewInfo));
+
+        _levelViews.push_back(levelView);
+    }
+
+    // The first level reduces the depth buffer, the others the previous level
+    for (std::uint32_t level = 0; level < _levelCount; level++) {
+        const vk::DescriptorImageInfo sourceInfo = level == 0
+            ? vk::DescriptorImageInfo{_sampler, depthImage.getImageView(), vk::ImageLayout::eShaderReadOnlyOptimal}
+            : vk::DescriptorImageInfo{_sampler, _levelViews[level - 1],    vk::ImageLayout::eGeneral};
+
+        _levelDescriptors[level]->updatePerFrameDescriptorSets({
+            .type = vk::DescriptorType::eCombinedImageSampler, .imageInfo = sourceInfo, .binding = 0
+        });
+
+        _levelDescriptors[level]->updatePerFrameDescriptorSets({
+            .type      = vk::DescriptorType::eStorageImage,
+            .imageInfo = {{}, _levelViews[level], vk::ImageLayout::eGeneral},
+            .binding   = 1
+        });
+    }
+
+    return {};
+}
+
+void VulkanDepthPyramid::updateDispatches(VulkanComputePass& pass) const {
+    auto& dispatchCalls = pass.getDispatchCalls();
+
+    if (dispatchCalls.size() != _levelCount) {
+        dispatchCalls.clear();
+
+        for (std::uint32_t level = 0; level < _levelCount; level++) {
+            pass.emplaceDispatchCall().name = pass.getComputePassDescriptor().base.name + "_" + std::to_string(level);
+        }
+    }
+
+    for (std::uint32_t level = 0; level < _levelCount; level++) {
+        VulkanDispatchCall& dispatchCall = dispatchCalls[level];
+
+        const std::uint32_t levelWidth  = std::max(_extent.width  >> level, 1u);
+        const std::uint32_t levelHeight = std::max(_extent.height >> level, 1u);
+
+        dispatchCall.groupCountX  = (levelWidth  + GROUP_SIZE - 1) / GROUP_SIZE;
+        dispatchCall.groupCountY  = (levelHeight + GROUP_SIZE - 1) / GROUP_SIZE;
+        dispatchCall.passDataSets = _levelDescriptors[level];
+        dispatchCall.barrier      = level > 0;
+    }
+}
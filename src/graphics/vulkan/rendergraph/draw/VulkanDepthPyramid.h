@@ -0,0 +1,83 @@
+#pragma once
+
+#include "core/debug/ErrorHandling.h"
+
+#include "graphics/vulkan/common/VulkanHeader.h"
+
+#include "graphics/vulkan/core/VulkanCommandManager.h"
+#include "graphics/vulkan/core/VulkanDevice.h"
+
+#include "graphics/vulkan/rendergraph/nodes/VulkanComputePass.h"
+
+#include "graphics/vulkan/resources/descriptors/VulkanDescriptorManager.h"
+#include "graphics/vulkan/resources/descriptors/VulkanDescriptorSets.h"
+#include "graphics/vulkan/resources/images/VulkanImage.h"
+
+#include <array>
+#include <vector>
+
+// Hierarchical depth buffer, each texel keeps the farthest depth (reversed-Z minimum) of its footprint
+// The first level is the largest power of two extent fitting the depth buffer, reduced level by level
+class VulkanDepthPyramid {
+public:
+    static constexpr std::uint32_t MAX_LEVELS = 16;
+    static constexpr std::uint32_t GROUP_SIZE = 8;
+
+    VulkanDepthPyramid()  = default;
+    ~VulkanDepthPyramid() = default;
+
+    VulkanDepthPyramid(const VulkanDepthPyramid&)            = delete;
+    VulkanDepthPyramid& operator=(const VulkanDepthPyramid&) = delete;
+
+    VulkanDepthPyramid(VulkanDepthPyramid&&)            = delete;
+    VulkanDepthPyramid& operator=(VulkanDepthPyramid&&) = delete;
+
+    [[nodiscard]] Expected<void> create(const VulkanDevice& device, std::uint32_t framesInFlight) noexcept;
+
+    void destroy() noexcept;
+
+    // Recreates the pyramid for the extent of the depth buffer it reduces
+    [[nodiscard]] Expected<void> resize(const VulkanImage& depthImage, const VulkanCommandManager& commandManager);
+
+    // One dispatch per level, each reading the previous level
+    void updateDispatches(VulkanComputePass& pass) const;
+
+    [[nodiscard]] static VulkanDescriptorScheme getDescriptorScheme() noexcept {
+        static const VulkanDescriptorScheme scheme = {
+            {0, vk::DescriptorType::eCombinedImageSampler, vk::ShaderStageFlagBits::eCompute}, // Source level
+            {1, vk::DescriptorType::eStorageImage,         vk::ShaderStageFlagBits::eCompute}  // Target level
+        };
+        return scheme;
+    }
+
+    // Whole pyramid, sampled in the general layout
+    [[nodiscard]] VulkanDescriptorInfo getDescriptorInfo(const std::uint32_t binding) const noexcept {
+        return {
+            .type      = vk::DescriptorType::eCombinedImageSampler,
+            .imageInfo = {_sampler, _image.getImageView(), vk::ImageLayout::eGeneral},
+            .binding   = binding
+        };
+    }
+
+    [[nodiscard]] const VulkanDescriptorManager& getDescriptorManager() const noexcept { return _descriptorManager; }
+
+    [[nodiscard]] vk::Extent2D  getExtent()     const noexcept { return _extent; }
+    [[nodiscard]] std::uint32_t getLevelCount() const noexcept { return _levelCount; }
+
+private:
+    void destroyImage() noexcept;
+
+    const VulkanDevice* _device = nullptr;
+
+    VulkanImage                _image{};
+    std::vector<vk::ImageView> _levelViews{};
+
+    // Nearest sampling, levels are only fetched
+    vk::Sampler _sampler{};
+
+    vk::Extent2D  _extent{};
+    std::uint32_t _levelCount = 0;
+
+    VulkanDescriptorManager                       _descriptorManager{};
+    std::array<VulkanDescriptorSets*, MAX_LEVELS> _levelDescriptors{};
+};
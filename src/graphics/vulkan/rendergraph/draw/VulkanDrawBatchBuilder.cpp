@@ -1,33 +1,366 @@
 #include "VulkanDrawBatchBuilder.h"
 
-#include <ranges>
+#include "core/multithreading/ParallelFor.h"
 
-void VulkanDrawBatchBuilder::build(const std::vector<VulkanDrawCall*>& drawCalls, const std::uint32_t indirectionOffset) {
-    _drawBatchMap.clear();
-    _indirectionData.clear();
+#include <algorithm>
+#include <bit>
+#include <numeric>
+#include <span>
+
+namespace {
+    // Key fields, most significant first
+    constexpr std::uint32_t PIPELINE_BITS = 8;
+    constexpr std::uint32_t MESH_BITS     = 20;
+    constexpr std::uint32_t MATERIAL_BITS = 16;
+    constexpr std::uint32_t DEPTH_BITS    = 20;
+
+    constexpr std::uint32_t MATERIAL_SHIFT = DEPTH_BITS;
+    constexpr std::uint32_t MESH_SHIFT     = MATERIAL_SHIFT + MATERIAL_BITS;
+    constexpr std::uint32_t PIPELINE_SHIFT = MESH_SHIFT + MESH_BITS;
+
+    static_assert(PIPELINE_SHIFT + PIPELINE_BITS == 64);
+
+    bool isSameRenderMesh(const VulkanDrawCall& a, const VulkanDrawCall& b) noexcept {
+        const VulkanRenderMesh& meshA = a.getRenderMesh();
+        const VulkanRenderMesh& meshB = b.getRenderMesh();
+
+        return meshA.mesh == meshB.mesh && meshA.material == meshB.material;
+    }
+
+    // Materials are indexed per instance, instances of a mesh batch together whatever their material
+    bool isSameBatch(const VulkanDrawCall& a, const VulkanDrawCall& b) noexcept {
+        return a.getRenderMesh().mesh == b.getRenderMesh().mesh;
+    }
+
+    std::uint32_t getMaterialIndex(const VulkanDrawCall& drawCall) noexcept {
+        const VulkanMaterial* material = drawCall.getRenderMesh().material;
+
+        return material ? material->getMaterialIndex() : 0;
+    }
+}
+
+void VulkanDrawBatchBuilder::build(
+    const std::vector<VulkanDrawCall*>& drawCalls,
+    const VulkanGraphicsPipeline*       pipeline,
+    const glm::vec3&                    cameraPosition,
+    const std::uint32_t                 indirectionOffset,
+    const std::optional<std::uint32_t>  commandOffset
+) {
+    const bool offsetChanged = indirectionOffset != _lastIndirectionOffset || commandOffset != _lastCommandOffset;
+
+    // Depth keys are only refreshed past the resort distance, smaller moves barely change the front to back order
+    const glm::vec3 cameraOffset = cameraPosition - _sortOrigin;
+    const bool      cameraMoved  = glm::dot(cameraOffset, cameraOffset) > DEPTH_RESORT_DISTANCE * DEPTH_RESORT_DISTANCE;
+
+    // Same visible draws seen from the same sort origin sort and group the same
+    if (_built && !offsetChanged
+        && !cameraMoved
+        && pipeline == _lastPipeline
+        && drawCalls == _lastDrawCalls) {
+        return;
+    }
+
+    if (!_built || cameraMoved) _sortOrigin = cameraPosition;
+
+    _lastDrawCalls.assign(drawCalls.begin(), drawCalls.end());
+    _lastPipeline          = pipeline;
+    _lastIndirectionOffset = indirectionOffset;
+    _lastCommandOffset     = commandOffset;
+    _built                 = true;
+
+    const std::size_t drawCount = drawCalls.size();
+
+    _sortKeys.resize(drawCount);
+    _drawOrder.resize(drawCount);
+
+    std::iota(_drawOrder.begin(), _drawOrder.end(), 0u);
+
+    // Build sort keys, bits equal across all keys need no radix pass
+    const std::uint64_t pipelineKey =
+        static_cast<std::uint64_t>(getSortID(_pipelineIDs, pipeline, PIPELINE_BITS)) << PIPELINE_SHIFT;
+
+    std::uint64_t keysOr  = 0;
+    std::uint64_t keysAnd = ~std::uint64_t{0};
+
+    // Consecutive draws usually share their mesh and material, skip the ID lookups for them
+    const VulkanDrawCall* previousDrawCall = nullptr;
+    std::uint64_t         batchKey         = 0;
+
+    for (std::size_t i = 0; i < drawCount; i++) {
+        const VulkanDrawCall& drawCall = *drawCalls[i];
+
+        if (!previousDrawCall || !isSameRenderMesh(*previousDrawCall, drawCall)) {
+            const auto& [mesh, material] = drawCall.getRenderMesh();
+
+            const std::uint64_t materialID = getSortID(_materialIDs, material, MATERIAL_BITS);
+            const std::uint64_t meshID     = getSortID(_meshIDs, mesh, MESH_BITS);
+
+            batchKey         = meshID << MESH_SHIFT | materialID << MATERIAL_SHIFT;
+            previousDrawCall = &drawCall;
+        }
+
+        const std::uint64_t key = pipelineKey | batchKey | getDepthKey(drawCall, _sortOrigin);
+
+        _sortKeys[i] = key;
+
+        keysOr  |= key;
+        keysAnd &= key;
+    }
+
+    sort(keysOr ^ keysAnd);
+
+    PendingUpload changed{
+        .indirection = group(drawCalls),
+        .commands    = buildCommands()
+    };
+
+    // A moved pass region holds none of the current entries in any frame copy
+    if (offsetChanged) {
+        changed = {
+            .indirection = {0, static_cast<std::uint32_t>(_indirectionData.size())},
+            .commands    = {0, static_cast<std::uint32_t>(_drawCommands.size())}
+        };
+    }
+
+    markDirty(changed);
+}
+
+void VulkanDrawBatchBuilder::upload(const UploadTargets& targets, const std::uint32_t frameIndex) {
+    // Frame copies first seen have never been written
+    if (frameIndex >= _pendingUploads.size()) {
+        _pendingUploads.resize(frameIndex + 1, {
+            .indirection = {0, static_cast<std::uint32_t>(_indirectionData.size())},
+            .commands    = {0, static_cast<std::uint32_t>(_drawCommands.size())}
+        });
+    }
+
+    auto& [indirection, commands] = _pendingUploads[frameIndex];
+
+    // Material entries are parallel to the indirection ones and share their range
+    DirtyRange materials = indirection;
+
+    uploadRange(*targets.indirection, frameIndex, _indirectionData, indirection, _lastIndirectionOffset);
+    uploadRange(*targets.materials, frameIndex, _materialData, materials, _lastIndirectionOffset);
+
+    if (targets.commands && _lastCommandOffset) {
+        uploadRange(*targets.commands, frameIndex, _drawCommands, commands, *_lastCommandOffset);
+    }
+}
+
+VulkanDrawBatchBuilder::DirtyRange VulkanDrawBatchBuilder::group(const std::vector<VulkanDrawCall*>& drawCalls) {
+    const std::size_t drawCount     = drawCalls.size();
+    const std::size_t previousCount = _indirectionData.size();
+
+    // Entries beyond the previous set are new
+    DirtyRange changed{};
+    extend(changed, static_cast<std::uint32_t>(previousCount), static_cast<std::uint32_t>(drawCount));
+
+    // Run-length group draws sharing a mesh, IDs may saturate so runs compare the draws themselves
+    _indirectionData.resize(drawCount);
+    _materialData.resize(drawCount);
     _builtDrawBatches.clear();
 
-    // Group by {mesh, material}, store representative
-    for (auto* drawCall : drawCalls) {
-        const auto& [mesh, material] = drawCall->getRenderMesh();
+    for (std::size_t i = 0; i < drawCount; i++) {
+        VulkanDrawCall* drawCall = drawCalls[_drawOrder[i]];
+
+        const std::uint32_t objectIndex   = drawCall->getInstanceHandle().objectIndex;
+        const std::uint32_t materialIndex = getMaterialIndex(*drawCall);
+
+        if (i < previousCount && (_indirectionData[i] != objectIndex || _materialData[i] != materialIndex)) {
+            extend(changed, static_cast<std::uint32_t>(i), static_cast<std::uint32_t>(i + 1));
+        }
 
-        auto& [rep, handles] = _drawBatchMap[{mesh, material}];
-        if (!rep) rep = drawCall;
+        _indirectionData[i] = objectIndex;
+        _materialData[i]    = materialIndex;
 
-        handles.push_back(drawCall->getInstanceHandle());
+        if (_builtDrawBatches.empty() || !isSameBatch(*_builtDrawBatches.back().drawCall, *drawCall)) {
+            _builtDrawBatches.push_back({drawCall, _lastIndirectionOffset + static_cast<std::uint32_t>(i), 0});
+        }
+
+        _builtDrawBatches.back().instanceCount++;
     }
 
-    // Flatten into indirection data and built batches
-    std::uint32_t firstInstance = indirectionOffset;
+    return changed;
+}
 
-    for (auto& [rep, handles] : _drawBatchMap | std::views::values) {
+VulkanDrawBatchBuilder::DirtyRange VulkanDrawBatchBuilder::buildCommands() {
+    const std::size_t previousCount = _drawCommands.size();
 
-        for (const auto& [objectIndex] : handles) {
-            _indirectionData.push_back(objectIndex);
+    _vertexBuffer = nullptr;
+    _indexBuffer  = nullptr;
+
+    bool indirect = _lastCommandOffset.has_value();
+
+    const auto commandCount = static_cast<std::uint32_t>(_builtDrawBatches.size());
+
+    DirtyRange changed{};
+    extend(changed, static_cast<std::uint32_t>(previousCount), commandCount);
+
+    if (indirect) _drawCommands.resize(commandCount);
+
+    for (std::uint32_t i = 0; indirect && i < commandCount; i++) {
+        const auto& [drawCall, firstInstance, instanceCount] = _builtDrawBatches[i];
+
+        const VulkanMesh* mesh = drawCall->getRenderMesh().mesh;
+
+        // Only indexed draws without state of their own can share the mesh manager buffers and a single draw
+        if (!mesh || mesh->isBufferless() || !mesh->getVertexBuffer() || !mesh->getIndexBuffer()
+            || drawCall->hasDrawState()) {
+            indirect = false;
+            break;
         }
 
-        _builtDrawBatches.push_back({rep, firstInstance, static_cast<std::uint32_t>(handles.size())});
+        if (!_vertexBuffer) {
+            _vertexBuffer = mesh->getVertexBuffer();
+            _indexBuffer  = mesh->getIndexBuffer();
+        } else if (_vertexBuffer != mesh->getVertexBuffer() || _indexBuffer != mesh->getIndexBuffer()) {
+            indirect = false;
+            break;
+        }
+
+        // Offsets are baked into the commands
+        const vk::DrawIndexedIndirectCommand command{
+            static_cast<std::uint32_t>(mesh->getIndices().size()),
+            instanceCount,
+            static_cast<std::uint32_t>(mesh->getIndexOffset() / sizeof(std::uint32_t)),
+            static_cast<std::int32_t>(mesh->getVertexOffset() / sizeof(Vertex)),
+            firstInstance
+        };
+
+        if (i < previousCount && _drawCommands[i] != command) {
+            extend(changed, i, i + 1);
+        }
+
+        _drawCommands[i] = command;
+    }
+
+    if (!indirect) {
+        _drawCommands.clear();
+
+        return {};
+    }
+
+    return changed;
+}
+
+void VulkanDrawBatchBuilder::markDirty(const PendingUpload& changed) noexcept {
+    for (auto& [indirection, commands] : _pendingUploads) {
+        extend(indirection, changed.indirection.begin, changed.indirection.end);
+        extend(commands, changed.commands.begin, changed.commands.end);
+    }
+}
+
+template<typename Element>
+void VulkanDrawBatchBuilder::uploadRange(
+    const VulkanStorageBuffer&  buffer,
+    const std::uint32_t         frameIndex,
+    const std::vector<Element>& elements,
+    DirtyRange&                 pending,
+    const std::uint32_t         offset
+) {
+    // Entries past a shrunk set are not drawn
+    const std::uint32_t end = std::min(pending.end, static_cast<std::uint32_t>(elements.size()));
+
+    if (pending.begin < end) {
+        const std::span<const Element> range(elements);
+
+        buffer.updateArrayMemory(frameIndex, range.subspan(pending.begin, end - pending.begin), offset + pending.begin);
+    }
+
+    pending = {};
+}
+
+void VulkanDrawBatchBuilder::extend(DirtyRange& range, const std::uint32_t begin, const std::uint32_t end) noexcept {
+    if (begin >= end) return;
+
+    if (range.begin >= range.end) {
+        range = {begin, end};
+        return;
+    }
+
+    range.begin = std::min(range.begin, begin);
+    range.end   = std::max(range.end, end);
+}
+
+std::uint32_t VulkanDrawBatchBuilder::getSortID(SortIDs& ids, const void* pointer, const std::uint32_t bits) {
+    const auto [it, inserted] = ids.try_emplace(pointer, static_cast<std::uint32_t>(ids.size()));
+
+    return std::min(it->second, (1u << bits) - 1);
+}
+
+std::uint32_t VulkanDrawBatchBuilder::getDepthKey(const VulkanDrawCall& drawCall, const glm::vec3& cameraPosition) {
+    glm::vec3 position{0.0f};
+
+    if (const Math::Bounds* bounds = drawCall.getWorldBounds()) {
+        position = bounds->center;
+    } else if (const glm::mat4* modelMatrix = drawCall.getModelMatrix()) {
+        position = glm::vec3((*modelMatrix)[3]);
+    } else {
+        return 0;
+    }
+
+    // Bits of a non-negative float order like the float, keep exponent and leading mantissa bits: front to back
+    const glm::vec3 offset   = position - cameraPosition;
+    const float     distance = glm::dot(offset, offset);
+
+    return std::bit_cast<std::uint32_t>(distance) >> (31 - DEPTH_BITS) & ((1u << DEPTH_BITS) - 1);
+}
+
+void VulkanDrawBatchBuilder::sort(const std::uint64_t varyingBits) {
+    const std::size_t drawCount  = _sortKeys.size();
+    const std::size_t chunkCount = (drawCount + SORT_CHUNK_SIZE - 1) / SORT_CHUNK_SIZE;
+
+    _sortKeysScratch.resize(drawCount);
+    _drawOrderScratch.resize(drawCount);
+
+    if (_histograms.size() < chunkCount) _histograms.resize(chunkCount);
+
+    // Runs over whole chunks, also when ParallelFor falls back to a single inline range
+    const auto forEachChunk = [&](const auto& function) {
+        ParallelFor::forEachRange(chunkCount, 1, [&](const std::size_t begin, const std::size_t end) {
+            for (std::size_t chunk = begin; chunk < end; chunk++) {
+                function(chunk, chunk * SORT_CHUNK_SIZE, std::min((chunk + 1) * SORT_CHUNK_SIZE, drawCount));
+            }
+        });
+    };
+
+    // LSD radix sort, stable so equal keys keep their draw order
+    for (std::uint32_t shift = 0; shift < 64; shift += RADIX_BITS) {
+        if ((varyingBits >> shift & (RADIX_SIZE - 1)) == 0) continue;
+
+        forEachChunk([&](const std::size_t chunk, const std::size_t begin, const std::size_t end) {
+            auto& histogram = _histograms[chunk];
+            histogram.fill(0);
+
+            for (std::size_t i = begin; i < end; i++) {
+                histogram[_sortKeys[i] >> shift & (RADIX_SIZE - 1)]++;
+            }
+        });
+
+        // Digit-major prefix sum, each chunk scatters after the lower chunks of the same digit
+        std::uint32_t offset = 0;
+
+        for (std::uint32_t digit = 0; digit < RADIX_SIZE; digit++) {
+            for (std::size_t chunk = 0; chunk < chunkCount; chunk++) {
+                const std::uint32_t count = _histograms[chunk][digit];
+
+                _histograms[chunk][digit] = offset;
+                offset += count;
+            }
+        }
+
+        forEachChunk([&](const std::size_t chunk, const std::size_t begin, const std::size_t end) {
+            auto& offsets = _histograms[chunk];
+
+            for (std::size_t i = begin; i < end; i++) {
+                const std::uint32_t destination = offsets[_sortKeys[i] >> shift & (RADIX_SIZE - 1)]++;
+
+                _sortKeysScratch[destination]  = _sortKeys[i];
+                _drawOrderScratch[destination] = _drawOrder[i];
+            }
+        });
 
-        firstInstance += static_cast<std::uint32_t>(handles.size());
+        _sortKeys.swap(_sortKeysScratch);
+        _drawOrder.swap(_drawOrderScratch);
     }
 }
@@ -2,12 +2,21 @@
 
 #include "VulkanDrawCall.h"
 
-#include "VulkanDrawBatch.h"
-#include "VulkanInstanceHandle.h"
+#include "graphics/vulkan/resources/ssbo/VulkanStorageBuffer.h"
 
+#include <array>
+#include <optional>
 #include <unordered_map>
 #include <vector>
 
+class VulkanGraphicsPipeline;
+
+// Groups the visible draws of a pass into instanced batches
+// Draws are ordered by 64-bit sort keys (pipeline | mesh | material | depth), radix sorted, and run-length grouped into
+// batches of equal mesh, materials are indexed per instance. With a command offset, batches also become indexed
+// indirect commands drawn by a single call. The builder lives as long as its pass: an unchanged visible set reuses the
+// last batches, also while the camera stays within DEPTH_RESORT_DISTANCE of where depths were keyed, and each frame in
+// flight copy of the instance and command buffers only receives the entries changed since its last upload
 class VulkanDrawBatchBuilder {
 public:
     struct BuiltDrawBatch {
@@ -16,8 +25,12 @@ public:
         std::uint32_t   instanceCount;
     };
 
-    using BatchValue         = std::pair<VulkanDrawCall*, std::vector<VulkanInstanceHandle>>;
-    using VulkanDrawBatchMap = std::unordered_map<VulkanDrawBatch, BatchValue>;
+    // Per instance object and material indices, and the indirect commands when the pass has a command offset
+    struct UploadTargets {
+        const VulkanStorageBuffer* indirection = nullptr;
+        const VulkanStorageBuffer* materials   = nullptr;
+        const VulkanStorageBuffer* commands    = nullptr;
+    };
 
     VulkanDrawBatchBuilder()  = default;
     ~VulkanDrawBatchBuilder() = default;
@@ -28,18 +41,119 @@ public:
     VulkanDrawBatchBuilder(VulkanDrawBatchBuilder&&)            = delete;
     VulkanDrawBatchBuilder& operator=(VulkanDrawBatchBuilder&&) = delete;
 
-    void build(const std::vector<VulkanDrawCall*>& drawCalls, std::uint32_t indirectionOffset);
+    void build(
+        const std::vector<VulkanDrawCall*>& drawCalls,
+        const VulkanGraphicsPipeline*       pipeline,
+        const glm::vec3&                    cameraPosition,
+        std::uint32_t                       indirectionOffset,
+        std::optional<std::uint32_t>        commandOffset = std::nullopt
+    );
+
+    // Writes the entries the frame copies are missing, nothing when they are up to date
+    void upload(const UploadTargets& targets, std::uint32_t frameIndex);
+
+    // False when a batch is not an indexed draw of the shared mesh buffers, the batches are then drawn directly
+    [[nodiscard]] bool hasDrawCommands() const noexcept { return !_drawCommands.empty(); }
 
-    [[nodiscard]] const VulkanDrawBatchMap& getDrawBatchMap() const noexcept { return _drawBatchMap; }
+    [[nodiscard]] std::uint32_t getCommandCount() const noexcept {
+        return static_cast<std::uint32_t>(_drawCommands.size());
+    }
 
-    [[nodiscard]] std::vector<BuiltDrawBatch>& getBuiltDrawBatches() noexcept { return _builtDrawBatches; }
+    [[nodiscard]] std::uint32_t getCommandOffset() const noexcept { return _lastCommandOffset.value_or(0); }
+
+    [[nodiscard]] const VulkanBuffer* getVertexBuffer() const noexcept { return _vertexBuffer; }
+    [[nodiscard]] const VulkanBuffer* getIndexBuffer() const noexcept { return _indexBuffer; }
+
+    [[nodiscard]] const std::vector<BuiltDrawBatch>& getBuiltDrawBatches() const noexcept { return _builtDrawBatches; }
 
     [[nodiscard]] const std::vector<std::uint32_t>& getIndirectionData() const noexcept { return _indirectionData; }
 
+    [[nodiscard]] const std::vector<std::uint32_t>& getMaterialData() const noexcept { return _materialData; }
+
 private:
-    VulkanDrawBatchMap _drawBatchMap{};
+    static constexpr std::uint32_t RADIX_BITS = 8;
+    static constexpr std::uint32_t RADIX_SIZE = 1 << RADIX_BITS;
+
+    // Draws per sort chunk, chunks are histogrammed and scattered in parallel
+    static constexpr std::size_t SORT_CHUNK_SIZE = 16384;
+
+    // Depth only orders draws front to back, a camera moving less than this from the sort origin keeps the last order
+    static constexpr float DEPTH_RESORT_DISTANCE = 2.0f;
+
+    using SortIDs = std::unordered_map<const void*, std::uint32_t>;
+
+    // Entries [begin, end) relative to the pass offset
+    struct DirtyRange {
+        std::uint32_t begin = 0;
+        std::uint32_t end   = 0;
+    };
+
+    struct PendingUpload {
+        DirtyRange indirection{};
+        DirtyRange commands{};
+    };
+
+    // Stable ID in first seen order, saturated to the key field width
+    [[nodiscard]] static std::uint32_t getSortID(SortIDs& ids, const void* pointer, std::uint32_t bits);
+
+    [[nodiscard]] static std::uint32_t getDepthKey(const VulkanDrawCall& drawCall, const glm::vec3& cameraPosition);
+
+    // Sorts _drawOrder by _sortKeys, digits shared by every key are skipped
+    void sort(std::uint64_t varyingBits);
+
+    // Regroups the sorted draws, returns the indirection entries that differ from the last build
+    [[nodiscard]] DirtyRange group(const std::vector<VulkanDrawCall*>& drawCalls);
+
+    // Turns the batches into indirect commands, returns the commands that differ from the last build
+    [[nodiscard]] DirtyRange buildCommands();
+
+    void markDirty(const PendingUpload& changed) noexcept;
+
+    template<typename Element>
+    static void uploadRange(
+        const VulkanStorageBuffer&  buffer,
+        std::uint32_t               frameIndex,
+        const std::vector<Element>& elements,
+        DirtyRange&                 pending,
+        std::uint32_t               offset
+    );
+
+    // Widens range to cover [begin, end)
+    static void extend(DirtyRange& range, std::uint32_t begin, std::uint32_t end) noexcept;
+
+    SortIDs _pipelineIDs{};
+    SortIDs _materialIDs{};
+    SortIDs _meshIDs{};
+
+    std::vector<std::uint64_t> _sortKeys{};
+    std::vector<std::uint64_t> _sortKeysScratch{};
+
+    // Indices into the draw calls, in sorted order after sort()
+    std::vector<std::uint32_t> _drawOrder{};
+    std::vector<std::uint32_t> _drawOrderScratch{};
+
+    // Per chunk digit counts, then scatter offsets
+    std::vector<std::array<std::uint32_t, RADIX_SIZE>> _histograms{};
 
     std::vector<BuiltDrawBatch> _builtDrawBatches{};
 
     std::vector<std::uint32_t> _indirectionData{};
+    std::vector<std::uint32_t> _materialData{};
+
+    std::vector<vk::DrawIndexedIndirectCommand> _drawCommands{};
+
+    // Shared by every command, bound once per pass
+    const VulkanBuffer* _vertexBuffer = nullptr;
+    const VulkanBuffer* _indexBuffer  = nullptr;
+
+    // Inputs of the last build, an identical build is skipped
+    std::vector<VulkanDrawCall*>  _lastDrawCalls{};
+    const VulkanGraphicsPipeline* _lastPipeline          = nullptr;
+    glm::vec3                     _sortOrigin{0.0f}; // Camera position of the depth keys
+    std::uint32_t                 _lastIndirectionOffset = 0;
+    std::optional<std::uint32_t>  _lastCommandOffset{};
+    bool                          _built                 = false;
+
+    // Entries not yet uploaded to each frame in flight copy
+    std::vector<PendingUpload> _pendingUploads{};
 };
@@ -1,9 +1,9 @@
 #include "VulkanDrawCall.h"
 
-#include <ranges>
+#include <bit>
 
 void VulkanDrawCall::record(
-    const vk::CommandBuffer  commandBuffer,
+    VulkanCommandRecorder&   recorder,
     const vk::Extent2D       extent,
     const vk::PipelineLayout pipelineLayout,
     const std::uint32_t      instanceCount,
@@ -11,27 +11,28 @@ void VulkanDrawCall::record(
 ) const {
     if (!_renderMesh.mesh) return;
 
-    commandBuffer.setViewport(0, resolveViewport(extent));
-    commandBuffer.setScissor(0, resolveScissor(extent));
+    recorder.setViewport(resolveViewport(extent));
+    recorder.setScissor(resolveScissor(extent));
 
-    pushConstants(commandBuffer, pipelineLayout);
+    pushConstants(recorder, pipelineLayout);
+
+    const vk::CommandBuffer commandBuffer = recorder.getCommandBuffer();
 
     const VulkanMesh& mesh = *_renderMesh.mesh;
 
     if (!mesh.isBufferless() && mesh.getVertexBuffer()) {
-        const vk::Buffer&    vertexBuffer = mesh.getVertexBuffer()->handle();
-        const vk::DeviceSize vertexOffset = mesh.getVertexOffset();
-
-        commandBuffer.bindVertexBuffers(0, 1, &vertexBuffer, &vertexOffset);
+        // Meshes share the mesh manager buffers, offsets go into the draw so the bindings stay the same
+        recorder.bindVertexBuffer(mesh.getVertexBuffer()->handle());
 
         if (mesh.getIndexBuffer()) {
-            const vk::Buffer& indexBuffer    = mesh.getIndexBuffer()->handle();
-            const vk::DeviceSize indexOffset = mesh.getIndexOffset();
-
-            commandBuffer.bindIndexBuffer(indexBuffer, indexOffset, vk::IndexType::eUint32);
+            recorder.bindIndexBuffer(mesh.getIndexBuffer()->handle(), 0, vk::IndexType::eUint32);
 
             commandBuffer.drawIndexed(
-                static_cast<std::uint32_t>(mesh.getIndices().size()), instanceCount, 0, 0, firstInstance
+                static_cast<std::uint32_t>(mesh.getIndices().size()),
+                instanceCount,
+                static_cast<std::uint32_t>(mesh.getIndexOffset() / sizeof(std::uint32_t)),
+                static_cast<std::int32_t>(mesh.getVertexOffset() / sizeof(Vertex)),
+                firstInstance
             );
         }
     } else {
@@ -39,13 +40,16 @@ void VulkanDrawCall::record(
     }
 }
 
-void VulkanDrawCall::pushConstants(
-    const vk::CommandBuffer commandBuffer, const vk::PipelineLayout pipelineLayout
-) const noexcept {
-    if (_pushConstants.empty()) return;
+void VulkanDrawCall::pushConstants(VulkanCommandRecorder& recorder, const vk::PipelineLayout pipelineLayout) const {
+    if (_pushConstantMask == 0) return;
+
+    const auto ranges = _pipelineLayoutDescriptor->pushConstants.getRanges();
+
+    // One push per set range, in offset order
+    for (std::uint32_t mask = _pushConstantMask; mask != 0; mask &= mask - 1) {
+        const auto& [stageFlags, offset, size] = ranges[std::countr_zero(mask)];
 
-    for (const auto& [data, range] : _pushConstants | std::views::values) {
-        commandBuffer.pushConstants(pipelineLayout, range.stageFlags, range.offset, range.size, data);
+        recorder.pushConstants(pipelineLayout, stageFlags, offset, size, _pushConstantData.data() + offset);
     }
 }
 
@@ -7,9 +7,12 @@
 
 #include "graphics/vulkan/resources/meshes/VulkanRenderMesh.h"
 
+#include "graphics/vulkan/rendergraph/draw/VulkanCommandRecorder.h"
 #include "graphics/vulkan/rendergraph/draw/VulkanInstanceHandle.h"
 
-struct VulkanPipelineLayoutDescriptor;
+#include <array>
+#include <cstring>
+#include <type_traits>
 
 class VulkanDrawCall {
 public:
@@ -22,15 +25,16 @@ public:
     VulkanDrawCall(VulkanDrawCall&&)            noexcept = default;
     VulkanDrawCall& operator=(VulkanDrawCall&&) noexcept = default;
 
+    // State equal to the previous draw is elided by the recorder
     void record(
-        vk::CommandBuffer  commandBuffer,
-        vk::Extent2D       extent,
-        vk::PipelineLayout pipelineLayout,
-        std::uint32_t      instanceCount = 1,
-        std::uint32_t      firstInstance = 0
+        VulkanCommandRecorder& recorder,
+        vk::Extent2D           extent,
+        vk::PipelineLayout     pipelineLayout,
+        std::uint32_t          instanceCount = 1,
+        std::uint32_t          firstInstance = 0
     ) const;
 
-    void pushConstants(vk::CommandBuffer commandBuffer, vk::PipelineLayout pipelineLayout) const noexcept;
+    void pushConstants(VulkanCommandRecorder& recorder, vk::PipelineLayout pipelineLayout) const;
 
     [[nodiscard]] vk::Viewport resolveViewport(vk::Extent2D extent) const;
     [[nodiscard]] vk::Rect2D resolveScissor(vk::Extent2D extent) const;
@@ -39,6 +43,10 @@ public:
     [[nodiscard]] const VulkanRenderMesh& getRenderMesh() const noexcept { return _renderMesh; }
     [[nodiscard]] const VulkanInstanceHandle& getInstanceHandle() const noexcept { return _instanceHandle; }
     [[nodiscard]] const glm::mat4* getModelMatrix() const noexcept { return _modelMatrix; }
+    [[nodiscard]] const Math::Bounds* getWorldBounds() const noexcept { return _worldBounds; }
+
+    // Push constants, viewport or scissor of its own, such draws cannot share an indirect draw
+    [[nodiscard]] bool hasDrawState() const noexcept { return _pushConstantMask != 0 || _viewport || _scissor; }
 
     VulkanDrawCall& setName(const std::string& name) noexcept { _name = name; return *this; }
 
@@ -54,6 +62,12 @@ public:
 
     VulkanDrawCall& setModelMatrix(const glm::mat4& modelMatrix) noexcept { _modelMatrix = &modelMatrix; return *this; }
 
+    // Cached world-space bounds used for culling, draws without bounds are never culled
+    VulkanDrawCall& setWorldBounds(const Math::Bounds& worldBounds) noexcept {
+        _worldBounds = &worldBounds;
+        return *this;
+    }
+
     VulkanDrawCall& setViewport(const vk::Viewport& viewport) noexcept { _viewport = viewport; return *this; }
     VulkanDrawCall& setScissor(const vk::Rect2D scissor) noexcept { _scissor = scissor; return *this; }
 
@@ -63,13 +77,26 @@ public:
     }
 
     template<typename PushConstantType>
-    VulkanDrawCall& setPushConstant(const std::string& name, const PushConstantType* data) noexcept {
-        const auto cachedRange = _pipelineLayoutDescriptor->pushConstantRanges.find(name);
+    VulkanDrawCall& setPushConstant(const std::string& name, const PushConstantType& value) noexcept {
+        const auto rangeIndex = _pipelineLayoutDescriptor->pushConstants.findRange(name);
 
         // TODO: Implement ASSERT() macro abstraction that calls Engine::fatalExit(message)
-        assert(cachedRange != _pipelineLayoutDescriptor->pushConstantRanges.end());
+        assert(rangeIndex.has_value());
+
+        return setPushConstant(*rangeIndex, value);
+    }
+
+    // Range index resolved once with VulkanPushConstantLayout::findRange, the value is copied into the draw
+    template<typename PushConstantType>
+    VulkanDrawCall& setPushConstant(const std::uint32_t rangeIndex, const PushConstantType& value) noexcept {
+        static_assert(std::is_trivially_copyable_v<PushConstantType>);
+
+        const VulkanPushConstantRange& range = _pipelineLayoutDescriptor->pushConstants.getRanges()[rangeIndex];
+
+        assert(sizeof(PushConstantType) <= range.size);
 
-        _pushConstants[name] = VulkanPushConstant(data, cachedRange->second);
+        std::memcpy(_pushConstantData.data() + range.offset, &value, sizeof(PushConstantType));
+        _pushConstantMask |= 1u << rangeIndex;
 
         return *this;
     }
@@ -80,13 +107,16 @@ private:
     VulkanRenderMesh     _renderMesh{};
     VulkanInstanceHandle _instanceHandle{};
 
-    const glm::mat4* _modelMatrix = nullptr;
+    const glm::mat4*    _modelMatrix = nullptr;
+    const Math::Bounds* _worldBounds = nullptr;
 
     // WARNING: Mutable, should store copy instead of pointer if layout ever changes during runtime
     // (e.g.: interface-breaking hot reloads).
     const VulkanPipelineLayoutDescriptor* _pipelineLayoutDescriptor = nullptr;
 
-    std::unordered_map<std::string, VulkanPushConstant> _pushConstants{};
+    // Values laid out like the push constant block, pushed per set range
+    std::array<std::byte, VulkanPushConstantLayout::MAX_SIZE> _pushConstantData{};
+    std::uint32_t                                             _pushConstantMask = 0;
 
     std::optional<vk::Viewport> _viewport{};
     std::optional<vk::Rect2D>   _scissor{};
@@ -1,77 +1,807 @@
 #include "VulkanFrameCuller.h"
 
-#include "core/render/FrustumCuller.h"
+#include "core/multithreading/ParallelFor.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+
+namespace {
+    // Same threshold as FrustumCuller
+    constexpr float VISIBILITY_THRESHOLD = 0.001f;
+
+    // Smallest plane distance of the box, visible at or above the threshold
+    float getFrustumMargin(const Math::Bounds& bounds, const std::array<Math::Plane, 6>& frustumPlanes) {
+        float margin = std::numeric_limits<float>::max();
+
+        for (const auto& [normal, d] : frustumPlanes) {
+            margin = std::min(margin, glm::dot(normal, bounds.center) + glm::dot(glm::abs(normal), bounds.extent) + d);
+        }
+
+        return margin - VISIBILITY_THRESHOLD;
+    }
+
+    // Largest change of a box plane distance between two camera poses within the coherence thresholds of the
+    // reference, draws tested at a pose other than the reference one are covered as well
+    float getHysteresisBand(const float cameraDistance, const float radius) {
+        return 2.0f * (VulkanFrameCuller::COHERENCE_MAX_CAMERA_DISTANCE
+                    + (cameraDistance + radius) * VulkanFrameCuller::COHERENCE_MAX_CAMERA_ANGLE);
+    }
+
+    bool testBit(const std::vector<std::uint64_t>& bits, const std::uint32_t index) {
+        return (bits[index / 64] >> (index % 64)) & 1;
+    }
+
+    void setBit(std::vector<std::uint64_t>& bits, const std::uint32_t index, const bool value) {
+        const std::uint64_t mask = std::uint64_t{1} << (index % 64);
+
+        if (value)
+            bits[index / 64] |= mask;
+        else
+            bits[index / 64] &= ~mask;
+    }
+}
 
 Expected<void> VulkanFrameCuller::create(
     const VulkanDevice&         device,
     VulkanStorageBufferManager& storageBufferManager,
-    const std::uint32_t         framesInFlight
+    const ObjectManager&        objectManager,
+    const std::uint32_t         framesInFlight,
+    const bool                  gpuCulling
 ) noexcept {
-    // Create descriptor manager
-    TRY(_descriptorManager.create(device.getLogicalDevice(), getDescriptorScheme(), framesInFlight, MAX_DRAWS));
+    _objectManager  = &objectManager;
+    _framesInFlight = framesInFlight;
+
+    // Create descriptor manager, a single set per frame in flight
+    TRY(_descriptorManager.create(device.getLogicalDevice(), getDescriptorScheme(), framesInFlight, 1));
 
     // Create indirection buffer
     TRY_ASSIGN(_indirectionBuffer, storageBufferManager.allocateBuffer(MAX_DRAWS * sizeof(uint32_t)));
+    TRY_ASSIGN(_instanceMaterialBuffer, storageBufferManager.allocateBuffer(MAX_DRAWS * sizeof(uint32_t)));
+
+    constexpr vk::BufferUsageFlags indirectUsage = vk::BufferUsageFlagBits::eIndirectBuffer;
+
+    // Create draw command buffer, CPU culled mesh passes draw with a single indirect draw
+    if (device.supportsMultiDrawIndirect()) {
+        TRY_ASSIGN(
+            _drawCommandBuffer,
+            storageBufferManager.allocateBuffer(
+                MAX_DRAW_COMMANDS * sizeof(vk::DrawIndexedIndirectCommand), indirectUsage
+            )
+        );
+    }
 
     TRY(_descriptorManager.allocate(_indirectionDescriptors));
 
-    _indirectionDescriptors->updatePerFrameSSBODescriptorSets(*_indirectionBuffer, 0);
+    _indirectionDescriptors->updatePerFrameSSBODescriptorSets(*_indirectionBuffer,      0);
+    _indirectionDescriptors->updatePerFrameSSBODescriptorSets(*_instanceMaterialBuffer, 8);
+
+    _gpuCulling = gpuCulling;
+
+    // Without GPU culling, bindings 1 to 7 stay unwritten: they are compute only and no graphics pipeline
+    // statically uses them, and the compute culling passes are not built
+    if (!_gpuCulling) return {};
+
+    // Create GPU culling buffers, commands and counts are written by the draw cull pass
+    TRY_ASSIGN(_gpuDrawRecordBuffer, storageBufferManager.allocateBuffer(MAX_GPU_DRAWS * sizeof(GpuDrawRecord)));
+    TRY_ASSIGN(
+        _gpuCommandBuffer,
+        storageBufferManager.allocateBuffer(2 * MAX_GPU_DRAWS * sizeof(vk::DrawIndexedIndirectCommand), indirectUsage)
+    );
+    TRY_ASSIGN(
+        _gpuCountBuffer,
+        storageBufferManager.allocateBuffer(2 * MAX_GPU_DRAW_GROUPS * sizeof(std::uint32_t), indirectUsage)
+    );
+    TRY_ASSIGN(_gpuCullParamsBuffer, storageBufferManager.allocateBuffer(sizeof(GpuCullParams)));
+    TRY_ASSIGN(_gpuVisibilityBuffer, storageBufferManager.allocateBuffer(MAX_GPU_DRAWS * sizeof(std::uint32_t)));
+    TRY_ASSIGN(_gpuCullStatsBuffer, storageBufferManager.allocateBuffer(sizeof(GpuCullStats)));
+
+    TRY(_depthPyramid.create(device, framesInFlight));
+
+    _indirectionDescriptors->updatePerFrameSSBODescriptorSets(*_gpuDrawRecordBuffer, 1);
+    _indirectionDescriptors->updatePerFrameSSBODescriptorSets(*_gpuCommandBuffer,    2);
+    _indirectionDescriptors->updatePerFrameSSBODescriptorSets(*_gpuCountBuffer,      3);
+    _indirectionDescriptors->updatePerFrameSSBODescriptorSets(*_gpuCullParamsBuffer, 4);
+    _indirectionDescriptors->updatePerFrameDescriptorSets(_gpuVisibilityBuffer->getDescriptorInfo(5, 0));
+    _indirectionDescriptors->updatePerFrameSSBODescriptorSets(*_gpuCullStatsBuffer,  7);
+
+    _gpuRecordsUploaded.assign(framesInFlight, false);
+
+    for (std::uint32_t i = 0; i < framesInFlight; i++) {
+        _gpuCullStatsBuffer->updateMemory(i, GpuCullStats{});
+    }
 
     return {};
 }
 
 void VulkanFrameCuller::destroy() noexcept {
+    _passCullData.clear();
+    _cullJobs.clear();
+
+    _gpuPassData.clear();
+    _gpuLateSources.clear();
+    _gpuDrawRecords.clear();
+
+    _depthPyramid.destroy();
+
     _descriptorManager.destroy();
 }
 
+Expected<void> VulkanFrameCuller::resizeDepthPyramid(
+    const VulkanImage& depthImage, const VulkanCommandManager& commandManager
+) {
+    if (!_gpuCulling) return {};
+
+    TRY(_depthPyramid.resize(depthImage, commandManager));
+
+    _indirectionDescriptors->updatePerFrameDescriptorSets(_depthPyramid.getDescriptorInfo(6));
+
+    return {};
+}
+
 Expected<void> VulkanFrameCuller::cull(
-    const std::vector<std::unique_ptr<VulkanGraphicsPass>>& passes, const FrameUniforms& uniforms
+    const std::vector<std::unique_ptr<VulkanGraphicsPass>>& passes,
+    const std::vector<std::unique_ptr<VulkanComputePass>>&  computePasses,
+    const FrameUniforms&                                    uniforms,
+    const std::uint32_t                                     frameIndex
 ) {
     const glm::mat4& viewProjectionMatrix = uniforms.projectionMatrix * uniforms.viewMatrix;
 
     const std::array<Math::Plane, 6>& frustumPlanes = FrustumCuller::getFrustumPlanes(viewProjectionMatrix);
 
+    const ContributionParams contribution{
+        .cameraPosition    = uniforms.cameraPosition,
+        .contributionScale = std::abs(uniforms.projectionMatrix[1][1]) * uniforms.viewHeight,
+        .minContribution   = _minContribution
+    };
+
+    const RangeCullContext rangeContext{
+        .frustumPlanes         = frustumPlanes,
+        .contribution          = contribution,
+        .coherence             = updateCoherence(uniforms),
+        .dynamicVisibleObjects = &_dynamicVisibleObjects
+    };
+
+    // Moving objects are culled through the dynamic object grid, the range hierarchies only hold static draws
+    _dynamicObjectIndices.clear();
+    _dynamicVisibleObjects.assign((_objectManager->getObjects().size() + 63) / 64, 0);
+
+    _objectManager->getDynamicObjectGrid().queryFrustum(frustumPlanes, _dynamicObjectIndices);
+
+    for (const std::uint32_t objectIndex : _dynamicObjectIndices) {
+        setBit(_dynamicVisibleObjects, objectIndex, true);
+    }
+
     _visibleDrawCalls.clear();
     _visibleDrawCalls.reserve(passes.size());
 
+    _cullJobs.clear();
+
+    _gpuLateSources.clear();
+
+    _stats = {};
+
+    _cameraPosition = uniforms.cameraPosition;
+
     std::uint32_t currentIndirectionOffset = 0;
+    std::uint32_t currentCommandOffset     = 0;
+
+    _commandOffsets.clear();
+
+    std::vector<const VulkanGraphicsPass*> gpuPasses{};
+    bool                                   gpuPassesChanged = false;
 
     for (const auto& pass : passes) {
         auto& visibleDraws = _visibleDrawCalls[pass.get()];
 
         visibleDraws.clear();
 
+        const VulkanGraphicsPassCullMode cullMode = pass->getGraphicsPassDescriptor().cullMode;
+
         // Check visibility for passes with culling enabled
-        if (pass->getGraphicsPassDescriptor().cullMode == VulkanGraphicsPassCullMode::None) {
+        if (cullMode == VulkanGraphicsPassCullMode::None) {
             for (auto& draw : pass->getDrawCalls())
                 visibleDraws.push_back(&draw);
 
+        } else if (cullMode == VulkanGraphicsPassCullMode::Gpu) {
+            // Culled by the draw cull pass, nothing to do on the CPU
+            const auto gpuPassData = _gpuPassData.find(pass.get());
+
+            gpuPassesChanged |= gpuPassData == _gpuPassData.end()
+                             || gpuPassData->second.drawCount != pass->getDrawCalls().size()
+                             || _indirectionOffsets[pass.get()] != currentIndirectionOffset;
+
+            gpuPasses.push_back(pass.get());
+
+        } else if (cullMode == VulkanGraphicsPassCullMode::GpuLate) {
+            // Draws the late phase commands of the closest preceding Gpu culled pass
+            if (!gpuPasses.empty()) _gpuLateSources[pass.get()] = gpuPasses.back();
+
         } else {
-            for (auto& drawCall : pass->getDrawCalls()) {
+            auto& drawCalls = pass->getDrawCalls();
 
-                bool visible = true;
+            PassCullData& cullData = _passCullData[pass.get()];
 
-                if (drawCall.getModelMatrix()) {
-                    Math::AABB worldAABB = drawCall.getRenderMesh().mesh->getAABB().transform(*drawCall.getModelMatrix());
+            // Split the draws into fixed ranges, kept across frames with their hierarchies
+            if (cullData.drawCount != drawCalls.size()) {
+                cullData.drawCount = drawCalls.size();
+                cullData.ranges.clear();
+                cullData.ranges.resize((drawCalls.size() + CULL_RANGE_SIZE - 1) / CULL_RANGE_SIZE);
 
-                    visible = FrustumCuller::testVisibility(worldAABB, frustumPlanes);
+                for (std::size_t i = 0; i < cullData.ranges.size(); i++) {
+                    cullData.ranges[i].begin = static_cast<std::uint32_t>(i * CULL_RANGE_SIZE);
+                    cullData.ranges[i].end   = static_cast<std::uint32_t>(
+                        std::min<std::size_t>((i + 1) * CULL_RANGE_SIZE, drawCalls.size())
+                    );
                 }
+            }
 
-                if (visible) {
-                    visibleDraws.push_back(&drawCall);
-                }
+            const bool occluderSource = pass->getGraphicsPassDescriptor().type == VulkanGraphicsPassType::MeshRender;
+
+            for (CullRange& range : cullData.ranges) {
+                range.drawCalls      = &drawCalls;
+                range.visibleDraws   = &visibleDraws;
+                range.occluderSource = occluderSource;
+
+                _cullJobs.push_back(&range);
             }
         }
 
         // Keep track of the indirection offset
         _indirectionOffsets[pass.get()] = currentIndirectionOffset;
 
-        currentIndirectionOffset += static_cast<std::uint32_t>(pass->getDrawCalls().size());
+        // Gpu culled draws have an instance slot per phase
+        const std::uint32_t phaseCount = cullMode == VulkanGraphicsPassCullMode::Gpu ? 2 : 1;
+
+        currentIndirectionOffset += phaseCount * static_cast<std::uint32_t>(pass->getDrawCalls().size());
 
         if (currentIndirectionOffset > MAX_DRAWS) {
             return VK_FAIL("Failed to cull frame: exceeded maximum draws.");
         }
+
+        // CPU culled mesh draws have a command slot each, batches use the first ones
+        const bool cpuCulled = cullMode == VulkanGraphicsPassCullMode::None
+                            || cullMode == VulkanGraphicsPassCullMode::Frustum;
+
+        const auto drawCount = static_cast<std::uint32_t>(pass->getDrawCalls().size());
+
+        if (_drawCommandBuffer && cpuCulled
+            && pass->getGraphicsPassDescriptor().type == VulkanGraphicsPassType::MeshRender
+            && currentCommandOffset + drawCount <= MAX_DRAW_COMMANDS) {
+            _commandOffsets[pass.get()] = currentCommandOffset;
+
+            currentCommandOffset += drawCount;
+        }
     }
 
+    // Cull every range in parallel, each job only writes to its own range
+    ParallelFor::forEachRange(_cullJobs.size(), 1, [&](const std::size_t begin, const std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            updateRange(*_cullJobs[i], *_objectManager);
+            cullRange(*_cullJobs[i], rangeContext);
+
+            if (_occlusionCulling) selectOccluders(*_cullJobs[i]);
+        }
+    });
+
+    // Occlusion culling of the frustum visible draws, before batching
+    if (_occlusionCulling) cullOcclusion(viewProjectionMatrix);
+
+    // Prefix sum of the range results, ranges of a pass are contiguous in the job list
+    std::vector<VulkanDrawCall*>* visibleDraws = nullptr;
+    std::size_t                   visibleCount = 0;
+
+    for (CullRange* range : _cullJobs) {
+        if (range->visibleDraws != visibleDraws) {
+            if (visibleDraws) visibleDraws->resize(visibleCount);
+
+            visibleDraws = range->visibleDraws;
+            visibleCount = 0;
+        }
+
+        range->outputOffset  = visibleCount;
+        visibleCount        += range->visibleIndices.size();
+    }
+
+    if (visibleDraws) visibleDraws->resize(visibleCount);
+
+    for (const CullRange* range : _cullJobs) {
+        _stats += range->stats;
+    }
+
+    // Scatter in parallel, each range owns a disjoint slice keeping the draw order deterministic
+    ParallelFor::forEachRange(_cullJobs.size(), 1, [&](const std::size_t begin, const std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            const CullRange& range = *_cullJobs[i];
+
+            for (std::size_t j = 0; j < range.visibleIndices.size(); j++) {
+                (*range.visibleDraws)[range.outputOffset + j] = &(*range.drawCalls)[range.visibleIndices[j]];
+            }
+        }
+    });
+
+    // Forget passes that are gone, their addresses may be reused
+    std::erase_if(_passCullData, [this](const auto& entry) { return !_visibleDrawCalls.contains(entry.first); });
+
+    if (!_gpuCulling) {
+        if (!gpuPasses.empty()) return VK_FAIL("Failed to cull frame: Gpu cull mode pass without GPU culling.");
+        return {};
+    }
+
+    if (gpuPassesChanged || gpuPasses.size() != _gpuPassData.size()) {
+        TRY(buildGpuDraws(gpuPasses));
+    }
+
+    updateGpuDraws(computePasses, frustumPlanes, contribution, frameIndex);
+
     return {};
 }
+
+void VulkanFrameCuller::updateRange(CullRange& range, const ObjectManager& objectManager) {
+    const std::uint64_t dynamicGeneration = objectManager.getDynamicGeneration();
+
+    // Static draws never move, the hierarchy is only rebuilt when objects become dynamic
+    if (range.built && range.dynamicGeneration == dynamicGeneration) return;
+
+    range.drawIndices.clear();
+    range.unboundedDraws.clear();
+    range.dynamicDraws.clear();
+
+    range.boundsScratch.clear();
+
+    for (std::uint32_t i = range.begin; i < range.end; i++) {
+        const VulkanDrawCall& drawCall    = (*range.drawCalls)[i];
+        const Math::Bounds*   worldBounds = drawCall.getWorldBounds();
+
+        if (!worldBounds) {
+            range.unboundedDraws.push_back(i);
+        } else if (objectManager.isDynamic(drawCall.getInstanceHandle().objectIndex)) {
+            range.dynamicDraws.push_back(i);
+        } else {
+            range.boundsScratch.push_back(*worldBounds);
+            range.drawIndices.push_back(i);
+        }
+    }
+
+    range.bvh.build(range.boundsScratch);
+
+    range.built             = true;
+    range.coherent          = false;
+    range.dynamicGeneration = dynamicGeneration;
+}
+
+void VulkanFrameCuller::cullRange(CullRange& range, const RangeCullContext& context) {
+    const std::array<Math::Plane, 6>& frustumPlanes = context.frustumPlanes;
+    const CoherenceParams&            coherence     = context.coherence;
+
+    range.stats           = {};
+    range.stats.drawCount = range.end - range.begin;
+
+    if (!coherence.enabled) {
+        // Draws without bounds are always visible
+        range.visibleIndices.assign(range.unboundedDraws.begin(), range.unboundedDraws.end());
+
+        const std::size_t firstBounded = range.visibleIndices.size();
+
+        range.bvh.cull(frustumPlanes, range.visibleIndices);
+
+        for (std::size_t i = firstBounded; i < range.visibleIndices.size(); i++) {
+            range.visibleIndices[i] = range.drawIndices[range.visibleIndices[i]];
+        }
+
+        // Restore draw order
+        std::ranges::sort(range.visibleIndices);
+
+        range.coherent = false;
+    } else {
+        if (coherence.fullTest || !range.coherent)
+            testRangeFrustum(range, frustumPlanes, coherence);
+        else
+            retestRangeFrustum(range, frustumPlanes, coherence);
+
+        range.visibleIndices.assign(range.frustumVisible.begin(), range.frustumVisible.end());
+    }
+
+    // Dynamic draws of the objects returned by the object grid, merged back in draw order
+    const auto staticVisibleCount = static_cast<std::ptrdiff_t>(range.visibleIndices.size());
+
+    for (const std::uint32_t drawIndex : range.dynamicDraws) {
+        const VulkanDrawCall& drawCall = (*range.drawCalls)[drawIndex];
+
+        if (!testBit(*context.dynamicVisibleObjects, drawCall.getInstanceHandle().objectIndex)) continue;
+
+        if (getFrustumMargin(*drawCall.getWorldBounds(), frustumPlanes) >= 0.0f) {
+            range.visibleIndices.push_back(drawIndex);
+        }
+    }
+
+    std::inplace_merge(
+        range.visibleIndices.begin(), range.visibleIndices.begin() + staticVisibleCount, range.visibleIndices.end()
+    );
+
+    range.stats.frustumCulled = range.stats.drawCount - static_cast<std::uint32_t>(range.visibleIndices.size());
+
+    // Screen space size and draw distance rejection of the frustum visible draws, keeps the draw order
+    std::erase_if(range.visibleIndices, [&](const std::uint32_t drawIndex) {
+        const VulkanDrawCall& drawCall    = (*range.drawCalls)[drawIndex];
+        const VulkanMaterial* material    = drawCall.getRenderMesh().material;
+        const Math::Bounds*   worldBounds = drawCall.getWorldBounds();
+
+        if (!worldBounds) return false;
+
+        const CullResult result = testContribution(
+            *worldBounds, material ? material->getMaxDrawDistance() : 0.0f, context.contribution
+        );
+
+        if (result == CullResult::Contribution) range.stats.contributionCulled++;
+        if (result == CullResult::Distance)     range.stats.distanceCulled++;
+
+        return result != CullResult::Visible;
+    });
+}
+
+void VulkanFrameCuller::testRangeFrustum(
+    CullRange& range, const std::array<Math::Plane, 6>& frustumPlanes, const CoherenceParams& coherence
+) {
+    const std::size_t wordCount = (range.end - range.begin + 63) / 64;
+
+    range.visibilityBits.assign(wordCount, 0);
+    range.boundaryBits.assign(wordCount, 0);
+    range.boundaryDraws.clear();
+
+    // Draws without bounds are always visible
+    for (const std::uint32_t drawIndex : range.unboundedDraws) {
+        setBit(range.visibilityBits, drawIndex - range.begin, true);
+    }
+
+    const auto& nodes = range.bvh.getNodes();
+
+    if (!nodes.empty()) {
+        const Math::AABB& rootAABB   = nodes.front().aabb;
+        const glm::vec3   rootCenter = (rootAABB.minBound + rootAABB.maxBound) * 0.5f;
+        const float       rootRadius = glm::length(rootAABB.maxBound - rootAABB.minBound) * 0.5f;
+
+        // Draws outside by more than the widest band of the range stay invisible until the next full test
+        const float maxBand = getHysteresisBand(
+            glm::distance(rootCenter, coherence.cameraPosition) + rootRadius, rootRadius
+        );
+
+        std::array<Math::Plane, 6> widenedPlanes = frustumPlanes;
+
+        for (auto& plane : widenedPlanes) {
+            plane.d += maxBand;
+        }
+
+        range.coherenceCandidates.clear();
+        range.bvh.cull(widenedPlanes, range.coherenceCandidates);
+
+        for (const std::uint32_t candidate : range.coherenceCandidates) {
+            classifyDraw(range, range.drawIndices[candidate], frustumPlanes, coherence);
+        }
+    }
+
+    updateFrustumVisible(range);
+
+    range.coherent = true;
+}
+
+void VulkanFrameCuller::retestRangeFrustum(
+    CullRange& range, const std::array<Math::Plane, 6>& frustumPlanes, const CoherenceParams& coherence
+) {
+    // Draws away from the planes keep their visibility until the camera moves past the thresholds
+    if (range.boundaryDraws.empty()) return;
+
+    for (const std::uint32_t drawIndex : range.boundaryDraws) {
+        classifyDraw(range, drawIndex, frustumPlanes, coherence);
+    }
+
+    updateFrustumVisible(range);
+}
+
+void VulkanFrameCuller::classifyDraw(
+    CullRange&                        range,
+    const std::uint32_t               drawIndex,
+    const std::array<Math::Plane, 6>& frustumPlanes,
+    const CoherenceParams&            coherence
+) {
+    const Math::Bounds& bounds = *(*range.drawCalls)[drawIndex].getWorldBounds();
+
+    const std::uint32_t bit    = drawIndex - range.begin;
+    const float         margin = getFrustumMargin(bounds, frustumPlanes);
+
+    setBit(range.visibilityBits, bit, margin >= 0.0f);
+
+    const float band = getHysteresisBand(
+        glm::distance(bounds.center, coherence.cameraPosition), glm::length(bounds.extent)
+    );
+
+    if (std::abs(margin) < band && !testBit(range.boundaryBits, bit)) {
+        setBit(range.boundaryBits, bit, true);
+        range.boundaryDraws.push_back(drawIndex);
+    }
+}
+
+void VulkanFrameCuller::updateFrustumVisible(CullRange& range) {
+    range.frustumVisible.clear();
+
+    for (std::size_t word = 0; word < range.visibilityBits.size(); word++) {
+        std::uint64_t bits = range.visibilityBits[word];
+
+        while (bits) {
+            const auto bit = static_cast<std::uint32_t>(word * 64 + std::countr_zero(bits));
+            range.frustumVisible.push_back(range.begin + bit);
+
+            bits &= bits - 1;
+        }
+    }
+}
+
+VulkanFrameCuller::CoherenceParams VulkanFrameCuller::updateCoherence(const FrameUniforms& uniforms) {
+    if (!_temporalCoherence) {
+        _coherenceReference.valid = false;
+        return {};
+    }
+
+    // Rotation between the reference and current view, angle from its trace
+    const glm::mat3 rotation =
+        glm::mat3(uniforms.viewMatrix) * glm::transpose(glm::mat3(_coherenceReference.viewMatrix));
+
+    const float cosAngle = (rotation[0][0] + rotation[1][1] + rotation[2][2] - 1.0f) * 0.5f;
+
+    const bool fullTest = !_coherenceReference.valid
+                       || uniforms.projectionMatrix != _coherenceReference.projectionMatrix
+                       || glm::distance(uniforms.cameraPosition, _coherenceReference.cameraPosition)
+                              > COHERENCE_MAX_CAMERA_DISTANCE
+                       || cosAngle < std::cos(COHERENCE_MAX_CAMERA_ANGLE);
+
+    if (fullTest) {
+        _coherenceReference = {
+            .viewMatrix       = uniforms.viewMatrix,
+            .projectionMatrix = uniforms.projectionMatrix,
+            .cameraPosition   = uniforms.cameraPosition,
+            .valid            = true
+        };
+    }
+
+    return {.enabled = true, .fullTest = fullTest, .cameraPosition = _coherenceReference.cameraPosition};
+}
+
+VulkanFrameCuller::CullResult VulkanFrameCuller::testContribution(
+    const Math::Bounds& worldBounds, const float maxDrawDistance, const ContributionParams& contribution
+) noexcept {
+    const float radius   = glm::length(worldBounds.extent);
+    const float distance = glm::distance(worldBounds.center, contribution.cameraPosition);
+
+    // The camera is inside the bounding sphere
+    if (distance <= radius) return CullResult::Visible;
+
+    if (maxDrawDistance > 0.0f && distance - radius > maxDrawDistance) return CullResult::Distance;
+
+    if (radius * contribution.contributionScale < contribution.minContribution * distance) {
+        return CullResult::Contribution;
+    }
+
+    return CullResult::Visible;
+}
+
+void VulkanFrameCuller::selectOccluders(CullRange& range) {
+    range.occluders.clear();
+
+    if (!range.occluderSource) return;
+
+    for (const std::uint32_t drawIndex : range.visibleIndices) {
+        const VulkanDrawCall& drawCall = (*range.drawCalls)[drawIndex];
+
+        const Mesh*         mesh        = drawCall.getRenderMesh().mesh;
+        const glm::mat4*    modelMatrix = drawCall.getModelMatrix();
+        const Math::Bounds* worldBounds = drawCall.getWorldBounds();
+
+        if (!mesh || !modelMatrix || !worldBounds) continue;
+
+        const float volume = 8.0f * worldBounds->extent.x * worldBounds->extent.y * worldBounds->extent.z;
+
+        // Alpha tested and blended surfaces do not hide what is behind them
+        const bool autoOccluder = volume >= MIN_OCCLUDER_VOLUME
+                               && mesh->getIndices().size() / 3 <= MAX_OCCLUDER_TRIANGLES
+                               && !mesh->getMaterial().hasTransparency;
+
+        if (mesh->isOccluder() || autoOccluder) {
+            range.occluders.push_back({mesh, modelMatrix});
+        }
+    }
+}
+
+void VulkanFrameCuller::cullOcclusion(const glm::mat4& viewProjectionMatrix) {
+    _occluders.clear();
+
+    // Job order keeps the occluder set deterministic
+    for (const CullRange* range : _cullJobs) {
+        const std::size_t remaining = MAX_OCCLUDERS - _occluders.size();
+
+        _occluders.insert(
+            _occluders.end(),
+            range->occluders.begin(),
+            range->occluders.begin() + static_cast<std::ptrdiff_t>(std::min(remaining, range->occluders.size()))
+        );
+
+        if (_occluders.size() == MAX_OCCLUDERS) break;
+    }
+
+    if (_occluders.empty()) return;
+
+    _occlusionCuller.render(viewProjectionMatrix, _occluders);
+
+    ParallelFor::forEachRange(_cullJobs.size(), 1, [&](const std::size_t begin, const std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            CullRange& range = *_cullJobs[i];
+
+            range.stats.occlusionCulled = static_cast<std::uint32_t>(
+                std::erase_if(range.visibleIndices, [&](const std::uint32_t drawIndex) {
+                    const Math::Bounds* worldBounds = (*range.drawCalls)[drawIndex].getWorldBounds();
+                    return worldBounds && !_occlusionCuller.testVisibility(*worldBounds);
+                })
+            );
+        }
+    });
+}
+
+Expected<void> VulkanFrameCuller::buildGpuDraws(const std::vector<const VulkanGraphicsPass*>& gpuPasses) {
+    _gpuPassData.clear();
+    _gpuDrawRecords.clear();
+
+    std::uint32_t groupCount   = 0;
+    std::uint32_t commandCount = 0;
+
+    std::vector<std::uint32_t> indexedDraws{};
+
+    for (const VulkanGraphicsPass* pass : gpuPasses) {
+        const auto& drawCalls = pass->getDrawCalls();
+
+        GpuPassData& passData = _gpuPassData[pass];
+        passData.drawCount    = drawCalls.size();
+
+        // Materials are indexed per instance, every indexed draw of the pass shares a single group
+        indexedDraws.clear();
+
+        for (std::uint32_t i = 0; i < drawCalls.size(); i++) {
+            const VulkanMesh* mesh = drawCalls[i].getRenderMesh().mesh;
+
+            if (!mesh || mesh->isBufferless() || !mesh->getIndexBuffer()) continue;
+
+            passData.vertexBuffer = mesh->getVertexBuffer();
+            passData.indexBuffer  = mesh->getIndexBuffer();
+
+            indexedDraws.push_back(i);
+        }
+
+        if (indexedDraws.empty()) continue;
+
+        if (groupCount == MAX_GPU_DRAW_GROUPS || commandCount + indexedDraws.size() > MAX_GPU_DRAWS) {
+            return VK_FAIL("Failed to build GPU draws: exceeded maximum GPU draws.");
+        }
+
+        // Every draw owns a command slot within the group, late phase instances are in the second half of the pass
+        // indirection range
+        const std::uint32_t firstInstance = _indirectionOffsets.at(pass);
+
+        const auto lateInstanceOffset = static_cast<std::uint32_t>(drawCalls.size());
+
+        const GpuDrawGroup drawGroup{commandCount, static_cast<std::uint32_t>(indexedDraws.size()), groupCount};
+
+        for (const std::uint32_t drawIndex : indexedDraws) {
+            const VulkanDrawCall& drawCall = drawCalls[drawIndex];
+            const VulkanMesh&     mesh     = *drawCall.getRenderMesh().mesh;
+            const VulkanMaterial* material = drawCall.getRenderMesh().material;
+            const Math::AABB&     aabb     = mesh.getAABB();
+
+            // Draws without valid bounds are never culled, same as on the CPU
+            const bool bounded = drawCall.getWorldBounds() && aabb.minBound.x <= aabb.maxBound.x;
+
+            _gpuDrawRecords.push_back({
+                .boundsCenter      = bounded ? (aabb.minBound + aabb.maxBound) * 0.5f : glm::vec3(0.0f),
+                .objectIndex       = drawCall.getInstanceHandle().objectIndex,
+                .boundsExtent      = bounded ? (aabb.maxBound - aabb.minBound) * 0.5f : glm::vec3(-1.0f),
+                .group             = drawGroup.countIndex,
+                .indexCount        = static_cast<std::uint32_t>(mesh.getIndices().size()),
+                .firstIndex        = static_cast<std::uint32_t>(mesh.getIndexOffset() / sizeof(std::uint32_t)),
+                .vertexOffset      = static_cast<std::int32_t>(mesh.getVertexOffset() / sizeof(Vertex)),
+                .firstCommand      = drawGroup.firstCommand,
+                .firstInstance     = firstInstance,
+                .lateFirstInstance = firstInstance + lateInstanceOffset,
+                .maxDrawDistance   = material ? material->getMaxDrawDistance() : 0.0f,
+                .materialIndex     = material ? material->getMaterialIndex() : 0
+            });
+        }
+
+        passData.groups.push_back(drawGroup);
+
+        groupCount   += 1;
+        commandCount += drawGroup.maxDrawCount;
+    }
+
+    _gpuDrawCountsReset.assign(groupCount, 0);
+
+    _gpuRecordsUploaded.assign(_framesInFlight, false);
+
+    // Record indices changed, the next early phase has no visibility to rely on
+    _gpuVisibilityValid = false;
+
+    return {};
+}
+
+void VulkanFrameCuller::updateGpuDraws(
+    const std::vector<std::unique_ptr<VulkanComputePass>>& computePasses,
+    const std::array<Math::Plane, 6>&                      frustumPlanes,
+    const ContributionParams&                              contribution,
+    const std::uint32_t                                    frameIndex
+) {
+    const auto drawCount = static_cast<std::uint32_t>(_gpuDrawRecords.size());
+
+    // Counted by the last use of this frame in flight buffer, its fence was waited on
+    const auto* gpuStats = static_cast<const GpuCullStats*>(
+        _gpuCullStatsBuffer->getBuffers()[frameIndex].getMappedPointer()
+    );
+
+    _stats.drawCount          += drawCount;
+    _stats.frustumCulled      += gpuStats->frustumCulled;
+    _stats.occlusionCulled    += gpuStats->occlusionCulled;
+    _stats.contributionCulled += gpuStats->contributionCulled;
+    _stats.distanceCulled     += gpuStats->distanceCulled;
+
+    _gpuCullStatsBuffer->updateMemory(frameIndex, GpuCullStats{});
+
+    const bool twoPhase = std::ranges::any_of(computePasses, [](const auto& computePass) {
+        return computePass->getComputePassDescriptor().type == VulkanComputePassType::DrawCullLate;
+    });
+
+    if (drawCount > 0) {
+        if (!_gpuRecordsUploaded[frameIndex]) {
+            _gpuDrawRecordBuffer->updateArrayMemory(frameIndex, _gpuDrawRecords);
+            _gpuRecordsUploaded[frameIndex] = true;
+        }
+
+        GpuCullParams params{};
+        params.cameraPosition    = contribution.cameraPosition;
+        params.contributionScale = contribution.contributionScale;
+        params.minContribution   = contribution.minContribution;
+        params.drawCount         = drawCount;
+        params.twoPhase          = twoPhase;
+        params.visibilityValid   = _gpuVisibilityValid;
+        params.lateCommandOffset = MAX_GPU_DRAWS;
+        params.lateCountOffset   = MAX_GPU_DRAW_GROUPS;
+
+        for (std::size_t i = 0; i < frustumPlanes.size(); i++) {
+            params.frustumPlanes[i] = glm::vec4(frustumPlanes[i].normal, frustumPlanes[i].d);
+        }
+
+        _gpuCullParamsBuffer->updateMemory(frameIndex, params);
+
+        // The buffer of this frame in flight is no longer in use, counts are reset from the host
+        _gpuCountBuffer->updateArrayMemory(frameIndex, _gpuDrawCountsReset);
+
+        if (twoPhase) _gpuCountBuffer->updateArrayMemory(frameIndex, _gpuDrawCountsReset, MAX_GPU_DRAW_GROUPS);
+
+        // Written by the late phase of this frame, frames execute in submission order
+        _gpuVisibilityValid = true;
+    }
+
+    // One thread per draw record, one dispatch per level for the depth pyramid
+    for (const auto& computePass : computePasses) {
+        const VulkanComputePassType type = computePass->getComputePassDescriptor().type;
+
+        if (type == VulkanComputePassType::DepthPyramid) {
+            _depthPyramid.updateDispatches(*computePass);
+            continue;
+        }
+
+        if (type != VulkanComputePassType::DrawCull && type != VulkanComputePassType::DrawCullLate) continue;
+
+        if (computePass->getDispatchCalls().empty()) {
+            computePass->emplaceDispatchCall().name = computePass->getComputePassDescriptor().base.name;
+        }
+
+        computePass->getDispatchCalls().front().groupCountX =
+            (drawCount + GPU_CULL_GROUP_SIZE - 1) / GPU_CULL_GROUP_SIZE;
+    }
+}
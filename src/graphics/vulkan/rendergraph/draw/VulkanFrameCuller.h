@@ -1,5 +1,11 @@
 #pragma once
 
+#include "core/entities/objects/ObjectManager.h"
+#include "core/render/BoundingVolumeHierarchy.h"
+#include "core/render/OcclusionCuller.h"
+
+#include "graphics/vulkan/rendergraph/draw/VulkanDepthPyramid.h"
+#include "graphics/vulkan/rendergraph/nodes/VulkanComputePass.h"
 #include "graphics/vulkan/rendergraph/nodes/VulkanGraphicsPass.h"
 
 #include "graphics/vulkan/resources/frame/VulkanFrameResources.h"
@@ -9,6 +15,112 @@ class VulkanFrameCuller {
 public:
     static constexpr std::uint32_t MAX_DRAWS = 5'000'000;
 
+    // Draws per parallel cull job
+    static constexpr std::uint32_t CULL_RANGE_SIZE = 4096;
+
+    // Temporal coherence: frustum visibility is fully re-tested only once the camera moved or turned past these
+    // since the last full test, in between only the static draws near a plane are re-tested
+    static constexpr float COHERENCE_MAX_CAMERA_DISTANCE = 0.25f;
+    static constexpr float COHERENCE_MAX_CAMERA_ANGLE    = 0.01f; // Radians
+
+    // Automatic occluder selection: large, low-poly and opaque meshes of the mesh render passes
+    static constexpr float       MIN_OCCLUDER_VOLUME    = 8.0f;
+    static constexpr std::size_t MAX_OCCLUDER_TRIANGLES = 2048;
+    static constexpr std::size_t MAX_OCCLUDERS          = 256;
+
+    // GPU driven culling of the Gpu cull mode passes, one thread per draw
+    // Commands and counts of the late phase follow the early phase ones
+    static constexpr std::uint32_t MAX_GPU_DRAWS       = 262'144;
+    static constexpr std::uint32_t MAX_GPU_DRAW_GROUPS = 4096;
+    static constexpr std::uint32_t GPU_CULL_GROUP_SIZE = 64;
+
+    // Indirect commands of the CPU culled mesh passes, a slot per draw, passes past the limit draw directly
+    static constexpr std::uint32_t MAX_DRAW_COMMANDS = 262'144;
+
+    // Draws whose bounding sphere projects below this many pixels are rejected
+    static constexpr float DEFAULT_MIN_CONTRIBUTION = 1.0f;
+
+    // Static draw data read by the draw cull shader (std430), bounds are in object space
+    struct alignas(16) GpuDrawRecord {
+        glm::vec3     boundsCenter;
+        std::uint32_t objectIndex;
+        glm::vec3     boundsExtent; // Negative for draws that are never culled
+        std::uint32_t group;
+        std::uint32_t indexCount;
+        std::uint32_t firstIndex;
+        std::int32_t  vertexOffset;
+        std::uint32_t firstCommand;
+        std::uint32_t firstInstance;
+        std::uint32_t lateFirstInstance;
+        float         maxDrawDistance; // Material max draw distance, 0 for unlimited
+        std::uint32_t materialIndex;
+    };
+
+    static_assert(sizeof(GpuDrawRecord) == 64);
+
+    struct alignas(16) GpuCullParams {
+        std::array<glm::vec4, 6> frustumPlanes;
+
+        glm::vec3 cameraPosition;
+        float     contributionScale;
+        float     minContribution;
+
+        std::uint32_t drawCount;
+
+        // Two phase occlusion culling, the early phase only draws what was visible last frame
+        std::uint32_t twoPhase;
+        std::uint32_t visibilityValid;
+        std::uint32_t lateCommandOffset;
+        std::uint32_t lateCountOffset;
+    };
+
+    // Counted by the last draw cull pass of the frame, one atomic per wave and stage
+    struct GpuCullStats {
+        std::uint32_t frustumCulled;
+        std::uint32_t occlusionCulled;
+        std::uint32_t contributionCulled;
+        std::uint32_t distanceCulled;
+    };
+
+    // Culled draw counts per stage, GPU counters are read back when their frame in flight is reused
+    struct CullStats {
+        std::uint32_t drawCount          = 0;
+        std::uint32_t frustumCulled      = 0;
+        std::uint32_t occlusionCulled    = 0;
+        std::uint32_t contributionCulled = 0;
+        std::uint32_t distanceCulled     = 0;
+
+        [[nodiscard]] std::uint32_t getCulledCount() const noexcept {
+            return frustumCulled + occlusionCulled + contributionCulled + distanceCulled;
+        }
+
+        CullStats& operator+=(const CullStats& other) noexcept {
+            drawCount          += other.drawCount;
+            frustumCulled      += other.frustumCulled;
+            occlusionCulled    += other.occlusionCulled;
+            contributionCulled += other.contributionCulled;
+            distanceCulled     += other.distanceCulled;
+            return *this;
+        }
+    };
+
+    // Indexed draws of a Gpu culled pass, drawn by a single indirect count draw
+    struct GpuDrawGroup {
+        std::uint32_t firstCommand = 0;
+        std::uint32_t maxDrawCount = 0;
+        std::uint32_t countIndex   = 0;
+    };
+
+    struct GpuPassData {
+        std::vector<GpuDrawGroup> groups{};
+
+        std::size_t drawCount = 0;
+
+        // Meshes share the mesh manager buffers, bound once per pass
+        const VulkanBuffer* vertexBuffer = nullptr;
+        const VulkanBuffer* indexBuffer  = nullptr;
+    };
+
     VulkanFrameCuller()  = default;
     ~VulkanFrameCuller() = default;
 
@@ -21,12 +133,24 @@ public:
     [[nodiscard]] Expected<void> create(
         const VulkanDevice&         device,
         VulkanStorageBufferManager& storageBufferManager,
-        std::uint32_t               framesInFlight
+        const ObjectManager&        objectManager,
+        std::uint32_t               framesInFlight,
+        bool                        gpuCulling
     ) noexcept;
 
     void destroy() noexcept;
 
-    Expected<void> cull(const std::vector<std::unique_ptr<VulkanGraphicsPass>>& passes, const FrameUniforms& uniforms);
+    // Follows the depth buffer extent, the device must be idle
+    [[nodiscard]] Expected<void> resizeDepthPyramid(
+        const VulkanImage& depthImage, const VulkanCommandManager& commandManager
+    );
+
+    Expected<void> cull(
+        const std::vector<std::unique_ptr<VulkanGraphicsPass>>& passes,
+        const std::vector<std::unique_ptr<VulkanComputePass>>&  computePasses,
+        const FrameUniforms&                                    uniforms,
+        std::uint32_t                                           frameIndex
+    );
 
     [[nodiscard]] const std::vector<VulkanDrawCall*>& getDrawCalls(const VulkanGraphicsPass* pass) const {
         return _visibleDrawCalls.at(pass);
@@ -36,26 +160,286 @@ public:
         return _indirectionOffsets.at(pass);
     }
 
+    // First command slot of a pass drawn with multi-draw indirect, none for passes drawn directly
+    [[nodiscard]] std::optional<std::uint32_t> getCommandOffset(const VulkanGraphicsPass* pass) const {
+        const auto commandOffset = _commandOffsets.find(pass);
+
+        if (commandOffset == _commandOffsets.end()) return std::nullopt;
+        return commandOffset->second;
+    }
+
+    // Late phase passes share the data of their early pass
+    [[nodiscard]] const GpuPassData* getGpuPassData(const VulkanGraphicsPass* pass) const {
+        const auto lateSource = _gpuLateSources.find(pass);
+        const auto passData   = _gpuPassData.find(lateSource != _gpuLateSources.end() ? lateSource->second : pass);
+
+        return passData != _gpuPassData.end() ? &passData->second : nullptr;
+    }
+
     [[nodiscard]] static VulkanDescriptorScheme getDescriptorScheme() noexcept {
+        static constexpr vk::ShaderStageFlags objectIndicesStages =
+            vk::ShaderStageFlagBits::eVertex | vk::ShaderStageFlagBits::eCompute;
+
         static const VulkanDescriptorScheme scheme = {
-            {0, vk::DescriptorType::eStorageBuffer, vk::ShaderStageFlagBits::eVertex}
+            {0, vk::DescriptorType::eStorageBuffer, objectIndicesStages},
+            {1, vk::DescriptorType::eStorageBuffer, vk::ShaderStageFlagBits::eCompute}, // Draw records
+            {2, vk::DescriptorType::eStorageBuffer, vk::ShaderStageFlagBits::eCompute}, // Indirect commands
+            {3, vk::DescriptorType::eStorageBuffer, vk::ShaderStageFlagBits::eCompute}, // Draw counts
+            {4, vk::DescriptorType::eStorageBuffer, vk::ShaderStageFlagBits::eCompute}, // Cull parameters
+            {5, vk::DescriptorType::eStorageBuffer, vk::ShaderStageFlagBits::eCompute}, // Draw visibility
+            {6, vk::DescriptorType::eCombinedImageSampler, vk::ShaderStageFlagBits::eCompute}, // Depth pyramid
+            {7, vk::DescriptorType::eStorageBuffer, vk::ShaderStageFlagBits::eCompute}, // Cull statistics
+            {8, vk::DescriptorType::eStorageBuffer, objectIndicesStages} // Instance material indices
         };
         return scheme;
     }
 
+    void setOcclusionCulling(const bool enabled) noexcept { _occlusionCulling = enabled; }
+
+    [[nodiscard]] bool isOcclusionCullingEnabled() const noexcept { return _occlusionCulling; }
+
+    void setTemporalCoherence(const bool enabled) noexcept { _temporalCoherence = enabled; }
+
+    [[nodiscard]] bool isTemporalCoherenceEnabled() const noexcept { return _temporalCoherence; }
+
+    // Projected size threshold in pixels, 0 disables contribution culling
+    void setContributionThreshold(const float pixels) noexcept { _minContribution = pixels; }
+
+    [[nodiscard]] float getContributionThreshold() const noexcept { return _minContribution; }
+
+    [[nodiscard]] const CullStats& getStats() const noexcept { return _stats; }
+
+    // Camera of the last cull, draw batches are depth ordered from it
+    [[nodiscard]] const glm::vec3& getCameraPosition() const noexcept { return _cameraPosition; }
+
+    [[nodiscard]] const OcclusionCuller& getOcclusionCuller() const noexcept { return _occlusionCuller; }
+
+    [[nodiscard]] const VulkanDepthPyramid& getDepthPyramid() const noexcept { return _depthPyramid; }
+
     [[nodiscard]] const VulkanDescriptorManager& getDescriptorManager() const noexcept { return _descriptorManager; }
 
     [[nodiscard]] VulkanStorageBuffer* getIndirectionBuffer() const noexcept { return _indirectionBuffer; }
 
+    [[nodiscard]] const VulkanStorageBuffer* getInstanceMaterialBuffer() const noexcept {
+        return _instanceMaterialBuffer;
+    }
+
+    [[nodiscard]] const VulkanStorageBuffer* getDrawCommandBuffer() const noexcept { return _drawCommandBuffer; }
+
+    [[nodiscard]] const VulkanStorageBuffer* getGpuCommandBuffer() const noexcept { return _gpuCommandBuffer; }
+    [[nodiscard]] const VulkanStorageBuffer* getGpuCountBuffer() const noexcept { return _gpuCountBuffer; }
+
     [[nodiscard]] const VulkanDescriptorSets* getDescriptorSets() const noexcept { return _indirectionDescriptors; }
 
 private:
     std::unordered_map<const VulkanGraphicsPass*, std::vector<VulkanDrawCall*>> _visibleDrawCalls{};
 
     std::unordered_map<const VulkanGraphicsPass*, std::uint32_t> _indirectionOffsets{};
+    std::unordered_map<const VulkanGraphicsPass*, std::uint32_t> _commandOffsets{};
+
+    enum class CullResult : std::uint8_t {
+        Visible,
+        Contribution,
+        Distance
+    };
+
+    // Screen space size and draw distance rejection, shared by the CPU and GPU paths
+    struct ContributionParams {
+        glm::vec3 cameraPosition{0.0f};
+
+        // Projected bounding sphere diameter in pixels is radius * contributionScale / distance
+        float contributionScale = 0.0f;
+        float minContribution   = 0.0f;
+    };
+
+    struct CoherenceParams {
+        bool enabled  = false;
+        bool fullTest = true;
+
+        // Camera position of the last full test
+        glm::vec3 cameraPosition{0.0f};
+    };
+
+    // Per frame inputs shared by the range cull jobs
+    struct RangeCullContext {
+        std::array<Math::Plane, 6> frustumPlanes{};
+        ContributionParams         contribution{};
+        CoherenceParams            coherence{};
+
+        // Bit per object index, set for the dynamic objects returned by the object grid frustum query
+        const std::vector<std::uint64_t>* dynamicVisibleObjects = nullptr;
+    };
+
+    struct CoherenceReference {
+        glm::mat4 viewMatrix{1.0f};
+        glm::mat4 projectionMatrix{1.0f};
+        glm::vec3 cameraPosition{0.0f};
+
+        bool valid = false;
+    };
+
+    // Fixed range of draws of a frustum culled pass, culled independently on the ParallelFor pool
+    struct CullRange {
+        VulkanGraphicsPass::DrawCallsVector* drawCalls    = nullptr;
+        std::vector<VulkanDrawCall*>*        visibleDraws = nullptr;
+
+        std::uint32_t begin = 0;
+        std::uint32_t end   = 0;
+
+        // Hierarchy over the range draw bounds, BVH primitive ID to draw index
+        BoundingVolumeHierarchy    bvh{};
+        std::vector<std::uint32_t> drawIndices{};
+        std::vector<std::uint32_t> unboundedDraws{};
+
+        // Draws of dynamic objects, culled through the dynamic object grid every frame
+        std::vector<std::uint32_t> dynamicDraws{};
+
+        std::uint64_t dynamicGeneration = 0;
+
+        bool built = false;
+
+        // Draws of mesh render passes may occlude others
+        bool occluderSource = false;
+
+        // Written only by the job culling this range, sorted draw indices
+        std::vector<std::uint32_t>             visibleIndices{};
+        std::vector<OcclusionCuller::Occluder> occluders{};
+        std::vector<Math::Bounds>              boundsScratch{};
+
+        // Temporal coherence, frustum visibility bits of the range draws and the draws within the hysteresis band
+        // of a plane at the last full test
+        std::vector<std::uint64_t> visibilityBits{};
+        std::vector<std::uint64_t> boundaryBits{};
+        std::vector<std::uint32_t> boundaryDraws{};
+        std::vector<std::uint32_t> frustumVisible{};
+        std::vector<std::uint32_t> coherenceCandidates{};
+
+        bool coherent = false;
+
+        CullStats stats{};
+
+        // Position of the range results in the pass visible list
+        std::size_t outputOffset = 0;
+    };
+
+    struct PassCullData {
+        std::vector<CullRange> ranges{};
+
+        std::size_t drawCount = 0;
+    };
+
+    // Rebuilds when the draw list changed or objects became dynamic
+    static void updateRange(CullRange& range, const ObjectManager& objectManager);
+
+    static void cullRange(CullRange& range, const RangeCullContext& context);
+
+    // Classifies the draws near the frustum and rebuilds the visibility bits
+    static void testRangeFrustum(
+        CullRange& range, const std::array<Math::Plane, 6>& frustumPlanes, const CoherenceParams& coherence
+    );
+
+    // Re-tests the boundary draws only
+    static void retestRangeFrustum(
+        CullRange& range, const std::array<Math::Plane, 6>& frustumPlanes, const CoherenceParams& coherence
+    );
+
+    static void classifyDraw(
+        CullRange&                        range,
+        std::uint32_t                     drawIndex,
+        const std::array<Math::Plane, 6>& frustumPlanes,
+        const CoherenceParams&            coherence
+    );
+
+    static void updateFrustumVisible(CullRange& range);
+
+    // Moves the reference camera when a full test is due
+    [[nodiscard]] CoherenceParams updateCoherence(const FrameUniforms& uniforms);
+
+    [[nodiscard]] static CullResult testContribution(
+        const Math::Bounds& worldBounds, float maxDrawDistance, const ContributionParams& contribution
+    ) noexcept;
+
+    static void selectOccluders(CullRange& range);
+
+    // Rasterizes the selected occluders and drops the occluded draws from every range
+    void cullOcclusion(const glm::mat4& viewProjectionMatrix);
+
+    // Lays out the draw records and draw groups of the Gpu culled passes
+    [[nodiscard]] Expected<void> buildGpuDraws(const std::vector<const VulkanGraphicsPass*>& gpuPasses);
+
+    void updateGpuDraws(
+        const std::vector<std::unique_ptr<VulkanComputePass>>& computePasses,
+        const std::array<Math::Plane, 6>&                      frustumPlanes,
+        const ContributionParams&                              contribution,
+        std::uint32_t                                          frameIndex
+    );
+
+    std::unordered_map<const VulkanGraphicsPass*, PassCullData> _passCullData{};
+
+    // Ranges culled this frame across all passes
+    std::vector<CullRange*> _cullJobs{};
+
+    OcclusionCuller                        _occlusionCuller{};
+    std::vector<OcclusionCuller::Occluder> _occluders{};
+
+    // Off by default until the CPU occlusion results are validated, enabled through setOcclusionCulling
+    bool _occlusionCulling = false;
+
+    bool               _temporalCoherence = true;
+    CoherenceReference _coherenceReference{};
+
+    float _minContribution = DEFAULT_MIN_CONTRIBUTION;
+
+    CullStats _stats{};
+
+    glm::vec3 _cameraPosition{0.0f};
+
+    std::unordered_map<const VulkanGraphicsPass*, GpuPassData> _gpuPassData{};
+
+    // GpuLate pass to the Gpu pass it draws the late phase of
+    std::unordered_map<const VulkanGraphicsPass*, const VulkanGraphicsPass*> _gpuLateSources{};
+
+    std::vector<GpuDrawRecord> _gpuDrawRecords{};
+    std::vector<std::uint32_t> _gpuDrawCountsReset{};
+
+    // Draw records are static, each frame in flight buffer is uploaded once per layout
+    std::vector<bool> _gpuRecordsUploaded{};
+
+    // Visibility of the last frame, invalid until the first late phase after a layout change
+    bool _gpuVisibilityValid = false;
+
+    // Set at creation, the GPU culling buffers and the depth pyramid below are not allocated without it
+    bool _gpuCulling = false;
+
+    VulkanDepthPyramid _depthPyramid{};
+
+    std::uint32_t _framesInFlight = 0;
+
+    const ObjectManager* _objectManager = nullptr;
+
+    std::vector<std::uint32_t> _dynamicObjectIndices{};
+    std::vector<std::uint64_t> _dynamicVisibleObjects{};
 
     VulkanDescriptorManager _descriptorManager{};
 
     VulkanStorageBuffer*  _indirectionBuffer      = nullptr;
     VulkanDescriptorSets* _indirectionDescriptors = nullptr;
+
+    // Material index of each instance, parallel to the indirection buffer
+    VulkanStorageBuffer* _instanceMaterialBuffer = nullptr;
+
+    // Commands written by the batch builders of the CPU culled mesh passes, null without multi-draw indirect
+    VulkanStorageBuffer* _drawCommandBuffer = nullptr;
+
+    // GPU culling only, null otherwise
+    VulkanStorageBuffer* _gpuDrawRecordBuffer = nullptr;
+    VulkanStorageBuffer* _gpuCommandBuffer    = nullptr;
+    VulkanStorageBuffer* _gpuCountBuffer      = nullptr;
+    VulkanStorageBuffer* _gpuCullParamsBuffer = nullptr;
+
+    // Written and read back by the GPU across frames, the first frame in flight buffer is shared by all sets
+    VulkanStorageBuffer* _gpuVisibilityBuffer = nullptr;
+
+    // Culled counts per stage of the last use of each frame in flight buffer
+    VulkanStorageBuffer* _gpuCullStatsBuffer = nullptr;
 };
@@ -4,8 +4,15 @@
 
 #include "graphics/vulkan/rendergraph/dispatch/VulkanDispatchCall.h"
 
+// DrawCull: culls the draws of Gpu culled graphics passes into indirect commands
+// DepthPyramid: reduces the depth buffer into the depth pyramid of the frame culler
+// DrawCullLate: occlusion culls against the depth pyramid, for the GpuLate graphics passes
+enum class VulkanComputePassType : std::uint8_t { None, DrawCull, DepthPyramid, DrawCullLate };
+
 struct VulkanComputePassDescriptor {
     VulkanPassDescriptor base;
+
+    VulkanComputePassType type = VulkanComputePassType::None;
 };
 
 class VulkanComputePipeline;
@@ -14,8 +21,8 @@ class VulkanComputePass {
 public:
     using DispatchCallsVector = std::vector<VulkanDispatchCall>;
 
-    explicit VulkanComputePass(VulkanComputePassDescriptor descriptor)
-        : _pass(std::move(descriptor.base)), _computePassDescriptor(std::move(descriptor)) {}
+    explicit VulkanComputePass(const VulkanComputePassDescriptor& descriptor)
+        : _pass(descriptor.base), _computePassDescriptor(descriptor) {}
 
     ~VulkanComputePass() = default;
 
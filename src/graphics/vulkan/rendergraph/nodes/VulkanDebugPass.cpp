@@ -33,7 +33,8 @@ Expected<void> VulkanDebugPass::create(const VulkanDebugPassCreateContext& conte
             .setName(renderObject->object->getModel().name + "_Debug")
             .setRenderMesh({context.meshManager.allocateMesh(aabbMesh)})
             .setInstanceHandle(renderObject->instanceHandle)
-            .setModelMatrix(renderObject->object->getModelMatrix());
+            .setModelMatrix(renderObject->object->getModelMatrix())
+            .setWorldBounds(renderObject->object->getWorldBounds());
     }
 
     return {};
@@ -2,12 +2,15 @@
 
 #include "graphics/vulkan/rendergraph/nodes/VulkanPass.h"
 
+#include "graphics/vulkan/rendergraph/draw/VulkanDrawBatchBuilder.h"
 #include "graphics/vulkan/rendergraph/draw/VulkanDrawCall.h"
 
 // TODO: Make graphics API agnostic
 enum class VulkanGraphicsPassType : std::uint8_t { None, MeshRender, Composite, Debug };
 
-enum class VulkanGraphicsPassCullMode : std::uint8_t { None, Frustum };
+// Gpu: culled by a DrawCull compute pass, drawn with indirect draw counts
+// GpuLate: draws the late phase (DrawCullLate) of the closest preceding Gpu culled pass, owns no draws
+enum class VulkanGraphicsPassCullMode : std::uint8_t { None, Frustum, Gpu, GpuLate };
 
 struct VulkanGraphicsPassDescriptor {
     VulkanPassDescriptor base;
@@ -59,6 +62,9 @@ public:
     [[nodiscard]]       DrawCallsVector& getDrawCalls()       noexcept { return _drawCalls; }
     [[nodiscard]] const DrawCallsVector& getDrawCalls() const noexcept { return _drawCalls; }
 
+    [[nodiscard]]       VulkanDrawBatchBuilder& getBatchBuilder()       noexcept { return _batchBuilder; }
+    [[nodiscard]] const VulkanDrawBatchBuilder& getBatchBuilder() const noexcept { return _batchBuilder; }
+
     // Setters
 
     VulkanGraphicsPass& setGraphicsPipeline(const VulkanGraphicsPipeline* graphicsPipeline) noexcept {
@@ -97,4 +103,7 @@ private:
     AttachmentsVector _colorAttachments{};
 
     DrawCallsVector _drawCalls{};
+
+    // Batches of the CPU culled draws, kept across frames
+    VulkanDrawBatchBuilder _batchBuilder{};
 };
@@ -1,15 +1,20 @@
 #include "VulkanMeshRenderPass.h"
 
 Expected<void> VulkanMeshRenderPass::create(const VulkanMeshRenderPassCreateContext& context) {
+    // Late phase passes draw the commands culled from the draws of their early pass
+    if (getGraphicsPassDescriptor().cullMode == VulkanGraphicsPassCullMode::GpuLate) return {};
 
     for (const auto& renderObject : context.renderObjectManager.getRenderObjects()) {
+        const auto& meshWorldBounds = renderObject->object->getMeshWorldBounds();
+
         // Each submesh requires its own draw call
-        for (const auto& renderMesh : renderObject->meshes) {
+        for (std::size_t i = 0; i < renderObject->meshes.size(); i++) {
             emplaceDrawCall()
                 .setName(renderObject->object->getModel().name)
-                .setRenderMesh(renderMesh)
+                .setRenderMesh(renderObject->meshes[i])
                 .setInstanceHandle(renderObject->instanceHandle)
-                .setModelMatrix(renderObject->object->getModelMatrix());
+                .setModelMatrix(renderObject->object->getModelMatrix())
+                .setWorldBounds(meshWorldBounds[i]);
         }
     }
 
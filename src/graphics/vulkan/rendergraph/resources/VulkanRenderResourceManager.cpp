@@ -116,7 +116,9 @@ Expected<void> VulkanRenderResourceManager::createResourceImage(
 
     TRY(resourceImage.transitionLayout(commandManager, vk::ImageLayout::eUndefined, targetLayout));
 
-    TRY(resourceImage.createSampler(vk::Filter::eLinear, vk::SamplerAddressMode::eClampToEdge, device));
+    TRY(resourceImage.createSampler(
+        {.filter = vk::Filter::eLinear, .addressMode = vk::SamplerAddressMode::eClampToEdge}, device
+    ));
 
     return {};
 }
@@ -161,12 +163,20 @@ void VulkanRenderResourceManager::bindDescriptors(
 }
 
 void VulkanRenderResourceManager::rebindDescriptors(VulkanRenderGraph& renderGraph) {
-    for (const auto& pass : renderGraph.getPasses()) {
-        const auto& reads = pass->base().getPassDescriptor().readDescriptors;
-        if (reads.empty()) continue;
+    const auto rebindPass = [this](const VulkanPass& pass) {
+        const auto& reads = pass.getPassDescriptor().readDescriptors;
+        if (reads.empty()) return;
 
-        if (const VulkanDescriptorSets* sets = pass->base().getDescriptorSets()) {
+        if (const VulkanDescriptorSets* sets = pass.getDescriptorSets()) {
             bindDescriptors(sets, reads);
         }
+    };
+
+    for (const auto& pass : renderGraph.getPasses()) {
+        rebindPass(pass->base());
+    }
+
+    for (const auto& pass : renderGraph.getComputePasses()) {
+        rebindPass(pass->base());
     }
 }
@@ -7,6 +7,9 @@ struct VulkanDescriptorBindingInfo {
     vk::DescriptorType   type;
     vk::ShaderStageFlags stageFlags;
     std::uint32_t        count = 1;
+
+    // Descriptor indexing, e.g. partially bound arrays updated after bind
+    vk::DescriptorBindingFlags bindingFlags{};
 };
 
 using VulkanDescriptorScheme = std::vector<VulkanDescriptorBindingInfo>;
@@ -16,4 +19,5 @@ struct VulkanDescriptorInfo {
     vk::DescriptorImageInfo  imageInfo{};
     vk::DescriptorBufferInfo bufferInfo{};
     std::uint32_t            binding;
+    std::uint32_t            arrayElement = 0;
 };
@@ -4,6 +4,8 @@
 
 #include "VulkanDescriptorSets.h"
 
+#include <algorithm>
+
 Expected<void> VulkanDescriptorManager::create(
     const vk::Device&             device,
     const VulkanDescriptorScheme& descriptorScheme,
@@ -69,11 +71,15 @@ void VulkanDescriptorManager::updateSets(const vk::WriteDescriptorSet& descripto
 
 void VulkanDescriptorManager::buildDescriptorScheme(const VulkanDescriptorScheme& descriptorScheme) {
     _bindings.reserve(descriptorScheme.size());
+    _bindingFlags.reserve(descriptorScheme.size());
     _poolSizes.reserve(descriptorScheme.size());
 
-    for (const auto& [binding, type, stageFlags, count] : descriptorScheme) {
+    for (const auto& [binding, type, stageFlags, count, bindingFlags] : descriptorScheme) {
         _bindings.emplace_back(binding, type, count, stageFlags, nullptr);
+        _bindingFlags.push_back(bindingFlags);
         _poolSizes.emplace_back(type, count * _setCount);
+
+        if (bindingFlags & vk::DescriptorBindingFlagBits::eUpdateAfterBind) _updateAfterBind = true;
     }
 }
 
@@ -82,9 +88,21 @@ Expected<void> VulkanDescriptorManager::createSetLayout() {
         return VK_FAIL("Failed to create descriptor set layout: device is null.");
     }
 
+    vk::DescriptorSetLayoutBindingFlagsCreateInfo bindingFlagsInfo{};
+    bindingFlagsInfo.setBindingFlags(_bindingFlags);
+
     vk::DescriptorSetLayoutCreateInfo descriptorSetLayoutInfo{};
     descriptorSetLayoutInfo.setBindings(_bindings);
 
+    // Only chained for schemes using descriptor indexing
+    if (std::ranges::any_of(_bindingFlags, [](const vk::DescriptorBindingFlags flags) { return bool(flags); })) {
+        descriptorSetLayoutInfo.setPNext(&bindingFlagsInfo);
+    }
+
+    if (_updateAfterBind) {
+        descriptorSetLayoutInfo.setFlags(vk::DescriptorSetLayoutCreateFlagBits::eUpdateAfterBindPool);
+    }
+
     VK_CREATE(_descriptorSetLayout, _device.createDescriptorSetLayout(descriptorSetLayoutInfo));
 
     return {};
@@ -95,9 +113,13 @@ Expected<void> VulkanDescriptorManager::createPool() {
         return VK_FAIL("Failed to create descriptor pool: device is null.");
     }
 
+    vk::DescriptorPoolCreateFlags poolFlags = vk::DescriptorPoolCreateFlagBits::eFreeDescriptorSet;
+
+    if (_updateAfterBind) poolFlags |= vk::DescriptorPoolCreateFlagBits::eUpdateAfterBind;
+
     vk::DescriptorPoolCreateInfo descriptorPoolInfo{};
     descriptorPoolInfo
-        .setFlags(vk::DescriptorPoolCreateFlagBits::eFreeDescriptorSet)
+        .setFlags(poolFlags)
         .setMaxSets(_setCount)
         .setPoolSizes(_poolSizes);
 
@@ -56,8 +56,12 @@ private:
     std::uint32_t _setCount       = 0;
 
     std::vector<vk::DescriptorSetLayoutBinding> _bindings{};
+    std::vector<vk::DescriptorBindingFlags>     _bindingFlags{};
     std::vector<vk::DescriptorPoolSize>         _poolSizes{};
 
+    // Set when a binding is updated after bind, the layout and pool must allow it
+    bool _updateAfterBind = false;
+
     vk::DescriptorSetLayout _descriptorSetLayout{};
     vk::DescriptorPool      _descriptorPool{};
 
@@ -27,13 +27,14 @@ void VulkanDescriptorSets::updateDescriptorSets(const VulkanDescriptorInfo& info
     descriptorSetWrite
         .setDstSet(_descriptorSets[frameIndex])
         .setDstBinding(info.binding)
-        .setDstArrayElement(0)
+        .setDstArrayElement(info.arrayElement)
         .setDescriptorCount(1)
         .setDescriptorType(info.type);
 
     if (info.type == vk::DescriptorType::eUniformBuffer || info.type == vk::DescriptorType::eStorageBuffer)
         descriptorSetWrite.setBufferInfo(info.bufferInfo);
-    else if (info.type == vk::DescriptorType::eCombinedImageSampler)
+    else if (info.type == vk::DescriptorType::eCombinedImageSampler || info.type == vk::DescriptorType::eStorageImage
+          || info.type == vk::DescriptorType::eSampledImage         || info.type == vk::DescriptorType::eSampler)
         descriptorSetWrite.setImageInfo(info.imageInfo);
 
     _manager->updateSets(descriptorSetWrite);
@@ -37,8 +37,12 @@ public:
     [[nodiscard]] std::uint32_t getImageIndex() const noexcept { return _imageIndex; }
 
     [[nodiscard]] static const VulkanDescriptorScheme& getDescriptorScheme() noexcept {
+        // Compute passes read the camera matrices too (draw_cull_late projects bounds against the depth pyramid)
+        static constexpr vk::ShaderStageFlags uniformStages =
+            vk::ShaderStageFlagBits::eAllGraphics | vk::ShaderStageFlagBits::eCompute;
+
         static const VulkanDescriptorScheme scheme = {
-            {0, vk::DescriptorType::eUniformBuffer, vk::ShaderStageFlagBits::eAllGraphics}
+            {0, vk::DescriptorType::eUniformBuffer, uniformStages}
         };
         return scheme;
     }
@@ -10,10 +10,8 @@ void VulkanImage::destroy() noexcept {
     const vk::Device&   logicalDevice = _device->getLogicalDevice();
     const VmaAllocator& allocator     = _device->getAllocator();
 
-    if (_sampler) {
-        logicalDevice.destroySampler(_sampler);
-        _sampler = VK_NULL_HANDLE;
-    }
+    // Sampler is owned by the device sampler cache
+    _sampler = VK_NULL_HANDLE;
 
     if (_imageView) {
         logicalDevice.destroyImageView(_imageView);
@@ -166,32 +164,10 @@ Expected<void> VulkanImage::createImageView(
 }
 
 Expected<void> VulkanImage::createSampler(
-    const vk::Filter             filter,
-    const vk::SamplerAddressMode addressMode,
-    const VulkanDevice*          device
+    const VulkanSamplerDescriptor& samplerDescriptor,
+    const VulkanDevice*            device
 ) {
-    const vk::Device&         logicalDevice  = device->getLogicalDevice();
-    const vk::PhysicalDevice& physicalDevice = device->getPhysicalDevice();
-
-    vk::SamplerCreateInfo samplerInfo{};
-    samplerInfo
-        .setMagFilter(filter)
-        .setMinFilter(filter)
-        .setMipmapMode(vk::SamplerMipmapMode::eLinear)
-        .setAddressModeU(addressMode)
-        .setAddressModeV(addressMode)
-        .setAddressModeW(addressMode)
-        .setMipLodBias(0.0f)
-        .setAnisotropyEnable(vk::True)
-        .setMaxAnisotropy(physicalDevice.getProperties().limits.maxSamplerAnisotropy)
-        .setCompareEnable(vk::False)
-        .setCompareOp(vk::CompareOp::eAlways)
-        .setMinLod(0.0f)
-        .setMaxLod(vk::LodClampNone)
-        .setBorderColor(vk::BorderColor::eIntOpaqueBlack)
-        .setUnnormalizedCoordinates(vk::False);
-
-    VK_CREATE(_sampler, logicalDevice.createSampler(samplerInfo));
+    TRY_ASSIGN(_sampler, device->getSamplerCache().getOrCreate(samplerDescriptor));
 
     return {};
 }
@@ -199,23 +175,37 @@ Expected<void> VulkanImage::createSampler(
 void VulkanImage::copyBufferToImage(
     const vk::CommandBuffer commandBuffer,
     const vk::Buffer&       buffer,
-    const vk::DeviceSize    offset
+    const vk::DeviceSize    offset,
+    const std::uint32_t     levelCount
 ) const {
-    vk::BufferImageCopy2 copyRegion{};
-    copyRegion
-        .setBufferOffset(offset)
-        .setBufferRowLength(0)
-        .setBufferImageHeight(0)
-        .setImageSubresource({vk::ImageAspectFlagBits::eColor, 0, 0, 1})
-        .setImageOffset({0, 0, 0})
-        .setImageExtent(_extent);
+    std::vector<vk::BufferImageCopy2> copyRegions(levelCount);
+
+    vk::DeviceSize levelOffset = offset;
+    vk::Extent3D   levelExtent = _extent;
+
+    for (std::uint32_t level = 0; level < levelCount; level++) {
+        copyRegions[level]
+            .setBufferOffset(levelOffset)
+            .setBufferRowLength(0)
+            .setBufferImageHeight(0)
+            .setImageSubresource({vk::ImageAspectFlagBits::eColor, level, 0, 1})
+            .setImageOffset({0, 0, 0})
+            .setImageExtent(levelExtent);
+
+        // Cached levels are tightly packed RGBA8
+        levelOffset += static_cast<vk::DeviceSize>(levelExtent.width) * levelExtent.height * levelExtent.depth * 4;
+
+        levelExtent.width  = std::max(1u, levelExtent.width  / 2);
+        levelExtent.height = std::max(1u, levelExtent.height / 2);
+        levelExtent.depth  = std::max(1u, levelExtent.depth  / 2);
+    }
 
     vk::CopyBufferToImageInfo2 copyBufferToImageInfo{};
     copyBufferToImageInfo
         .setSrcBuffer(buffer)
         .setDstImage(_image)
         .setDstImageLayout(vk::ImageLayout::eTransferDstOptimal)
-        .setRegions({copyRegion});
+        .setRegions(copyRegions);
 
     commandBuffer.copyBufferToImage2(copyBufferToImageInfo);
 }
@@ -360,10 +350,12 @@ Expected<void> VulkanImage::createFromBuffer(
     const vk::Format        format,
     const vk::Extent3D      extent,
     const std::uint32_t     mipLevels,
+    const bool              storedMipLevels,
     const vk::CommandBuffer commandBuffer,
     const VulkanDevice*     device
 ) {
-    const bool hasMipmaps = mipLevels > 1;
+    // Only a chain missing from the buffer is generated by blits
+    const bool generatesMipmaps = mipLevels > 1 && !storedMipLevels;
 
     _device = device;
 
@@ -373,7 +365,7 @@ Expected<void> VulkanImage::createFromBuffer(
     _descriptorType = vk::DescriptorType::eCombinedImageSampler;
 
     _usageFlags = vk::ImageUsageFlagBits::eTransferDst | vk::ImageUsageFlagBits::eSampled;
-    if (hasMipmaps) {
+    if (generatesMipmaps) {
         _usageFlags |= vk::ImageUsageFlagBits::eTransferSrc;
     }
 
@@ -381,10 +373,10 @@ Expected<void> VulkanImage::createFromBuffer(
 
     TRY(transitionLayout(commandBuffer, vk::ImageLayout::eTransferDstOptimal, mipLevels));
 
-    copyBufferToImage(commandBuffer, buffer.handle(), bufferOffset);
+    copyBufferToImage(commandBuffer, buffer.handle(), bufferOffset, storedMipLevels ? mipLevels : 1);
 
     // Mipmaps generation
-    if (hasMipmaps) {
+    if (generatesMipmaps) {
         generateMipmaps(commandBuffer, extent, mipLevels);
 
     } else {
@@ -393,7 +385,7 @@ Expected<void> VulkanImage::createFromBuffer(
 
     TRY(createImageView(vk::ImageViewType::e2D, format, _aspectFlags, mipLevels, device));
 
-    TRY(createSampler(vk::Filter::eLinear, vk::SamplerAddressMode::eRepeat, device));
+    TRY(createSampler({.filter = vk::Filter::eLinear, .addressMode = vk::SamplerAddressMode::eRepeat}, device));
 
     return {};
 }
@@ -68,16 +68,18 @@ public:
         const VulkanDevice*  device
     );
 
+    // Samplers are shared through the device sampler cache and are not owned by the image
     [[nodiscard]] Expected<void> createSampler(
-        vk::Filter             filter,
-        vk::SamplerAddressMode addressMode,
-        const VulkanDevice*    device
+        const VulkanSamplerDescriptor& samplerDescriptor,
+        const VulkanDevice*            device
     );
 
+    // Copies levelCount mip levels stored back to back in the buffer
     void copyBufferToImage(
         vk::CommandBuffer commandBuffer,
         const vk::Buffer& buffer,
-        vk::DeviceSize    offset
+        vk::DeviceSize    offset,
+        std::uint32_t     levelCount = 1
     ) const;
 
     void generateMipmaps(
@@ -86,12 +88,14 @@ public:
         std::uint32_t     mipLevels
     ) const;
 
+    // The buffer holds either the full mip chain or only the base level, the chain is then generated by blits
     [[nodiscard]] Expected<void> createFromBuffer(
         const VulkanBuffer& buffer,
         vk::DeviceSize      bufferOffset,
         vk::Format          format,
         vk::Extent3D        extent,
         std::uint32_t       mipLevels,
+        bool                storedMipLevels,
         vk::CommandBuffer   commandBuffer,
         const VulkanDevice* device
     );
@@ -25,12 +25,14 @@ namespace VulkanImageLayoutTransitions {
                 vk::PipelineStageFlagBits2::eTopOfPipe, vk::PipelineStageFlagBits2::eEarlyFragmentTests
             };
 
+        // Depth buffers are also read by compute passes (depth pyramid)
         if (oldLayout == ImageLayout::eDepthStencilAttachmentOptimal &&
             newLayout == ImageLayout::eShaderReadOnlyOptimal)
             return LayoutTransition{
                 vk::AccessFlagBits2::eDepthStencilAttachmentRead | vk::AccessFlagBits2::eDepthStencilAttachmentWrite,
                 vk::AccessFlagBits2::eShaderRead,
-                vk::PipelineStageFlagBits2::eEarlyFragmentTests, vk::PipelineStageFlagBits2::eFragmentShader
+                vk::PipelineStageFlagBits2::eEarlyFragmentTests | vk::PipelineStageFlagBits2::eLateFragmentTests,
+                vk::PipelineStageFlagBits2::eFragmentShader     | vk::PipelineStageFlagBits2::eComputeShader
             };
 
         if (oldLayout == ImageLayout::eShaderReadOnlyOptimal &&
@@ -38,7 +40,16 @@ namespace VulkanImageLayoutTransitions {
             return LayoutTransition{
                 vk::AccessFlagBits2::eShaderRead,
                 vk::AccessFlagBits2::eDepthStencilAttachmentRead | vk::AccessFlagBits2::eDepthStencilAttachmentWrite,
-                vk::PipelineStageFlagBits2::eFragmentShader, vk::PipelineStageFlagBits2::eEarlyFragmentTests
+                vk::PipelineStageFlagBits2::eFragmentShader     | vk::PipelineStageFlagBits2::eComputeShader,
+                vk::PipelineStageFlagBits2::eEarlyFragmentTests | vk::PipelineStageFlagBits2::eLateFragmentTests
+            };
+
+        // Storage images stay in the general layout, written and read by compute passes
+        if (oldLayout == ImageLayout::eUndefined &&
+            newLayout == ImageLayout::eGeneral)
+            return LayoutTransition{
+                {}, vk::AccessFlagBits2::eShaderStorageWrite | vk::AccessFlagBits2::eShaderRead,
+                vk::PipelineStageFlagBits2::eTopOfPipe, vk::PipelineStageFlagBits2::eComputeShader
             };
 
         if (oldLayout == ImageLayout::eUndefined &&
@@ -51,7 +51,8 @@ Expected<void> VulkanImageManager::loadImage(VulkanImage*& image, const Image* i
 
     constexpr auto format = HARDCODED_IMAGE_FORMAT;
 
-    const std::uint32_t mipLevels = imageData->hasMipmaps ? getMipLevels(extent) : 1;
+    const std::uint32_t mipLevels       = imageData->hasMipmaps ? getMipLevels(extent) : 1;
+    const bool          storedMipLevels = imageData->mipLevels == mipLevels;
 
     VulkanBuffer stagingBuffer;
     // Create the staging buffer
@@ -74,7 +75,9 @@ Expected<void> VulkanImageManager::loadImage(VulkanImage*& image, const Image* i
     TRY(_commandManager->beginSingleTimeCommands(commandBuffer));
 
     VulkanImage tempImage{};
-    TRY(tempImage.createFromBuffer(stagingBuffer, 0, format, extent, mipLevels, commandBuffer, _device));
+    TRY(tempImage.createFromBuffer(
+        stagingBuffer, 0, format, extent, mipLevels, storedMipLevels, commandBuffer, _device
+    ));
 
     TRY(_commandManager->endSingleTimeCommands(commandBuffer));
 
@@ -125,7 +128,8 @@ Expected<void> VulkanImageManager::loadImages(
             static_cast<std::uint32_t>(depth)
         };
 
-        const std::uint32_t mipLevels = image->hasMipmaps ? getMipLevels(extent) : 1;
+        const std::uint32_t mipLevels       = image->hasMipmaps ? getMipLevels(extent) : 1;
+        const bool          storedMipLevels = image->mipLevels == mipLevels;
 
         // Ensure image data is aligned properly in memory
         offset = VulkanBuffer::align(offset, STAGING_BUFFER_ALIGNMENT);
@@ -135,7 +139,9 @@ Expected<void> VulkanImageManager::loadImages(
 
         // Create image on the GPU
         VulkanImage tempImage{};
-        TRY(tempImage.createFromBuffer(stagingBuffer, offset, format, extent, mipLevels, commandBuffer, _device));
+        TRY(tempImage.createFromBuffer(
+            stagingBuffer, offset, format, extent, mipLevels, storedMipLevels, commandBuffer, _device
+        ));
 
         offset += image->byteSize;
 
@@ -1,20 +1,16 @@
 #include "VulkanMaterial.h"
 
 Expected<void> VulkanMaterial::create(
-    const Material&          sourceMaterial,
-    VulkanImageManager*      imageManager,
-    VulkanDescriptorManager& descriptorManager
+    const Material&     sourceMaterial,
+    VulkanImageManager* imageManager,
+    const std::uint32_t materialIndex
 ) {
     _sourceMaterial = sourceMaterial;
+    _materialIndex  = materialIndex;
 
     // Load all textures
     TRY(loadTextures(imageManager));
 
-    // Allocate descriptor sets
-    TRY(descriptorManager.allocate(_descriptorSets));
-
-    bindDescriptorSets();
-
     return {};
 }
 
@@ -43,13 +39,3 @@ Expected<void> VulkanMaterial::loadTextures(VulkanImageManager* imageManager) {
     TRY(loadTexture(TextureType::Specular, _sourceMaterial.specularPath, _sourceMaterial.specular, imageManager));
     return {};
 }
-
-void VulkanMaterial::bindDescriptorSets() const {
-    for (std::size_t i = 0; i < _textureMap.textures.size(); i++) {
-        if (_descriptorSets && _textureMap.textures[i]) {
-            _descriptorSets->updatePerFrameDescriptorSets(
-                _textureMap.textures[i]->getDescriptorInfo(static_cast<std::uint32_t>(i))
-            );
-        }
-    }
-}
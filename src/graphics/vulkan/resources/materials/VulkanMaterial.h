@@ -2,8 +2,6 @@
 
 #include "core/debug/ErrorHandling.h"
 
-#include "graphics/vulkan/resources/descriptors/VulkanDescriptorSets.h"
-
 #include "graphics/vulkan/resources/images/VulkanImage.h"
 #include "graphics/vulkan/resources/images/VulkanImageManager.h"
 
@@ -13,19 +11,26 @@ struct VulkanMaterialTextures {
     std::array<VulkanImage*, static_cast<std::size_t>(TextureType::Count)> textures{};
 };
 
+// Bindless texture and sampler array indices of a material, read by the fragment stage (std430)
+// Each texture keeps its own sampler, indexed by texture type
+struct MaterialDataGPU {
+    std::array<std::uint32_t, static_cast<std::size_t>(TextureType::Count)> textures{};
+    std::array<std::uint32_t, static_cast<std::size_t>(TextureType::Count)> samplers{};
+};
+
+static_assert(sizeof(MaterialDataGPU) == 24);
+
 class VulkanMaterial {
 public:
     VulkanMaterial()  = default;
     ~VulkanMaterial() = default;
 
     Expected<void> create(
-        const Material&          sourceMaterial,
-        VulkanImageManager*      imageManager,
-        VulkanDescriptorManager& descriptorManager
+        const Material&     sourceMaterial,
+        VulkanImageManager* imageManager,
+        std::uint32_t       materialIndex
     );
 
-    void bindDescriptorSets() const;
-
     [[nodiscard]] VulkanImage* getTexture(const TextureType type) const {
         return _textureMap.textures[static_cast<std::size_t>(type)];
     }
@@ -34,7 +39,10 @@ public:
         _textureMap.textures[static_cast<std::size_t>(type)] = image;
     }
 
-    [[nodiscard]] const VulkanDescriptorSets* getDescriptorSets() const noexcept { return _descriptorSets; }
+    // Index into the material buffer of the material manager
+    [[nodiscard]] std::uint32_t getMaterialIndex() const noexcept { return _materialIndex; }
+
+    [[nodiscard]] float getMaxDrawDistance() const noexcept { return _sourceMaterial.maxDrawDistance; }
 
 private:
     Expected<void> loadTexture(
@@ -50,5 +58,5 @@ private:
 
     VulkanMaterialTextures _textureMap{};
 
-    VulkanDescriptorSets* _descriptorSets = nullptr;
+    std::uint32_t _materialIndex = 0;
 };
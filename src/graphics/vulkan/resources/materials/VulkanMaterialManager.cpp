@@ -3,13 +3,36 @@
 #include <ranges>
 
 Expected<void> VulkanMaterialManager::create(
-    const VulkanDevice& device,
-    VulkanImageManager& imageManager,
-    const std::uint32_t framesInFlight
+    const VulkanDevice&         device,
+    VulkanImageManager&         imageManager,
+    VulkanStorageBufferManager& storageBufferManager,
+    const std::uint32_t         framesInFlight
 ) noexcept {
     _imageManager = &imageManager;
 
-    TRY(_descriptorManager.create(device.getLogicalDevice(), getDescriptorScheme(), framesInFlight, MAX_MATERIALS));
+    // Descriptor indexing features are checked by the device, the array sizes depend on its update after bind limits
+    const auto properties = device.getPhysicalDevice().getProperties2<
+        vk::PhysicalDeviceProperties2, vk::PhysicalDeviceVulkan12Properties
+    >();
+
+    const vk::PhysicalDeviceVulkan12Properties& properties_1_2 = properties.get<vk::PhysicalDeviceVulkan12Properties>();
+
+    if (properties_1_2.maxPerStageDescriptorUpdateAfterBindSampledImages < MAX_TEXTURES
+     || properties_1_2.maxPerStageDescriptorUpdateAfterBindSamplers      < MAX_SAMPLERS) {
+        return VK_FAIL("Failed to create material manager: bindless texture arrays exceed the device limits.");
+    }
+
+    // A single bindless set per frame in flight
+    TRY(_descriptorManager.create(device.getLogicalDevice(), getDescriptorScheme(), framesInFlight, 1));
+
+    TRY(_descriptorManager.allocate(_materialDescriptors));
+
+    TRY_ASSIGN(_materialBuffer, storageBufferManager.allocateBuffer(MAX_MATERIALS * sizeof(MaterialDataGPU)));
+
+    _materialDescriptors->updatePerFrameSSBODescriptorSets(*_materialBuffer, 2);
+
+    // Draws without a material use the first one, made of the default fallback textures
+    TRY(getOrCreateMaterial(Material{}));
 
     return {};
 }
@@ -24,19 +47,93 @@ Expected<VulkanMaterial*> VulkanMaterialManager::getOrCreateMaterial(const Mater
         return Expected(cachedMaterial->second.get());
     }
 
+    if (_materials.size() >= MAX_MATERIALS) {
+        return VK_FAIL("Failed to create material \"" + sourceMaterial.name + "\": exceeded maximum materials.");
+    }
+
     // Otherwise, insert and create material
+    const auto materialIndex = static_cast<std::uint32_t>(_materials.size());
+
     auto [cachedMaterial, inserted] = _materials.emplace(sourceMaterial, std::make_unique<VulkanMaterial>());
 
     if (inserted) {
         TRY_CATCH(
-            cachedMaterial->second->create(sourceMaterial, _imageManager, _descriptorManager),
+            cachedMaterial->second->create(sourceMaterial, _imageManager, materialIndex),
             _materials.erase(cachedMaterial)
         );
+
+        TRY_CATCH(registerMaterial(*cachedMaterial->second), _materials.erase(cachedMaterial));
     }
 
     return Expected(cachedMaterial->second.get());
 }
 
+Expected<void> VulkanMaterialManager::registerMaterial(const VulkanMaterial& material) {
+    MaterialDataGPU materialData{};
+
+    for (std::size_t i = 0; i < materialData.textures.size(); i++) {
+        const VulkanImage& texture = *material.getTexture(static_cast<TextureType>(i));
+
+        TRY_ASSIGN(materialData.textures[i], getTextureIndex(texture));
+        TRY_ASSIGN(materialData.samplers[i], getSamplerIndex(texture.getSampler()));
+    }
+
+    // Material data is static, every frame in flight copy is written once
+    const vk::DeviceSize offset = material.getMaterialIndex() * sizeof(MaterialDataGPU);
+
+    for (std::uint32_t i = 0; i < _descriptorManager.getFramesInFlight(); i++) {
+        _materialBuffer->updateMemory(i, materialData, offset);
+    }
+
+    return {};
+}
+
+Expected<std::uint32_t> VulkanMaterialManager::getTextureIndex(const VulkanImage& image) {
+    if (const auto textureIndex = _textureIndices.find(&image); textureIndex != _textureIndices.end()) {
+        return Expected(textureIndex->second);
+    }
+
+    if (_textureIndices.size() >= MAX_TEXTURES) {
+        return VK_FAIL("Failed to register material texture: exceeded maximum textures.");
+    }
+
+    const auto textureIndex = static_cast<std::uint32_t>(_textureIndices.size());
+
+    _textureIndices.emplace(&image, textureIndex);
+
+    _materialDescriptors->updatePerFrameDescriptorSets({
+        .type         = vk::DescriptorType::eSampledImage,
+        .imageInfo    = {nullptr, image.getImageView(), vk::ImageLayout::eShaderReadOnlyOptimal},
+        .binding      = 0,
+        .arrayElement = textureIndex
+    });
+
+    return Expected(textureIndex);
+}
+
+Expected<std::uint32_t> VulkanMaterialManager::getSamplerIndex(const vk::Sampler sampler) {
+    if (const auto samplerIndex = _samplerIndices.find(sampler); samplerIndex != _samplerIndices.end()) {
+        return Expected(samplerIndex->second);
+    }
+
+    if (_samplerIndices.size() >= MAX_SAMPLERS) {
+        return VK_FAIL("Failed to register material sampler: exceeded maximum samplers.");
+    }
+
+    const auto samplerIndex = static_cast<std::uint32_t>(_samplerIndices.size());
+
+    _samplerIndices.emplace(sampler, samplerIndex);
+
+    _materialDescriptors->updatePerFrameDescriptorSets({
+        .type         = vk::DescriptorType::eSampler,
+        .imageInfo    = {sampler, nullptr, vk::ImageLayout::eUndefined},
+        .binding      = 1,
+        .arrayElement = samplerIndex
+    });
+
+    return Expected(samplerIndex);
+}
+
 Expected<void> VulkanMaterialManager::loadTextures(const AssetManager::TexturesMap& textures) const {
     std::vector<const Image*> images{};
 
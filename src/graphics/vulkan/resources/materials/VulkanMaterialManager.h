@@ -3,13 +3,19 @@
 #include "core/debug/ErrorHandling.h"
 
 #include "graphics/vulkan/resources/descriptors/VulkanDescriptorManager.h"
+#include "graphics/vulkan/resources/descriptors/VulkanDescriptorSets.h"
 #include "graphics/vulkan/resources/materials/VulkanMaterial.h"
+#include "graphics/vulkan/resources/ssbo/VulkanStorageBufferManager.h"
 
 #include "core/resources/AssetManager.h"
 
+// Bindless materials: a single set holds every material texture and sampler in descriptor arrays, materials are
+// indices into a material buffer referencing them. Draws only carry their material index, no set is bound per material
 class VulkanMaterialManager {
 public:
     static constexpr std::uint32_t MAX_MATERIALS = 2048;
+    static constexpr std::uint32_t MAX_TEXTURES  = MAX_MATERIALS * static_cast<std::uint32_t>(TextureType::Count);
+    static constexpr std::uint32_t MAX_SAMPLERS  = 64;
 
     VulkanMaterialManager()  = default;
     ~VulkanMaterialManager() = default;
@@ -21,9 +27,10 @@ public:
     VulkanMaterialManager& operator=(VulkanMaterialManager&&) = delete;
 
     [[nodiscard]] Expected<void> create(
-        const VulkanDevice& device,
-        VulkanImageManager& imageManager,
-        std::uint32_t       framesInFlight
+        const VulkanDevice&         device,
+        VulkanImageManager&         imageManager,
+        VulkanStorageBufferManager& storageBufferManager,
+        std::uint32_t               framesInFlight
     ) noexcept;
 
     void destroy() noexcept;
@@ -33,22 +40,39 @@ public:
     [[nodiscard]] Expected<void> loadTextures(const AssetManager::TexturesMap& textures) const;
 
     [[nodiscard]] static VulkanDescriptorScheme getDescriptorScheme() noexcept {
-        VulkanDescriptorScheme scheme{};
-
-        // Include all possible texture types in the descriptor scheme
-        for (std::size_t i = 0; i < static_cast<std::size_t>(TextureType::Count); i++) {
-            scheme.emplace_back(i, vk::DescriptorType::eCombinedImageSampler, vk::ShaderStageFlagBits::eFragment);
-        }
-
+        // Arrays are filled as materials are created, written slots are never rewritten while in use
+        static constexpr vk::DescriptorBindingFlags arrayFlags =
+            vk::DescriptorBindingFlagBits::ePartiallyBound | vk::DescriptorBindingFlagBits::eUpdateAfterBind;
+
+        static const VulkanDescriptorScheme scheme = {
+            {0, vk::DescriptorType::eSampledImage,  vk::ShaderStageFlagBits::eFragment, MAX_TEXTURES, arrayFlags},
+            {1, vk::DescriptorType::eSampler,       vk::ShaderStageFlagBits::eFragment, MAX_SAMPLERS, arrayFlags},
+            {2, vk::DescriptorType::eStorageBuffer, vk::ShaderStageFlagBits::eFragment} // Material data
+        };
         return scheme;
     }
 
     [[nodiscard]] const VulkanDescriptorManager& getDescriptorManager() const noexcept { return _descriptorManager; }
 
+    [[nodiscard]] const VulkanDescriptorSets* getDescriptorSets() const noexcept { return _materialDescriptors; }
+
 private:
+    // Writes the texture and sampler descriptors of the material and its material buffer entry
+    [[nodiscard]] Expected<void> registerMaterial(const VulkanMaterial& material);
+
+    [[nodiscard]] Expected<std::uint32_t> getTextureIndex(const VulkanImage& image);
+    [[nodiscard]] Expected<std::uint32_t> getSamplerIndex(vk::Sampler sampler);
+
     VulkanImageManager* _imageManager = nullptr;
 
     VulkanDescriptorManager _descriptorManager{};
 
+    VulkanDescriptorSets* _materialDescriptors = nullptr;
+    VulkanStorageBuffer*  _materialBuffer      = nullptr;
+
     std::unordered_map<Material, std::unique_ptr<VulkanMaterial>, MaterialHash> _materials;
+
+    // Descriptor array slots, in first use order
+    std::unordered_map<const VulkanImage*, std::uint32_t> _textureIndices{};
+    std::unordered_map<vk::Sampler, std::uint32_t>        _samplerIndices{};
 };
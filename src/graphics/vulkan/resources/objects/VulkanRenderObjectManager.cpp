@@ -1,6 +1,7 @@
 #include "VulkanRenderObjectManager.h"
 
 #include "core/debug/Logger.h"
+#include "core/debug/Profiler.h"
 
 Expected<void> VulkanRenderObjectManager::create(const VulkanRenderObjectCreateContext& context) noexcept {
     _context = context;
@@ -26,7 +27,10 @@ Expected<void> VulkanRenderObjectManager::create(const VulkanRenderObjectCreateC
 
     auto startTime = std::chrono::high_resolution_clock::now();
 
-    TRY(context.materialManager->loadTextures(context.assetManager->getTextures()));
+    {
+        PROFILE_ZONE("UploadTextures");
+        TRY(context.materialManager->loadTextures(context.assetManager->getTextures()));
+    }
 
     auto endTime = std::chrono::high_resolution_clock::now();
 
@@ -34,8 +34,12 @@ public:
     [[nodiscard]] const RenderObjectsVector& getRenderObjects() const noexcept { return _renderObjects; }
 
     [[nodiscard]] static VulkanDescriptorScheme getDescriptorScheme() noexcept {
+        // Read by the vertex stage and the draw cull pass
         static const VulkanDescriptorScheme scheme = {
-            {0, vk::DescriptorType::eStorageBuffer, vk::ShaderStageFlagBits::eVertex}
+            {
+                0, vk::DescriptorType::eStorageBuffer,
+                vk::ShaderStageFlagBits::eVertex | vk::ShaderStageFlagBits::eCompute
+            }
         };
         return scheme;
     }
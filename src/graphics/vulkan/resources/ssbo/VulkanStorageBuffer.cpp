@@ -3,13 +3,15 @@
 #include "graphics/vulkan/common/VulkanDebugger.h"
 
 Expected<void> VulkanStorageBuffer::create(
-    const VulkanDevice&  device,
-    const std::uint32_t  framesInFlight,
-    const vk::DeviceSize size
+    const VulkanDevice&        device,
+    const std::uint32_t        framesInFlight,
+    const vk::DeviceSize       size,
+    const vk::BufferUsageFlags usage
 ) noexcept {
     _device         = &device;
     _framesInFlight = framesInFlight;
     _bufferSize     = size;
+    _usage          = usage;
 
     TRY(createStorageBuffers());
 
@@ -39,7 +41,7 @@ Expected<void> VulkanStorageBuffer::createStorageBuffers() {
 
         TRY(storageBuffer.create(
             getBufferSize(),
-            vk::BufferUsageFlagBits::eStorageBuffer,
+            vk::BufferUsageFlagBits::eStorageBuffer | _usage,
             VMA_MEMORY_USAGE_CPU_TO_GPU,
             _device
         ));
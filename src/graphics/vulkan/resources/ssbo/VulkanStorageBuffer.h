@@ -20,9 +20,10 @@ public:
     VulkanStorageBuffer& operator=(VulkanStorageBuffer&&) = delete;
 
     [[nodiscard]] Expected<void> create(
-        const VulkanDevice& device,
-        std::uint32_t       framesInFlight,
-        vk::DeviceSize      size
+        const VulkanDevice&  device,
+        std::uint32_t        framesInFlight,
+        vk::DeviceSize       size,
+        vk::BufferUsageFlags usage = {}
     ) noexcept;
 
     void destroy() noexcept;
@@ -84,5 +85,8 @@ protected:
 
     vk::DeviceSize _bufferSize = 0;
 
+    // Usage on top of storage, e.g. indirect buffers written by compute passes
+    vk::BufferUsageFlags _usage{};
+
     std::vector<VulkanBuffer> _storageBuffers{};
 };
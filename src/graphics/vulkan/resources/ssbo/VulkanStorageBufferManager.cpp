@@ -19,10 +19,12 @@ void VulkanStorageBufferManager::destroy() noexcept {
     _device = nullptr;
 }
 
-Expected<VulkanStorageBuffer*> VulkanStorageBufferManager::allocateBuffer(const vk::DeviceSize size) {
+Expected<VulkanStorageBuffer*> VulkanStorageBufferManager::allocateBuffer(
+    const vk::DeviceSize size, const vk::BufferUsageFlags usage
+) {
     _storageBuffers.push_back(std::make_unique<VulkanStorageBuffer>());
 
-    TRY(_storageBuffers.back()->create(*_device, _framesInFlight, size));
+    TRY(_storageBuffers.back()->create(*_device, _framesInFlight, size, usage));
 
     return Expected(_storageBuffers.back().get());
 }
@@ -19,7 +19,7 @@ public:
 
     void destroy() noexcept;
 
-    [[nodiscard]] Expected<VulkanStorageBuffer*> allocateBuffer(vk::DeviceSize size);
+    [[nodiscard]] Expected<VulkanStorageBuffer*> allocateBuffer(vk::DeviceSize size, vk::BufferUsageFlags usage = {});
 
 private:
     const VulkanDevice* _device = nullptr;
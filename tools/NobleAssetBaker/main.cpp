@@ -0,0 +1,213 @@
+// NobleAssetBaker - headless offline asset processing
+// Loads models and textures with the engine loaders, then writes binary caches (optimized meshes, full mip chains)
+//
+// Usage: NobleAssetBaker [--scene <file>] [--output <directory>] [model...]
+//        Model paths are relative to resources/models/, a scene file lists one model path per line
+
+#include "core/debug/Logger.h"
+#include "core/multithreading/ThreadRegistry.h"
+#include "core/resources/AssetManager.h"
+#include "core/resources/AssetPaths.h"
+#include "core/resources/cache/AssetCache.h"
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <ranges>
+
+namespace {
+    struct BakeOptions {
+        std::vector<std::string> modelPaths;
+        std::string              outputDirectory = AssetPaths::CACHE;
+    };
+
+    Expected<BakeOptions> parseArguments(const int argc, char** argv) {
+        BakeOptions options{};
+
+        for (int i = 1; i < argc; i++) {
+            const std::string_view argument = argv[i];
+
+            if (argument == "--output" || argument == "--scene") {
+                if (i + 1 >= argc) {
+                    return FAIL("Missing value for " + std::string(argument), "NobleAssetBaker");
+                }
+
+                const std::string value = argv[++i];
+
+                if (argument == "--output") {
+                    options.outputDirectory = value;
+                    continue;
+                }
+
+                std::ifstream scene(value);
+
+                if (!scene.is_open()) {
+                    return FAIL("Failed to open scene file \"" + value + "\"", "NobleAssetBaker");
+                }
+
+                std::string line;
+
+                while (std::getline(scene, line)) {
+                    if (!line.empty() && line.back() == '\r') line.pop_back();
+                    if (line.empty() || line.front() == '#') continue;
+
+                    options.modelPaths.push_back(line);
+                }
+            } else {
+                options.modelPaths.emplace_back(argument);
+            }
+        }
+
+        if (options.modelPaths.empty()) {
+            return FAIL(
+                "No models to bake, usage: NobleAssetBaker [--scene <file>] [--output <directory>] [model...]",
+                "NobleAssetBaker"
+            );
+        }
+
+        return Expected(std::move(options));
+    }
+
+    // Loaders log their own failures, only requested assets missing from the loaded map are counted here
+    template<typename Map>
+    std::uint32_t countMissing(const std::vector<std::string>& requestedPaths, const Map& loaded) {
+        std::uint32_t missing = 0;
+
+        for (const std::string& path : requestedPaths) {
+            if (path.empty() || loaded.contains(path)) continue;
+
+            Logger::error("Failed to bake \"" + path + "\"");
+            missing++;
+        }
+
+        return missing;
+    }
+
+    std::int64_t elapsedMilliseconds(const std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+int main(const int argc, char** argv) {
+    ThreadScope mainScope("MainThread");
+
+    Logger::Manager loggerManager;
+
+    const Expected<BakeOptions> options = parseArguments(argc, argv);
+
+    if (!options) {
+        Logger::error(options.failure());
+        return EXIT_FAILURE;
+    }
+
+    unsigned int numThreads = std::thread::hardware_concurrency();
+    if (numThreads == 0) numThreads = 4; // Fail-safe
+
+    ThreadPool threadPool{numThreads};
+
+    AssetCache::setLookupEnabled(false);
+
+    AssetManager assetManager;
+
+    std::atomic<std::uint32_t> failures{0};
+
+    const auto checkResult = [&failures](const Expected<void>& result) {
+        if (result) return;
+
+        Logger::error(result.failure());
+        failures.fetch_add(1, std::memory_order_relaxed);
+    };
+
+    // Models
+    auto startTime = std::chrono::steady_clock::now();
+
+    assetManager.loadModelsAsync(threadPool, options.value().modelPaths);
+
+    std::vector<std::string>       texturePaths;
+    std::vector<std::future<void>> futures;
+
+    for (const auto& [path, handle] : assetManager.getModels()) {
+        Model* model = handle->resource.get();
+
+        texturePaths.insert(texturePaths.end(), model->texturePaths.begin(), model->texturePaths.end());
+
+        futures.push_back(threadPool.enqueue([&, model] {
+            for (Mesh& mesh : model->meshes) {
+                mesh.optimizeVertexFetch();
+            }
+
+            const Expected<AssetCache::SourceStamp> source = AssetCache::getSourceStamp(
+                AssetPaths::MODELS + model->path
+            );
+
+            if (!source) {
+                checkResult(Unexpected(source.failure()));
+                return;
+            }
+
+            checkResult(AssetCache::writeModel(
+                *model,
+                source.value(),
+                AssetCache::getCachePath(
+                    options.value().outputDirectory + AssetCache::MODELS_DIRECTORY,
+                    model->path,
+                    AssetCache::MODEL_EXTENSION
+                )
+            ));
+        }));
+    }
+
+    for (auto& future : futures) future.get();
+    futures.clear();
+
+    failures.fetch_add(countMissing(options.value().modelPaths, assetManager.getModels()), std::memory_order_relaxed);
+
+    Logger::info(
+        "Baked " + std::to_string(assetManager.getModels().size()) + " models in "
+        + std::to_string(elapsedMilliseconds(startTime)) + "ms"
+    );
+
+    // Textures
+    startTime = std::chrono::steady_clock::now();
+
+    std::ranges::sort(texturePaths);
+    texturePaths.erase(std::ranges::unique(texturePaths).begin(), texturePaths.end());
+
+    assetManager.loadTexturesAsync(threadPool, texturePaths);
+
+    for (const auto& [path, handle] : assetManager.getTextures()) {
+        const Image* image = handle->resource.get();
+
+        futures.push_back(threadPool.enqueue([&, image] {
+            const Expected<AssetCache::SourceStamp> source = AssetCache::getSourceStamp(
+                AssetPaths::TEXTURES + image->path
+            );
+
+            if (!source) {
+                checkResult(Unexpected(source.failure()));
+                return;
+            }
+
+            checkResult(AssetCache::writeTexture(
+                AssetCache::buildMipChain(*image),
+                source.value(),
+                AssetCache::getCachePath(
+                    options.value().outputDirectory + AssetCache::TEXTURES_DIRECTORY,
+                    image->path,
+                    AssetCache::TEXTURE_EXTENSION
+                )
+            ));
+        }));
+    }
+
+    for (auto& future : futures) future.get();
+
+    failures.fetch_add(countMissing(texturePaths, assetManager.getTextures()), std::memory_order_relaxed);
+
+    Logger::info(
+        "Baked " + std::to_string(assetManager.getTextures().size()) + " textures in "
+        + std::to_string(elapsedMilliseconds(startTime)) + "ms"
+    );
+
+    return failures.load() == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Bench {
+    using Arguments = std::span<const std::string_view>;
+
+    // Options shared by every benchmark, remaining arguments are benchmark specific inputs
+    struct Options {
+        std::uint32_t                 iterations = 5;
+        std::uint32_t                 count      = 0;
+        std::vector<std::string_view> inputs;
+    };
+
+    // Parses --iterations <n> and --count <n>, returns false on a malformed value
+    bool parseOptions(Arguments arguments, Options& options);
+
+    struct Timing {
+        double minimum = 0.0; // ms
+        double median  = 0.0; // ms
+    };
+
+    // Runs the function `iterations` times and keeps the min and median wall time
+    template<typename Function>
+    Timing measure(const std::uint32_t iterations, const Function& function) {
+        std::vector<double> samples;
+        samples.reserve(std::max<std::uint32_t>(iterations, 1));
+
+        for (std::uint32_t iteration = 0; iteration < std::max<std::uint32_t>(iterations, 1); iteration++) {
+            const auto start = std::chrono::steady_clock::now();
+            function();
+            samples.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+        }
+
+        std::ranges::sort(samples);
+
+        return {samples.front(), samples[samples.size() / 2]};
+    }
+
+    inline void printTiming(const std::string_view label, const Timing& timing) {
+        std::printf("  %-30.*s min %9.3f ms   median %9.3f ms\n",
+            static_cast<int>(label.size()), label.data(), timing.minimum, timing.median
+        );
+    }
+
+    inline void printSpeedup(const Timing& before, const Timing& after) {
+        std::printf("  %-30s %.2fx\n", "speedup (median)", before.median / std::max(after.median, 1e-9));
+    }
+
+    // Benchmarks, each returns a process exit code
+    int objParser(Arguments arguments);
+    int frustumCull(Arguments arguments);
+    int bvhCull(Arguments arguments);
+    int occlusionCull(Arguments arguments);
+    int spatialGrid(Arguments arguments);
+    int hiZ(Arguments arguments);
+}
@@ -0,0 +1,108 @@
+#include "Benchmark.h"
+#include "CullingScene.h"
+
+#include "core/render/BoundingVolumeHierarchy.h"
+
+#include <cstdlib>
+
+namespace {
+    // The hierarchy returns IDs in traversal order, the linear kernel in ascending order
+    bool sameVisibleSet(std::vector<std::uint32_t> hierarchyVisible, const std::vector<std::uint32_t>& linearVisible) {
+        std::ranges::sort(hierarchyVisible);
+        return hierarchyVisible == linearVisible;
+    }
+}
+
+int Bench::bvhCull(const Arguments arguments) {
+    Options options{};
+    options.iterations = 20;
+    options.count      = 1'000'000;
+
+    if (!parseOptions(arguments, options)) {
+        std::printf("bvh: malformed arguments\n");
+        return EXIT_FAILURE;
+    }
+
+    constexpr float WORLD_EXTENT = 1000.0f;
+    constexpr float VIEW_SIZE    = 150.0f;
+
+    std::vector<Math::Bounds> bounds = generateBounds(options.count, WORLD_EXTENT, 3);
+
+    FrustumCuller::Boxes boxes;
+    boxes.reserve(bounds.size());
+
+    for (const Math::Bounds& box : bounds) boxes.add(box);
+
+    BoundingVolumeHierarchy hierarchy;
+
+    const Timing build = measure(1, [&] { hierarchy.build(bounds); });
+
+    std::mt19937 random(4);
+
+    std::vector<std::array<Math::Plane, 6>> volumes;
+    for (std::uint32_t i = 0; i < std::max<std::uint32_t>(options.iterations, 1); i++) {
+        volumes.push_back(generateViewVolume(random, WORLD_EXTENT, VIEW_SIZE));
+    }
+
+    std::vector<std::uint32_t> hierarchyVisible;
+    std::vector<std::uint32_t> linearVisible;
+
+    std::size_t   visibleCount = 0;
+    std::uint32_t mismatches   = 0;
+
+    const auto compare = [&](const FrustumCuller::Boxes& linearBoxes, const std::array<Math::Plane, 6>& planes) {
+        hierarchyVisible.clear();
+        linearVisible.clear();
+
+        hierarchy.cull(planes, hierarchyVisible);
+        FrustumCuller::cull(linearBoxes, planes, linearVisible);
+
+        visibleCount += linearVisible.size();
+        if (!sameVisibleSet(hierarchyVisible, linearVisible)) mismatches++;
+    };
+
+    for (const auto& planes : volumes) compare(boxes, planes);
+
+    std::size_t volume = 0;
+
+    const Timing linear = measure(options.iterations, [&] {
+        linearVisible.clear();
+        FrustumCuller::cull(boxes, volumes[volume++ % volumes.size()], linearVisible);
+    });
+
+    volume = 0;
+
+    const Timing query = measure(options.iterations, [&] {
+        hierarchyVisible.clear();
+        hierarchy.cull(volumes[volume++ % volumes.size()], hierarchyVisible);
+    });
+
+    // Move every box and refit, the refitted hierarchy must still match the linear kernel
+    for (Math::Bounds& box : bounds) box.center = box.center + glm::vec3(5.0f, 0.0f, 0.0f);
+
+    const Timing refit = measure(1, [&] { hierarchy.refit(bounds); });
+
+    FrustumCuller::Boxes movedBoxes;
+    movedBoxes.reserve(bounds.size());
+
+    for (const Math::Bounds& box : bounds) movedBoxes.add(box);
+    for (const auto& planes : volumes) compare(movedBoxes, planes);
+
+    std::printf("%u boxes, %zu nodes, %.2f%% visible on average\n",
+        options.count, hierarchy.getNodes().size(),
+        100.0 * static_cast<double>(visibleCount) / (2.0 * static_cast<double>(options.count) * volumes.size())
+    );
+
+    printTiming("build", build);
+    printTiming("refit", refit);
+    printTiming("FrustumCuller::cull (linear)", linear);
+    printTiming("BoundingVolumeHierarchy::cull", query);
+    printSpeedup(linear, query);
+
+    if (mismatches > 0) {
+        std::printf("  MISMATCH in %u of %zu queries\n", mismatches, 2 * volumes.size());
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
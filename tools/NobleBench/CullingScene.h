@@ -0,0 +1,120 @@
+#pragma once
+
+#include "common/Math.h"
+
+#include "core/resources/models/Mesh.h"
+
+#include <array>
+#include <cmath>
+#include <random>
+#include <vector>
+
+// Synthetic culling scenes shared by the culling benchmarks, deterministic for a given seed
+namespace Bench {
+    // Boxes scattered over a flat world of [-worldExtent, worldExtent] on X/Y and a tenth of it on Z
+    inline std::vector<Math::Bounds> generateBounds(
+        const std::size_t   count,
+        const float         worldExtent,
+        const std::uint32_t seed
+    ) {
+        std::mt19937                          random(seed);
+        std::uniform_real_distribution<float> position(-worldExtent, worldExtent);
+        std::uniform_real_distribution<float> extent(0.1f, 3.0f);
+
+        std::vector<Math::Bounds> bounds(count);
+
+        for (Math::Bounds& box : bounds) {
+            box.center = glm::vec3(position(random), position(random), position(random) * 0.1f);
+            box.extent = glm::vec3(extent(random), extent(random), extent(random));
+        }
+
+        return bounds;
+    }
+
+    // Six slightly tilted planes facing inward around a random center, a box-like view volume of `halfSize`
+    inline std::array<Math::Plane, 6> generateViewVolume(
+        std::mt19937& random,
+        const float   worldExtent,
+        const float   halfSize
+    ) {
+        std::uniform_real_distribution<float> position(-worldExtent * 0.8f, worldExtent * 0.8f);
+        std::uniform_real_distribution<float> tilt(-0.3f, 0.3f);
+
+        const glm::vec3 center(position(random), position(random), 0.0f);
+
+        constexpr std::array<std::array<float, 3>, 6> AXES{{
+            {1.0f, 0.0f, 0.0f}, {-1.0f, 0.0f, 0.0f},
+            {0.0f, 1.0f, 0.0f}, {0.0f, -1.0f, 0.0f},
+            {0.0f, 0.0f, 1.0f}, {0.0f, 0.0f, -1.0f}
+        }};
+
+        std::array<Math::Plane, 6> planes{};
+
+        for (std::size_t i = 0; i < planes.size(); i++) {
+            glm::vec3 normal(AXES[i][0] + tilt(random), AXES[i][1] + tilt(random), AXES[i][2] + tilt(random));
+            normal = normal * (1.0f / glm::length(normal));
+
+            planes[i].normal = normal;
+            planes[i].d      = halfSize - glm::dot(normal, center);
+        }
+
+        return planes;
+    }
+
+    // Reversed infinite perspective built like Camera::getProjectionMatrix, camera at the origin looking down -Z
+    inline glm::mat4 getProjectionMatrix(const float fieldOfView, const float aspectRatio, const float nearPlane) {
+        const float focal = 1.0f / std::tan(fieldOfView * 0.5f);
+
+        glm::mat4 projection(0.0f);
+        projection[0][0] = focal / aspectRatio;
+        projection[1][1] = focal;
+        projection[2][3] = -1.0f;
+        projection[3][2] = nearPlane;
+
+        return projection;
+    }
+
+    // Camera facing quad of half size `halfSize` centered on (x, y, z)
+    inline Mesh makeQuad(const float x, const float y, const float z, const float halfSize) {
+        Mesh quad{};
+
+        quad.addVertex(Vertex{{x - halfSize, y - halfSize, z}});
+        quad.addVertex(Vertex{{x + halfSize, y - halfSize, z}});
+        quad.addVertex(Vertex{{x + halfSize, y + halfSize, z}});
+        quad.addVertex(Vertex{{x - halfSize, y + halfSize, z}});
+
+        for (const std::uint32_t index : {0u, 1u, 2u, 0u, 2u, 3u}) quad.addIndex(index);
+
+        return quad;
+    }
+
+    // An 8x4 grid of camera facing walls 20 to 30 units down -Z, the occluders of the occlusion benchmarks
+    inline std::vector<Mesh> generateWalls() {
+        constexpr std::uint32_t WALLS_X = 8;
+        constexpr std::uint32_t WALLS_Y = 4;
+
+        std::vector<Mesh> walls;
+        walls.reserve(WALLS_X * WALLS_Y);
+
+        for (std::uint32_t y = 0; y < WALLS_Y; y++) {
+            for (std::uint32_t x = 0; x < WALLS_X; x++) {
+                walls.push_back(makeQuad(
+                    (static_cast<float>(x) - (WALLS_X - 1) * 0.5f) * 6.0f,
+                    (static_cast<float>(y) - (WALLS_Y - 1) * 0.5f) * 6.0f,
+                    -20.0f - static_cast<float>((x + y) % 3) * 5.0f,
+                    2.5f
+                ));
+            }
+        }
+
+        return walls;
+    }
+
+    inline Math::AABB toAABB(const Math::Bounds& bounds) {
+        Math::AABB aabb{};
+        aabb.minBound = bounds.center - bounds.extent;
+        aabb.maxBound = bounds.center + bounds.extent;
+
+        return aabb;
+    }
+}
@@ -0,0 +1,92 @@
+#include "Benchmark.h"
+#include "CullingScene.h"
+
+#include "core/render/FrustumCuller.h"
+
+#include <cstdlib>
+
+int Bench::frustumCull(const Arguments arguments) {
+    Options options{};
+    options.iterations = 20;
+    options.count      = 100'000;
+
+    if (!parseOptions(arguments, options)) {
+        std::printf("frustum: malformed arguments\n");
+        return EXIT_FAILURE;
+    }
+
+    constexpr float WORLD_EXTENT = 1000.0f;
+    constexpr float VIEW_SIZE    = 150.0f;
+
+    const std::vector<Math::Bounds> bounds = generateBounds(options.count, WORLD_EXTENT, 1);
+
+    std::vector<Math::AABB> aabbs;
+    FrustumCuller::Boxes    boxes;
+
+    aabbs.reserve(bounds.size());
+    boxes.reserve(bounds.size());
+
+    for (const Math::Bounds& box : bounds) {
+        aabbs.push_back(toAABB(box));
+        boxes.add(box);
+    }
+
+    std::mt19937 random(2);
+
+    std::vector<std::array<Math::Plane, 6>> volumes;
+    for (std::uint32_t i = 0; i < std::max<std::uint32_t>(options.iterations, 1); i++) {
+        volumes.push_back(generateViewVolume(random, WORLD_EXTENT, VIEW_SIZE));
+    }
+
+    std::vector<std::uint32_t> scalarVisible;
+    std::vector<std::uint32_t> simdVisible;
+
+    const auto cullScalar = [&](const std::array<Math::Plane, 6>& planes) {
+        scalarVisible.clear();
+
+        for (std::uint32_t i = 0; i < aabbs.size(); i++) {
+            if (FrustumCuller::testVisibility(aabbs[i], planes)) scalarVisible.push_back(i);
+        }
+    };
+
+    // Both kernels must keep the same boxes, in the same ascending order
+    std::size_t   visibleCount = 0;
+    std::uint32_t mismatches   = 0;
+
+    for (const auto& planes : volumes) {
+        cullScalar(planes);
+
+        simdVisible.clear();
+        FrustumCuller::cull(boxes, planes, simdVisible);
+
+        visibleCount += scalarVisible.size();
+        if (scalarVisible != simdVisible) mismatches++;
+    }
+
+    // One view volume per iteration
+    std::size_t volume = 0;
+
+    const Timing before = measure(options.iterations, [&] { cullScalar(volumes[volume++ % volumes.size()]); });
+
+    volume = 0;
+
+    const Timing after = measure(options.iterations, [&] {
+        simdVisible.clear();
+        FrustumCuller::cull(boxes, volumes[volume++ % volumes.size()], simdVisible);
+    });
+
+    std::printf("%u boxes, %.2f%% visible on average\n",
+        options.count, 100.0 * static_cast<double>(visibleCount) / (static_cast<double>(options.count) * volumes.size())
+    );
+
+    printTiming("testVisibility (scalar AABB)", before);
+    printTiming("FrustumCuller::cull (SoA)", after);
+    printSpeedup(before, after);
+
+    if (mismatches > 0) {
+        std::printf("  MISMATCH in %u of %zu view volumes\n", mismatches, volumes.size());
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,281 @@
+#include "Benchmark.h"
+#include "CullingScene.h"
+
+#include "core/render/OcclusionCuller.h"
+
+#include <bit>
+#include <cmath>
+#include <cstdlib>
+#include <random>
+
+// CPU reference of the GPU occlusion culling, run without a Vulkan device
+// depth_pyramid.slang and isOccluded of draw_cull_late.slang are ported line by line and run on the OcclusionCuller
+// depth buffer, a box they report occluded must be occluded at every pixel of its screen rectangle
+
+namespace {
+    // VulkanDepthPyramid::MAX_LEVELS
+    constexpr std::uint32_t MAX_LEVELS = 16;
+
+    struct DepthLevel {
+        std::uint32_t      width  = 0;
+        std::uint32_t      height = 0;
+        std::vector<float> depth{};
+
+        [[nodiscard]] float load(const std::uint32_t x, const std::uint32_t y) const {
+            return depth[static_cast<std::size_t>(y) * width + x];
+        }
+    };
+
+    // depth_pyramid.slang: farthest depth (reversed-Z minimum) of the source footprint, bounds rounded outwards
+    DepthLevel reduce(const DepthLevel& source, const std::uint32_t width, const std::uint32_t height) {
+        DepthLevel target{width, height, std::vector<float>(static_cast<std::size_t>(width) * height)};
+
+        for (std::uint32_t y = 0; y < height; y++) {
+            for (std::uint32_t x = 0; x < width; x++) {
+                const std::uint32_t beginX = x * source.width / width;
+                const std::uint32_t beginY = y * source.height / height;
+                const std::uint32_t endX   = std::min(((x + 1) * source.width + width - 1) / width, source.width);
+                const std::uint32_t endY   = std::min(((y + 1) * source.height + height - 1) / height, source.height);
+
+                float depth = 1.0f;
+
+                for (std::uint32_t sy = beginY; sy < endY; sy++) {
+                    for (std::uint32_t sx = beginX; sx < endX; sx++) {
+                        depth = std::min(depth, source.load(sx, sy));
+                    }
+                }
+
+                target.depth[static_cast<std::size_t>(y) * width + x] = depth;
+            }
+        }
+
+        return target;
+    }
+
+    // Extents of VulkanDepthPyramid::resize, the first level is the largest power of two extent fitting the buffer
+    void buildPyramid(const DepthLevel& depthBuffer, std::vector<DepthLevel>& pyramid) {
+        const std::uint32_t width      = std::bit_floor(depthBuffer.width);
+        const std::uint32_t height     = std::bit_floor(depthBuffer.height);
+        const std::uint32_t levelCount = std::min<std::uint32_t>(std::bit_width(std::max(width, height)), MAX_LEVELS);
+
+        pyramid.clear();
+        pyramid.push_back(reduce(depthBuffer, width, height));
+
+        for (std::uint32_t level = 1; level < levelCount; level++) {
+            pyramid.push_back(reduce(pyramid.back(), std::max(width >> level, 1u), std::max(height >> level, 1u)));
+        }
+    }
+
+    struct ScreenRect {
+        glm::vec2 minUV{1.0f};
+        glm::vec2 maxUV{0.0f};
+        float     nearestDepth = 0.0f;
+    };
+
+    // Corner projection of isOccluded, false for boxes crossing the near plane (never occluded)
+    bool projectBox(
+        const Math::Bounds& bounds, const glm::mat4& viewProjection, const float nearPlane, ScreenRect& rect
+    ) {
+        rect = {};
+
+        for (std::uint32_t i = 0; i < 8; i++) {
+            const glm::vec3 corner = bounds.center + bounds.extent * glm::vec3(
+                (i & 1) != 0 ? 1.0f : -1.0f,
+                (i & 2) != 0 ? 1.0f : -1.0f,
+                (i & 4) != 0 ? 1.0f : -1.0f
+            );
+
+            const glm::vec4 clipPosition = viewProjection * glm::vec4(corner, 1.0f);
+
+            if (clipPosition.w < nearPlane) return false;
+
+            const glm::vec3 ndc = glm::vec3(clipPosition) * (1.0f / clipPosition.w);
+            const glm::vec2 uv  = glm::vec2(ndc.x, ndc.y) * 0.5f + glm::vec2(0.5f);
+
+            rect.minUV        = glm::min(rect.minUV, uv);
+            rect.maxUV        = glm::max(rect.maxUV, uv);
+            rect.nearestDepth = std::max(rect.nearestDepth, ndc.z);
+        }
+
+        return true;
+    }
+
+    glm::vec2 saturate(const glm::vec2 value) {
+        return {std::clamp(value.x, 0.0f, 1.0f), std::clamp(value.y, 0.0f, 1.0f)};
+    }
+
+    // isOccluded: nearest depth of the box against the farthest depth of the pyramid texels it covers
+    bool isOccludedHiZ(const std::vector<DepthLevel>& pyramid, const ScreenRect& rect) {
+        const glm::vec2 size(static_cast<float>(pyramid[0].width), static_cast<float>(pyramid[0].height));
+
+        const glm::vec2 minTexel = saturate(rect.minUV) * size;
+        const glm::vec2 maxTexel = saturate(rect.maxUV) * size;
+
+        const glm::vec2 texelExtent = maxTexel - minTexel;
+
+        auto level = static_cast<std::uint32_t>(std::ceil(std::log2(std::max({texelExtent.x, texelExtent.y, 1.0f}))));
+        level      = std::min(level, static_cast<std::uint32_t>(pyramid.size()) - 1);
+
+        const DepthLevel& depthLevel = pyramid[level];
+
+        const std::uint32_t beginX = std::min(static_cast<std::uint32_t>(minTexel.x) >> level, depthLevel.width  - 1);
+        const std::uint32_t beginY = std::min(static_cast<std::uint32_t>(minTexel.y) >> level, depthLevel.height - 1);
+        const std::uint32_t endX   = std::min(static_cast<std::uint32_t>(maxTexel.x) >> level, depthLevel.width  - 1);
+        const std::uint32_t endY   = std::min(static_cast<std::uint32_t>(maxTexel.y) >> level, depthLevel.height - 1);
+
+        float farthestDepth = 1.0f;
+
+        for (std::uint32_t y = beginY; y <= endY; y++) {
+            for (std::uint32_t x = beginX; x <= endX; x++) {
+                farthestDepth = std::min(farthestDepth, depthLevel.load(x, y));
+            }
+        }
+
+        return rect.nearestDepth < farthestDepth;
+    }
+
+    // Exact at the depth buffer resolution: every pixel of the rectangle holds a nearer occluder than the box
+    bool isOccludedReference(const DepthLevel& depthBuffer, const ScreenRect& rect) {
+        const glm::vec2 size(static_cast<float>(depthBuffer.width), static_cast<float>(depthBuffer.height));
+
+        const glm::vec2 minPixel = saturate(rect.minUV) * size;
+        const glm::vec2 maxPixel = saturate(rect.maxUV) * size;
+
+        const std::uint32_t endX = std::min(static_cast<std::uint32_t>(maxPixel.x), depthBuffer.width  - 1);
+        const std::uint32_t endY = std::min(static_cast<std::uint32_t>(maxPixel.y), depthBuffer.height - 1);
+
+        for (auto y = std::min(static_cast<std::uint32_t>(minPixel.y), endY); y <= endY; y++) {
+            for (auto x = std::min(static_cast<std::uint32_t>(minPixel.x), endX); x <= endX; x++) {
+                if (rect.nearestDepth >= depthBuffer.load(x, y)) return false;
+            }
+        }
+
+        return true;
+    }
+}
+
+int Bench::hiZ(const Arguments arguments) {
+    Options options{};
+    options.iterations = 8;
+    options.count      = 100'000;
+
+    if (!parseOptions(arguments, options)) {
+        std::printf("hiz: malformed arguments\n");
+        return EXIT_FAILURE;
+    }
+
+    constexpr float NEAR_PLANE = 0.1f;
+
+    const glm::mat4 projection = getProjectionMatrix(1.0f, 1.6f, NEAR_PLANE);
+    const glm::mat4 identity(1.0f);
+
+    const std::vector<Mesh> walls = generateWalls();
+
+    std::vector<OcclusionCuller::Occluder> occluders;
+    for (const Mesh& wall : walls) occluders.push_back({&wall, &identity});
+
+    // Boxes behind, between and in front of the walls
+    std::mt19937                          random(11);
+    std::uniform_real_distribution<float> lateral(-40.0f, 40.0f);
+    std::uniform_real_distribution<float> depth(-200.0f, -10.0f);
+    std::uniform_real_distribution<float> extent(0.2f, 2.0f);
+
+    std::vector<Math::Bounds> bounds(options.count);
+
+    for (Math::Bounds& box : bounds) {
+        box.center = glm::vec3(lateral(random), lateral(random) * 0.5f, depth(random));
+        box.extent = glm::vec3(extent(random), extent(random), extent(random));
+    }
+
+    // One view per iteration, the camera slides in front of the walls
+    std::uniform_real_distribution<float> eyeLateral(-8.0f, 8.0f);
+    std::uniform_real_distribution<float> eyeDepth(0.0f, 8.0f);
+
+    const std::uint32_t viewCount = std::max<std::uint32_t>(options.iterations, 1);
+
+    OcclusionCuller         culler;
+    DepthLevel              depthBuffer{OcclusionCuller::WIDTH, OcclusionCuller::HEIGHT};
+    std::vector<DepthLevel> pyramid;
+    glm::mat4               viewProjection(1.0f);
+
+    std::size_t testedCount       = 0;
+    std::size_t referenceOccluded = 0;
+    std::size_t hiZOccluded       = 0;
+    std::size_t cpuOccluded       = 0;
+    std::size_t hiZMismatches     = 0;
+    std::size_t cpuMismatches     = 0;
+
+    for (std::uint32_t view = 0; view < viewCount; view++) {
+        glm::mat4 viewMatrix(1.0f);
+        viewMatrix[3] = glm::vec4(-eyeLateral(random), -eyeLateral(random) * 0.5f, -eyeDepth(random), 1.0f);
+
+        viewProjection = projection * viewMatrix;
+
+        culler.render(viewProjection, occluders);
+        depthBuffer.depth = culler.getDepthBuffer();
+
+        buildPyramid(depthBuffer, pyramid);
+
+        for (const Math::Bounds& box : bounds) {
+            ScreenRect rect{};
+
+            const bool projected         = projectBox(box, viewProjection, NEAR_PLANE, rect);
+            const bool occludedHiZ       = projected && isOccludedHiZ(pyramid, rect);
+            const bool occludedReference = projected && isOccludedReference(depthBuffer, rect);
+            const bool occludedCpu       = !culler.testVisibility(box);
+
+            // Popping: a box with a visible pixel must never be culled
+            if (occludedHiZ && !occludedReference) hiZMismatches++;
+            if (projected && occludedCpu && !occludedReference) cpuMismatches++;
+
+            referenceOccluded += occludedReference;
+            hiZOccluded       += occludedHiZ;
+            cpuOccluded       += occludedCpu;
+            testedCount++;
+        }
+    }
+
+    // CPU cost of the port on the last view, the GPU runs it per texel and per draw
+    const Timing build = measure(options.iterations, [&] { buildPyramid(depthBuffer, pyramid); });
+
+    std::size_t testOccluded = 0;
+
+    const Timing test = measure(options.iterations, [&] {
+        testOccluded = 0;
+
+        for (const Math::Bounds& box : bounds) {
+            ScreenRect rect{};
+            if (projectBox(box, viewProjection, NEAR_PLANE, rect)) testOccluded += isOccludedHiZ(pyramid, rect);
+        }
+    });
+
+    const auto percent = [&](const std::size_t count) {
+        return 100.0 * static_cast<double>(count) / std::max<double>(static_cast<double>(testedCount), 1.0);
+    };
+
+    std::printf("%zu occluders, %u boxes, %u views, %ux%u depth buffer, %zu pyramid levels\n",
+        occluders.size(), options.count, viewCount,
+        OcclusionCuller::WIDTH, OcclusionCuller::HEIGHT, pyramid.size()
+    );
+
+    std::printf("  %-30s %.2f%%\n", "occluded (per pixel reference)", percent(referenceOccluded));
+    std::printf("  %-30s %.2f%%\n", "occluded (Hi-Z, GPU port)", percent(hiZOccluded));
+    std::printf("  %-30s %.2f%%\n", "occluded (OcclusionCuller)", percent(cpuOccluded));
+
+    printTiming("build depth pyramid", build);
+    printTiming("Hi-Z test (all boxes)", test);
+
+    bool passed = true;
+
+    if (hiZMismatches > 0) {
+        std::printf("  MISMATCH: Hi-Z occluded %zu boxes with a visible pixel\n", hiZMismatches);
+        passed = false;
+    }
+
+    if (cpuMismatches > 0) {
+        std::printf("  MISMATCH: OcclusionCuller occluded %zu boxes with a visible pixel\n", cpuMismatches);
+        passed = false;
+    }
+
+    return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,97 @@
+#include "Benchmark.h"
+
+#include "core/resources/AssetPaths.h"
+#include "core/resources/models/ObjParser.h"
+
+#include <array>
+#include <cstdlib>
+
+namespace {
+    constexpr std::array<std::string_view, 3> REFERENCE_MODELS{
+        "teapot.obj", "stanford_bunny.obj", "stanford_dragon.obj"
+    };
+
+    struct ObjData {
+        tinyobj::attrib_t                attributes;
+        std::vector<tinyobj::shape_t>    shapes;
+        std::vector<tinyobj::material_t> materials;
+    };
+
+    std::size_t countCorners(const ObjData& data) {
+        std::size_t corners = 0;
+        for (const auto& shape : data.shapes) corners += shape.mesh.indices.size();
+
+        return corners;
+    }
+
+    // Same outputs the loader consumes: attribute streams, corners and materials
+    bool matches(const ObjData& reference, const ObjData& native) {
+        return reference.attributes.vertices  == native.attributes.vertices
+            && reference.attributes.normals   == native.attributes.normals
+            && reference.attributes.texcoords == native.attributes.texcoords
+            && countCorners(reference)        == countCorners(native)
+            && reference.materials.size()     == native.materials.size();
+    }
+}
+
+int Bench::objParser(const Arguments arguments) {
+    Options options{};
+
+    if (!parseOptions(arguments, options)) {
+        std::printf("obj: malformed arguments\n");
+        return EXIT_FAILURE;
+    }
+
+    if (options.inputs.empty()) options.inputs.assign(REFERENCE_MODELS.begin(), REFERENCE_MODELS.end());
+
+    bool failed = false;
+
+    for (const std::string_view input : options.inputs) {
+        const std::string path = AssetPaths::MODELS + std::string(input);
+
+        ObjData reference{};
+        ObjData native{};
+
+        std::string errorMessage;
+        bool        referenceLoaded = true;
+        bool        nativeLoaded    = true;
+
+        // Fresh outputs per iteration, both parsers append
+        const Timing before = measure(options.iterations, [&] {
+            reference       = {};
+            referenceLoaded = tinyobj::LoadObj(
+                &reference.attributes, &reference.shapes, &reference.materials, &errorMessage,
+                path.c_str(), AssetPaths::MODELS
+            );
+        });
+
+        const Timing after = measure(options.iterations, [&] {
+            native       = {};
+            nativeLoaded = static_cast<bool>(ObjParser::load(
+                path, AssetPaths::MODELS, native.attributes, native.shapes, native.materials
+            ));
+        });
+
+        std::printf("%.*s (%zu vertices, %zu corners)\n",
+            static_cast<int>(input.size()), input.data(),
+            reference.attributes.vertices.size() / 3, countCorners(reference)
+        );
+
+        if (!referenceLoaded || !nativeLoaded) {
+            std::printf("  failed to load: %s\n", errorMessage.c_str());
+            failed = true;
+            continue;
+        }
+
+        printTiming("tinyobj::LoadObj", before);
+        printTiming("ObjParser::load", after);
+        printSpeedup(before, after);
+
+        if (!matches(reference, native)) {
+            std::printf("  MISMATCH between tinyobjloader and ObjParser outputs\n");
+            failed = true;
+        }
+    }
+
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,112 @@
+#include "Benchmark.h"
+#include "CullingScene.h"
+
+#include "core/render/OcclusionCuller.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <random>
+
+namespace {
+    struct Case {
+        const char*  name;
+        Math::Bounds bounds;
+        bool         visible;
+    };
+
+    // A 10x10 wall at z = -10, boxes around it must keep the conservative answers
+    bool checkWall() {
+        const glm::mat4 projection = Bench::getProjectionMatrix(1.0f, 1.6f, 0.1f);
+        const glm::mat4 identity(1.0f);
+
+        const Mesh                      wall = Bench::makeQuad(0.0f, 0.0f, -10.0f, 5.0f);
+        const OcclusionCuller::Occluder occluder{&wall, &identity};
+
+        OcclusionCuller culler;
+        culler.render(projection, {&occluder, 1});
+
+        const Case cases[] = {
+            {"behind",                {{  0.0f, 0.0f, -20.0f}, { 1.0f, 1.0f, 1.0f}}, false},
+            {"in front",              {{  0.0f, 0.0f,  -5.0f}, { 1.0f, 1.0f, 1.0f}}, true },
+            {"behind, wider",         {{  0.0f, 0.0f, -20.0f}, {30.0f, 1.0f, 1.0f}}, true },
+            {"beside",                {{ 20.0f, 0.0f, -20.0f}, { 1.0f, 1.0f, 1.0f}}, true },
+            {"straddling the wall",   {{  0.0f, 0.0f, -10.0f}, { 1.0f, 1.0f, 1.0f}}, true },
+            {"crossing near plane",   {{  0.0f, 0.0f,   0.0f}, { 1.0f, 1.0f, 1.0f}}, true },
+        };
+
+        bool passed = true;
+
+        for (const auto& [name, bounds, visible] : cases) {
+            if (culler.testVisibility(bounds) == visible) continue;
+
+            std::printf("  MISMATCH: box %s should be %s\n", name, visible ? "visible" : "occluded");
+            passed = false;
+        }
+
+        return passed;
+    }
+}
+
+int Bench::occlusionCull(const Arguments arguments) {
+    Options options{};
+    options.iterations = 20;
+    options.count      = 100'000;
+
+    if (!parseOptions(arguments, options)) {
+        std::printf("occlusion: malformed arguments\n");
+        return EXIT_FAILURE;
+    }
+
+    const bool passed = checkWall();
+
+    // Walls close to the camera, boxes scattered behind them
+    const std::vector<Mesh> walls = generateWalls();
+
+    const glm::mat4 projection = getProjectionMatrix(1.0f, 1.6f, 0.1f);
+    const glm::mat4 identity(1.0f);
+
+    std::vector<OcclusionCuller::Occluder> occluders;
+    for (const Mesh& wall : walls) occluders.push_back({&wall, &identity});
+
+    std::mt19937                          random(5);
+    std::uniform_real_distribution<float> lateral(-40.0f, 40.0f);
+    std::uniform_real_distribution<float> depth(-200.0f, -40.0f);
+    std::uniform_real_distribution<float> extent(0.2f, 2.0f);
+
+    std::vector<Math::Bounds> bounds(options.count);
+
+    for (Math::Bounds& box : bounds) {
+        box.center = glm::vec3(lateral(random), lateral(random) * 0.5f, depth(random));
+        box.extent = glm::vec3(extent(random), extent(random), extent(random));
+    }
+
+    OcclusionCuller culler;
+
+    const Timing render = measure(options.iterations, [&] { culler.render(projection, occluders); });
+
+    std::size_t visibleCount = 0;
+
+    const Timing test = measure(options.iterations, [&] {
+        visibleCount = 0;
+
+        for (const Math::Bounds& box : bounds) {
+            visibleCount += culler.testVisibility(box) ? 1 : 0;
+        }
+    });
+
+    std::printf("%zu occluders, %u boxes, %.2f%% occluded\n",
+        occluders.size(), options.count,
+        100.0 * (1.0 - static_cast<double>(visibleCount) / std::max<double>(options.count, 1.0))
+    );
+
+    // Compare across builds: the SSE and scalar rasterizers must produce the same depth buffer
+    double depthSum = 0.0;
+    for (const float value : culler.getDepthBuffer()) depthSum += value;
+
+    std::printf("  %-30s %.6f\n", "depth buffer checksum", depthSum);
+
+    printTiming("OcclusionCuller::render", render);
+    printTiming("testVisibility (all boxes)", test);
+
+    return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,127 @@
+#include "Benchmark.h"
+#include "CullingScene.h"
+
+#include "core/render/FrustumCuller.h"
+#include "core/render/SpatialHashGrid.h"
+
+#include <cstdlib>
+
+namespace {
+    // The grid returns IDs in cell order, the linear kernel in ascending order
+    bool sameVisibleSet(std::vector<std::uint32_t> gridVisible, const std::vector<std::uint32_t>& linearVisible) {
+        std::ranges::sort(gridVisible);
+        return gridVisible == linearVisible;
+    }
+}
+
+int Bench::spatialGrid(const Arguments arguments) {
+    Options options{};
+    options.iterations = 20;
+    options.count      = 100'000;
+
+    if (!parseOptions(arguments, options)) {
+        std::printf("grid: malformed arguments\n");
+        return EXIT_FAILURE;
+    }
+
+    constexpr float WORLD_EXTENT = 1000.0f;
+    constexpr float VIEW_SIZE    = 150.0f;
+
+    // One object in MOVING_STRIDE moves every frame, like the dynamic objects of a scene
+    constexpr std::uint32_t MOVING_STRIDE = 10;
+
+    std::vector<Math::Bounds> bounds = generateBounds(options.count, WORLD_EXTENT, 6);
+
+    FrustumCuller::Boxes boxes;
+    boxes.reserve(bounds.size());
+
+    const auto fillBoxes = [&] {
+        boxes.clear();
+        for (const Math::Bounds& box : bounds) boxes.add(box);
+    };
+
+    fillBoxes();
+
+    SpatialHashGrid grid;
+
+    const Timing build = measure(1, [&] {
+        grid.clear();
+        for (std::uint32_t i = 0; i < bounds.size(); i++) grid.insert(i, bounds[i]);
+    });
+
+    std::mt19937 random(7);
+
+    std::vector<std::array<Math::Plane, 6>> volumes;
+    for (std::uint32_t i = 0; i < std::max<std::uint32_t>(options.iterations, 1); i++) {
+        volumes.push_back(generateViewVolume(random, WORLD_EXTENT, VIEW_SIZE));
+    }
+
+    std::vector<std::uint32_t> gridVisible;
+    std::vector<std::uint32_t> linearVisible;
+
+    std::size_t   visibleCount = 0;
+    std::uint32_t mismatches   = 0;
+
+    const auto compare = [&] {
+        for (const auto& planes : volumes) {
+            gridVisible.clear();
+            linearVisible.clear();
+
+            grid.queryFrustum(planes, gridVisible);
+            FrustumCuller::cull(boxes, planes, linearVisible);
+
+            visibleCount += linearVisible.size();
+            if (!sameVisibleSet(gridVisible, linearVisible)) mismatches++;
+        }
+    };
+
+    compare();
+
+    std::size_t volume = 0;
+
+    const Timing linear = measure(options.iterations, [&] {
+        linearVisible.clear();
+        FrustumCuller::cull(boxes, volumes[volume++ % volumes.size()], linearVisible);
+    });
+
+    volume = 0;
+
+    const Timing query = measure(options.iterations, [&] {
+        gridVisible.clear();
+        grid.queryFrustum(volumes[volume++ % volumes.size()], gridVisible);
+    });
+
+    // Moving objects drift by up to a cell per frame, some of them change cell
+    std::uniform_real_distribution<float> step(-8.0f, 8.0f);
+
+    const Timing update = measure(options.iterations, [&] {
+        for (std::uint32_t i = 0; i < bounds.size(); i += MOVING_STRIDE) {
+            bounds[i].center = bounds[i].center + glm::vec3(step(random), step(random), 0.0f);
+            grid.update(i, bounds[i]);
+        }
+    });
+
+    // The linear kernel has no incremental update, its boxes are refilled
+    const Timing refill = measure(options.iterations, fillBoxes);
+
+    compare();
+
+    std::printf("%u objects, %zu cells, %u moving, %.2f%% visible on average\n",
+        options.count, grid.getCellCount(), (options.count + MOVING_STRIDE - 1) / MOVING_STRIDE,
+        100.0 * static_cast<double>(visibleCount) / (2.0 * static_cast<double>(options.count) * volumes.size())
+    );
+
+    printTiming("build", build);
+    printTiming("update (moving objects)", update);
+    printTiming("refill linear boxes", refill);
+    printTiming("FrustumCuller::cull (linear)", linear);
+    printTiming("SpatialHashGrid::queryFrustum", query);
+    printSpeedup(linear, query);
+
+    if (mismatches > 0) {
+        std::printf("  MISMATCH in %u of %zu queries\n", mismatches, 2 * volumes.size());
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,88 @@
+// NobleBench - headless micro benchmarks for engine subsystems
+// Each benchmark times the engine code path against the implementation it replaced and checks both agree
+//
+// Usage: NobleBench <benchmark> [--iterations <n>] [--count <n>] [input...]
+
+#include "Benchmark.h"
+
+#include "core/debug/Logger.h"
+#include "core/multithreading/ThreadRegistry.h"
+
+#include <array>
+#include <charconv>
+#include <cstdlib>
+
+namespace {
+    struct Entry {
+        std::string_view name;
+        std::string_view usage;
+        int (*run)(Bench::Arguments);
+    };
+
+    constexpr std::array BENCHMARKS{
+        Entry{"obj",     "[--iterations <n>] [model.obj...]  ObjParser against tinyobjloader", Bench::objParser},
+        Entry{"frustum", "[--iterations <n>] [--count <n>]   SoA SIMD frustum kernel against testVisibility",
+            Bench::frustumCull},
+        Entry{"bvh",     "[--iterations <n>] [--count <n>]   BVH frustum queries against the linear kernel",
+            Bench::bvhCull},
+        Entry{"occlusion", "[--iterations <n>] [--count <n>] software occlusion checks and costs",
+            Bench::occlusionCull},
+        Entry{"grid",    "[--iterations <n>] [--count <n>]   hashed grid queries and updates against linear culling",
+            Bench::spatialGrid},
+        Entry{"hiz",     "[--iterations <n>] [--count <n>]   GPU depth pyramid culling port against a per pixel test",
+            Bench::hiZ},
+    };
+
+    void printUsage() {
+        std::printf("Usage: NobleBench <benchmark> [arguments...]\n");
+
+        for (const auto& [name, usage, run] : BENCHMARKS) {
+            std::printf("  %-10.*s %.*s\n",
+                static_cast<int>(name.size()), name.data(), static_cast<int>(usage.size()), usage.data()
+            );
+        }
+    }
+
+    bool parseNumber(const std::string_view text, std::uint32_t& value) {
+        const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+        return error == std::errc{} && end == text.data() + text.size();
+    }
+}
+
+bool Bench::parseOptions(const Arguments arguments, Options& options) {
+    for (std::size_t i = 0; i < arguments.size(); i++) {
+        const std::string_view argument = arguments[i];
+
+        if (argument == "--iterations" || argument == "--count") {
+            if (i + 1 >= arguments.size()) return false;
+
+            std::uint32_t& value = argument == "--iterations" ? options.iterations : options.count;
+            if (!parseNumber(arguments[++i], value)) return false;
+        } else {
+            options.inputs.push_back(argument);
+        }
+    }
+
+    return true;
+}
+
+int main(const int argc, char** argv) {
+    ThreadScope mainScope("MainThread");
+
+    Logger::Manager loggerManager;
+
+    if (argc < 2) {
+        printUsage();
+        return EXIT_FAILURE;
+    }
+
+    const std::string_view              name = argv[1];
+    const std::vector<std::string_view> arguments(argv + 2, argv + argc);
+
+    for (const Entry& entry : BENCHMARKS) {
+        if (entry.name == name) return entry.run(arguments);
+    }
+
+    printUsage();
+    return EXIT_FAILURE;
+}